@@ -51,7 +51,7 @@ public:
      * @param aTabDepth [in]    indentation depth of the text block
      * @return 0 for success, -1 for failure
      */
-    int WriteMaterial( std::ofstream& aVRMLFile, int aTabDepth = 0 );
+    int WriteMaterial( std::ostream& aVRMLFile, int aTabDepth = 0 );
 };
 
 }    // namespace KC3D
@@ -131,6 +131,9 @@ public:
                VRMLMAT& aStemMat, bool reuseStemMat, std::ofstream& aVRMLFile,
                int aTabDepth = 0 );
 
+    /// Copy the funnel aFunnel plus an offset; see POLYGON::Translate()
+    int Translate( const FUNNEL& aFunnel, double dX, double dY, double dZ );
+
     /**
      * Set the cross-section shape of the funnel
      *
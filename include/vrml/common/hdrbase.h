@@ -25,7 +25,10 @@
 #ifndef HDRBASE_H
 #define HDRBASE_H
 
+#include <vector>
+
 #include <polygon.h>
+#include <hole.h>
 
 namespace KC3D
 {
@@ -77,11 +80,11 @@ private:
     // overridden and hidden class methods
     // the overridden Paint prints an error message and returns
     int Paint( bool ccw, KC3D::TRANSFORM& t, KC3D::VRMLMAT& color, bool reuse_color,
-            std::ofstream& fp, int tabs = 0 );
+            std::ostream& fp, int tabs = 0 );
 
     // the overridden Stitch prints an error message and returns
     int Stitch( bool ccw, POLYGON& p2, KC3D::TRANSFORM& t,
-            KC3D::VRMLMAT& color, bool reuse_color, std::ofstream& fp, int tabs = 0 );
+            KC3D::VRMLMAT& color, bool reuse_color, std::ostream& fp, int tabs = 0 );
 
     // the overridden Calc prints an error message and returns
     int Calc( double, double, KC3D::TRANSFORM& );
@@ -104,13 +107,28 @@ protected:
     bool male;      ///< TRUE if the case is for a male connector
     double  pbev;   ///< bevel for the bottom hole (and top hole for M case)
     double  fbev;   ///< bevel for the top hole (only for F case)
+    int nhidden;    ///< number of hidden faces omitted by the last Build()
 
     // vertices
     double* x, * y, * z;    // vertices for body
     int nv;                 // number of vertices (6*columns + 2); NOTE: not the total points
     double sv[3][8];        // vertices for shoulders (always 4*2)
 
+    // hole frames at X = 0 for each kind of row; these do not depend
+    // on the number of columns and are translated to each position
+    HOLE    sbot[2];        ///< bottom frames: front/back (or all) rows, middle rows
+    HOLE    stop[2];        ///< top frames
+    bool    hasSlices;      ///< TRUE if sbot and stop are current
+
     void setDefaults( void );
+    int calcSlices( void );
+
+    // write the bottom and top frames of one kind of row at each
+    // offset; each face is a single Shape
+    int buildHoles( int kind, const std::vector<double>& ox, const std::vector<double>& oy,
+            KC3D::TRANSFORM& t, KC3D::VRMLMAT& color, bool reuse_color,
+            std::ofstream& fp, int tabs = 0 );
+
     int makeHoles1( KC3D::TRANSFORM& t, KC3D::VRMLMAT& color, bool reuse_color,
             std::ofstream& fp, int tabs = 0 );
     int makeHoles2( KC3D::TRANSFORM& t, KC3D::VRMLMAT& color, bool reuse_color,
@@ -162,6 +180,18 @@ public:
                    double aBotHoleBev, double aTopHoleBev,
                    int aNCols, int aNRows, int aNVertex );
 
+    /**
+     * \brief Change the number of columns
+     *
+     * Change the number of columns while keeping all other parameters;
+     * the hole frames calculated for a previous Build are reused, so
+     * this is the cheapest way to render a family of headers.
+     *
+     * @param aNCols [in] number of columns (>= 1)
+     * @return 0 for success, -1 for failure
+     */
+    int SetColumns( int aNCols );
+
     /**
      * \brief Write the header shape to an output file
      *
@@ -174,6 +204,19 @@ public:
      */
     int Build( KC3D::TRANSFORM& aTransform, KC3D::VRMLMAT& aMaterial, bool reuseMaterial,
                std::ofstream& aVRMLFile, int aTabDepth = 0 );
+
+    /**
+     * \brief Retrieve the number of hidden faces omitted by the last Build
+     *
+     * Faces which are coplanar with and covered by another face of the
+     * case can never be seen and are not written to the output file.
+     *
+     * @return number of faces omitted
+     */
+    int GetHiddenFaces( void ) const
+    {
+        return nhidden;
+    }
 };
 
 }    // namespace KC3D
@@ -59,9 +59,10 @@ private:
      * @param top   [in] TRUE if the surface is to be visible from the top (+Z)
      * @param fp    [in] open output file
      * @param tabs  [in] indent level for formatting
+     * @param base  [in] index of the first frame vertex
      * @return
      */
-    int writeRFacets( bool top, std::ofstream& fp, int tabs = 0 );
+    int writeRFacets( bool top, std::ofstream& fp, int tabs = 0, int base = 0 );
 
     /**
      * Write the facet index list for a beveled rectangular hole
@@ -69,9 +70,14 @@ private:
      * @param top   [in] TRUE if the surface is to be visible from the top (+Z)
      * @param fp    [in] open output file
      * @param tabs  [in] indent level for formatting
+     * @param base  [in] index of the first frame vertex
      * @return
      */
-    int writeRFacetsB( bool top, std::ofstream& fp, int tabs = 0 );
+    int writeRFacetsB( bool top, std::ofstream& fp, int tabs = 0, int base = 0 );
+
+    // write the facets of the frame whose first vertex is at index
+    // 'base'; 'term' is TRUE for the last facets of the index list
+    int writeFrame( bool top, int base, std::ofstream& fp, int tabs, bool term );
 
     /**
      * Write the facet index list for a circular hole
@@ -116,6 +122,9 @@ public:
               TRANSFORM& aTransform, bool isSquare, double aHoleWOff = 0.0,
               double aHoleDOff = 0.0, int aNVertex = 16, double aBevel = -1.0 );
 
+    /// Copy the hole aHole plus an offset; see POLYGON::Translate()
+    int Translate( const HOLE& aHole, double dX, double dY, double dZ );
+
     /**
      * Render a surface with a hole
      *
@@ -129,6 +138,28 @@ public:
      */
     int Build( bool isTopView, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool reuseMaterial,
                std::ofstream& aVRMLFile, int aTabDepth = 0 );
+
+    /**
+     * Render copies of the surface at several positions
+     *
+     * All copies are written as a single Shape; this is much more
+     * compact than invoking Build for each position when a feature
+     * such as the frame around a header pin is repeated many times.
+     *
+     * @param isTopView [in] TRUE if visible from +Z
+     * @param aXOffset [in] X offset of each copy
+     * @param aYOffset [in] Y offset of each copy
+     * @param aNOffset [in] number of copies (>= 1)
+     * @param aTransform [in] geometric transform to apply to output vertices
+     * @param aMaterial [in] VRMLMAT material appearance
+     * @param reuseMaterial [in] TRUE to reuse a previously written material name
+     * @param aVRMLFile [in] open output file
+     * @param aTabDepth [in] indent level for formatting
+     * @return 0 for success, -1 for failure
+     */
+    int BuildArray( bool isTopView, const double* aXOffset, const double* aYOffset,
+                    int aNOffset, TRANSFORM& aTransform, VRMLMAT& aMaterial,
+                    bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth = 0 );
 };
 
 }    // namespace KC3D
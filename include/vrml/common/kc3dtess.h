@@ -18,29 +18,23 @@
  *
  *
  *      This class creates a tessellated surface given a solid outline in the
- *      XY plane and a list of cutouts.
+ *      XY plane and a list of cutouts. The surface is triangulated by ear
+ *      clipping after each cutout is bridged to the outline which contains it;
+ *      contours may touch but must not cross each other.
+ *
+ *      TESSELATOR objects hold no global state other than the optional
+ *      result cache, which is internally locked; separate objects may be
+ *      used concurrently from different threads but a single object must
+ *      not be shared between threads without external locking.
  *
  */
 
 #ifndef KC3DTESS_H
 #define KC3DTESS_H
 
-#include <wx/glcanvas.h>    // CALLBACK definition, needed on Windows
-// alse needed on OSX to define __DARWIN__
-
-#ifdef __WXMAC__
-#  ifdef __DARWIN__
-#    include <OpenGL/glu.h>
-#  else
-#    include <glu.h>
-#  endif
-#else
-#  include <GL/glu.h>
-#endif
-
 #include <fstream>
+#include <string>
 #include <vector>
-#include <list>
 #include <utility>
 
 #ifndef M_PI2
@@ -68,19 +62,6 @@ namespace KC3D
     };
 
 
-    struct TRIPLET_3D
-    {
-        int i1, i2, i3;
-
-        TRIPLET_3D( int p1, int p2, int p3 )
-        {
-            i1  = p1;
-            i2  = p2;
-            i3  = p3;
-        }
-    };
-
-
     class TESSELATOR
     {
     private:
@@ -93,46 +74,57 @@ namespace KC3D
         int     idx;                            // vertex index (number of contained vertices)
         int     ord;                            // vertex order (number of ordered vertices)
         unsigned int idxout;                    // outline index to first point in 3D outline
-        std::vector<VERTEX_3D*> vertices;       // vertices of all contours
-        std::vector<std::list<int>*> contours;  // lists of vertices for each contour
-        std::vector< double > areas;            // area of the contours (positive if winding is CCW)
-        std::list<TRIPLET_3D> triplets;         // output facet triplet list (triplet of ORDER values)
-        std::list<std::list<int>*> outline;     // indices for outline outputs (index by ORDER values)
+        std::vector<VERTEX_3D> vertices;        // vertices of all contours
+        std::vector<int> cindex;                // vertex indices of all contours, contour by contour
+        std::vector<int> cstart;                // offset of the first entry of each contour in cindex
+        std::vector<int> csize;                 // number of entries in each contour
+        std::vector< double > areas;            // area of the contours (positive if winding is CW)
+        std::vector<int> triplets;              // output facets (3 ORDER values per facet)
+        std::vector<int> oindex;                // outline loops (ORDER values), loop by loop
+        std::vector<int> ostart;                // offset of the first entry of each loop in oindex
         std::vector<int> ordmap;                // mapping of ORDER to INDEX
 
         std::string error;                      // error message
 
-        int eidx;                               // index for extra vertices
-        std::vector<VERTEX_3D*> extra_verts;    // extra vertices added for outlines and facets
-        std::vector<VERTEX_3D*> vlist;          // vertex list for the GL command in progress
-        TESSELATOR* pholes;                     // pointer to another layer object used for tesselation;
-                                                // this object is normally expected to hold only holes
+        void clearTmp( void );                  // clear ephemeral data used by the tesselation routine
 
-        GLUtesselator* tess;                    // local instance of the GLU tesselator
+        // add a vertex to the end of a contour
+        void pushVertex( int aContourID, double aXpos, double aYpos );
 
-        GLenum glcmd;                           // current GL command type ( fan, triangle, tri-strip, loop )
-
-        void clearTmp( void );                  // clear ephemeral data used by the tesselation routine
+        // number of segments used to discretize an arc
+        int arcSegments( double aRadius, double aSweepAngle );
 
         // add a triangular facet (triplet) to the output index list
-        bool addTriplet( VERTEX_3D* p0, VERTEX_3D* p1, VERTEX_3D* p2 );
+        bool addTriplet( const VERTEX_3D& p0, const VERTEX_3D& p1, const VERTEX_3D& p2 );
 
-        // retrieve a vertex given its index; the vertex may be contained in the
-        // vertices vector, extra_verts vector, or foreign TESSELATOR object
+        // retrieve a vertex given its index
         VERTEX_3D* getVertexByIndex( int aPointIndex );
 
-        void    processFan( void );                 // process a GL_TRIANGLE_FAN list
-        void    processStrip( void );               // process a GL_TRIANGLE_STRIP list
-        void    processTri( void );                 // process a GL_TRIANGLES list
+        // copy a contour into the outline list, skipping repeated points;
+        // returns the number of points in the resulting loop
+        int pushOutline( int aContourID );
 
-        void pushVertices( bool holes );            // push the internal vertices
-        bool pushOutline( void );                   // push the (GL generated) outline vertices
+        // triangulate a solid contour and the holes which it contains
+        bool tesselateContour( int aSolidID, const std::vector<int>& aHoleList );
 
         // returns the number of solid or hole contours
         int checkNContours( bool holes );
 
+        // write the side walls of a slab as quadrilateral facets
+        bool writeWalls( bool aUpFlag, std::ofstream& aOutFile, int aTabDepth );
+
+        // build the key which identifies the contours in the result cache
+        void makeFingerprint( std::vector<double>& aKey );
+
+        // retrieve a previous result from the cache; returns true on success
+        bool loadCached( const std::vector<double>& aKey, size_t aHash );
+
+        // place the current result in the cache; aKey is consumed
+        void storeCached( std::vector<double>& aKey, size_t aHash );
+
     public:
-        /// set to true when a fault is encountered during tesselation
+        /// set to true when a fault is encountered during tesselation: no
+        /// facets were produced or a hole could not be joined to its outline
         bool Fault;
 
         TESSELATOR();
@@ -156,7 +148,7 @@ namespace KC3D
          */
         int GetNContours( void )
         {
-            return contours.size();
+            return csize.size();
         }
 
         /**
@@ -190,6 +182,54 @@ namespace KC3D
          */
         bool AddPolygon( const KC3D::POLYGON& aPolygon, bool aHoleFlag );
 
+        /**
+         * Function SetArcParams
+         * sets the parameters used to discretize arcs and circles; the
+         * defaults (48, 0.1, 0.5) are suitable for models in mm.
+         * A full circle is divided into at most @param aMaxArcSeg segments
+         * and segments are no shorter than @param aMinSegLength; on large
+         * circles segments are added until none is longer than
+         * @param aMaxSegLength.
+         *
+         * @param aMaxArcSeg is the maximum number of segments in a small circle (>= 3)
+         * @param aMinSegLength is the minimum segment length
+         * @param aMaxSegLength is the maximum segment length (>= aMinSegLength)
+         *
+         * @return bool: true if the parameters were accepted
+         */
+        bool SetArcParams( int aMaxArcSeg, double aMinSegLength, double aMaxSegLength );
+
+        /**
+         * Function AddArc
+         * appends a discretized circular arc to the requested contour;
+         * both end points of the arc are included. Angles are in radians,
+         * measured counterclockwise from the +X axis.
+         *
+         * @param aContourID is an index previously returned by a call to NewContour()
+         * @param aXcenter is the X coordinate of the center of the arc
+         * @param aYcenter is the Y coordinate of the center of the arc
+         * @param aRadius is the radius of the arc
+         * @param aStartAngle is the angle of the first point of the arc
+         * @param aSweepAngle is the angle subtended by the arc; negative for a clockwise arc
+         *
+         * @return bool: true if the arc was added
+         */
+        bool AddArc( int aContourID, double aXcenter, double aYcenter, double aRadius,
+                     double aStartAngle, double aSweepAngle );
+
+        /**
+         * Function AddCircle
+         * creates a new contour containing a discretized circle
+         *
+         * @param aXcenter is the X coordinate of the center of the circle
+         * @param aYcenter is the Y coordinate of the center of the circle
+         * @param aRadius is the radius of the circle
+         * @param aHoleFlag determines if the resulting contour must be a hole
+         *
+         * @return bool: true if the circle was added
+         */
+        bool AddCircle( double aXcenter, double aYcenter, double aRadius, bool aHoleFlag );
+
         /**
          * Function EnsureWinding
          * checks the winding of a contour and ensures that it is a hole or
@@ -206,7 +246,9 @@ namespace KC3D
         /**
          * Function Tesselate
          * creates a list of outline vertices as well as the
-         * vertex sets required to render the surface.
+         * vertex sets required to render the surface. Each hole is
+         * assigned to the smallest solid contour which contains it;
+         * holes which do not lie within a solid are ignored.
          *
          * @return bool: true if the operation succeeded
          */
@@ -220,11 +262,12 @@ namespace KC3D
          * @param aOutFile is the file to write to
          * @param aPrecision is the precision of the output coordinates
          * @param aTransform is the transform to apply to output vertices
+         * @param aZpos is the Z coordinate of the surface prior to the transform
          *
          * @return bool: true if the operation succeeded
          */
         bool WriteVertices( std::ofstream& aOutFile, int aPrecision,
-                            KC3D::TRANSFORM& aTransform, int aTabDepth );
+                            KC3D::TRANSFORM& aTransform, int aTabDepth, double aZpos = 0.0 );
 
         /**
          * Function WriteIndices
@@ -234,57 +277,32 @@ namespace KC3D
          * @param aTopFlag is true if the surface is to be visible from above;
          * if false the surface will be visible from below.
          * @param aOutFile is the file to write to
+         * @param aOffset is added to every index written
          *
          * @return bool: true if the operation succeeded
          */
-        bool WriteIndices( bool aTopFlag, std::ofstream& aOutFile, int aTabDepth );
+        bool WriteIndices( bool aTopFlag, std::ofstream& aOutFile, int aTabDepth, int aOffset = 0 );
 
     public:
         /**
-         * Function AddExtraVertex
-         * adds an extra vertex as required by the GLU tesselator.
-         *
-         * @param aXpos is the X coordinate of the newly created point
-         * @param aYpos is the Y coordinate of the newly created point
-         *
-         * @return VERTEX_3D*: is the new vertex or NULL if a vertex
-         * could not be created.
-         */
-        VERTEX_3D* AddExtraVertex( double aXpos, double aYpos );
-
-        /**
-         * Function glStart
-         * is invoked by the GLU tesselator callback to notify this object
-         * of the type of GL command which is applicable to the upcoming
-         * vertex list.
+         * Function EnableCache
+         * enables or disables a result cache shared by all TESSELATOR
+         * objects in the process. When enabled, a set of contours which
+         * matches a previously tesselated set (same vertex order and
+         * winding, coordinates quantized to 1e-6) reuses the earlier
+         * triangulation and only the output transform is applied.
+         * The cache is disabled by default; disabling it discards
+         * all stored results.
          *
-         * @param cmd is the GL command
-         */
-        void glStart( GLenum cmd );
-
-        /**
-         * Function glPushVertex
-         * is invoked by the GLU tesselator callback; the supplied vertex is
-         * added to the internal list of vertices awaiting processing upon
-         * execution of glEnd()
-         *
-         * @param vertex is a vertex forming part of the GL command as previously
-         * set by glStart
-         */
-        void glPushVertex( VERTEX_3D* vertex );
-
-        /**
-         * Function glEnd
-         * is invoked by the GLU tesselator callback to notify this object
-         * that the vertex list is complete and ready for processing
+         * @param aEnable is true to enable the cache
          */
-        void glEnd( void );
+        static void EnableCache( bool aEnable );
 
         /**
-         * Function SetGLError
-         * sets the error message according to the specified OpenGL error
+         * Function ClearCache
+         * discards all results held in the tesselation cache
          */
-        void SetGLError( GLenum error_id );
+        static void ClearCache( void );
 
         /**
          * Function GetVertexByIndex
@@ -316,6 +334,25 @@ namespace KC3D
          */
         bool WriteVRML( bool isCCW, TRANSFORM& aTransform, VRMLMAT& aMaterial,
                         bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth );
+
+        /**
+         * \ Brief write a slab of the tesselated surface to a VRML file
+         *
+         * The surface is written at Z = 0 and again at Z = @param aThickness;
+         * both faces share one triangulation and the side walls are formed
+         * from the contour outlines. The result is a single closed Shape
+         * with all facets visible from the outside.
+         *
+         * @param aThickness      [in] extent of the slab along Z; may be negative
+         * @param aTransform      [in] transform to apply to output vertices
+         * @param aMaterial       [in] appearance specification
+         * @param reuseMaterial   [in] true to reuse @param aMaterial
+         * @param aVRMLFile       [in] open output file
+         * @param aTabDepth       [in] formatting indent level
+         * @return true for success, false for failure
+         */
+        bool WriteSlab( double aThickness, TRANSFORM& aTransform, VRMLMAT& aMaterial,
+                        bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth );
     };
 
 }   // namespace KC3D
@@ -0,0 +1,132 @@
+/*
+ *      file: outpath.h
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ *
+ *      This class maps model names to output files using a path
+ *      pattern such as "{series}/{decade}/{name}.wrl" and creates the
+ *      directories leading to each file as required. The fields {name}
+ *      and {series} are always available; {series} is the part of the
+ *      model name before the first '_' unless it is set by the user.
+ *      Any other field must be set via SetField() before use.
+ *
+ */
+
+#ifndef OUTPATH_H
+#define OUTPATH_H
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+
+namespace KC3D
+{
+
+    /**
+     * \ingroup vrml_tools
+     * \brief Output path pattern for generated models
+     */
+    class OUTPATH
+    {
+    private:
+        std::string pattern;
+        std::map<std::string, std::string> fields;
+        std::set<std::string> dirs;     // directories known to exist
+
+    public:
+        OUTPATH();
+        OUTPATH( const std::string& aPattern );
+
+        /**
+         * Function SetPattern
+         * sets the output path pattern; an empty pattern is
+         * equivalent to "{name}.wrl"
+         *
+         * @param aPattern is the pattern
+         * @return 0 for success, -1 if the pattern is malformed
+         */
+        int SetPattern( const std::string& aPattern );
+
+        /**
+         * Function GetPattern
+         * @return std::string: the current pattern
+         */
+        const std::string& GetPattern( void ) const;
+
+        /**
+         * Function SetField
+         * sets the value substituted for {aKey}
+         *
+         * @param aKey is the name of the field without braces
+         * @param aValue is the value of the field
+         */
+        void SetField( const std::string& aKey, const std::string& aValue );
+
+        /**
+         * Function ClearFields
+         * removes all fields set via SetField()
+         */
+        void ClearFields( void );
+
+        /**
+         * Function Expand
+         * substitutes the fields of the pattern for the given model
+         *
+         * @param aName is the model name
+         * @param aPath [out] is the resulting path
+         * @return 0 for success, -1 if the pattern contains an unknown field
+         */
+        int Expand( const std::string& aName, std::string& aPath ) const;
+
+        /**
+         * Function MakePath
+         * expands the pattern for the given model and creates the
+         * directories leading to the file; this is intended for
+         * model Build functions which take an output path
+         *
+         * @param aName is the model name
+         * @return std::string: the path of the output file or an
+         * empty string on failure
+         */
+        std::string MakePath( const std::string& aName );
+
+        /**
+         * Function MakeDirs
+         * creates any missing directories leading to a file
+         *
+         * @param aPath is the path of the file
+         * @return 0 for success, -1 for failure
+         */
+        int MakeDirs( const std::string& aPath );
+
+        /**
+         * Function Open
+         * expands the pattern for the given model, creates the
+         * directories and invokes SetupVRML to open the file and
+         * write the VRML header
+         *
+         * @param aName is the model name
+         * @param aOutputStream [in,out] is the VRML output file stream
+         * @return 0 for success, -1 for failure
+         */
+        int Open( const std::string& aName, std::ofstream& aOutputStream );
+    };
+
+}    // namespace KC3D
+
+#endif // OUTPATH_H
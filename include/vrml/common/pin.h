@@ -114,7 +114,10 @@ public:
      */
     virtual int Build( bool aRenderCap0, bool aRenderCap1, TRANSFORM& aFinalTransform,
                        VRMLMAT& aMaterial, bool reuseMaterial,
-                       std::ofstream& aVRMLFile, int aTabDepth = 0 );
+                       std::ostream& aVRMLFile, int aTabDepth = 0 );
+
+    /// Copy the pin aPin plus an offset; see POLYGON::Translate()
+    int Translate( const PIN& aPin, double dX, double dY, double dZ );
 
     /**
      * Set the shape of a generic pin or wire
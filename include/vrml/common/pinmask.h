@@ -0,0 +1,147 @@
+/*
+ *      file: pinmask.h
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ *
+ *      This class holds the set of pins of a part which are to be
+ *      rendered. Pins are numbered from 1; the pins may be set singly,
+ *      by range, at regular intervals, from a list such as "1,3,5-8"
+ *      or from a repeating pattern such as "10" (every other pin).
+ *
+ */
+
+#ifndef PINMASK_H
+#define PINMASK_H
+
+#include <string>
+#include <vector>
+
+namespace KC3D
+{
+
+    /**
+     * \ingroup vrml_tools
+     * \brief Set of pins to be rendered
+     */
+    class PINMASK
+    {
+    private:
+        std::vector<unsigned long> bits;
+        int npins;
+
+    public:
+        PINMASK();
+        PINMASK( int aNPins );
+
+        /**
+         * Function SetSize
+         * sets the number of pins; all pins are set
+         *
+         * @param aNPins is the number of pins (>= 0)
+         * @return 0 for success, -1 for failure
+         */
+        int SetSize( int aNPins );
+
+        /**
+         * Function GetSize
+         * @return int: the number of pins
+         */
+        int GetSize( void ) const;
+
+        /**
+         * Function SetAll
+         * sets or clears all pins
+         *
+         * @param isSet is true to set the pins
+         */
+        void SetAll( bool isSet );
+
+        /**
+         * Function Set
+         * sets or clears a single pin
+         *
+         * @param aPin is the pin number, 1 .. GetSize()
+         * @param isSet is true to set the pin
+         * @return 0 for success, -1 if the pin is out of range
+         */
+        int Set( int aPin, bool isSet );
+
+        /**
+         * Function Get
+         * @param aPin is the pin number, 1 .. GetSize()
+         * @return bool: true if the pin is set; false if it is not
+         * set or out of range
+         */
+        bool Get( int aPin ) const;
+
+        /**
+         * Function SetRange
+         * sets or clears the pins aFirst .. aLast
+         *
+         * @return 0 for success, -1 if the range is invalid
+         */
+        int SetRange( int aFirst, int aLast, bool isSet );
+
+        /**
+         * Function SetEvery
+         * sets or clears the pins aFirst, aFirst + aStep, ... up to
+         * the last pin
+         *
+         * @return 0 for success, -1 if aFirst or aStep is invalid
+         */
+        int SetEvery( int aFirst, int aStep, bool isSet );
+
+        /**
+         * Function SetList
+         * sets or clears the pins in a list of pins and ranges such as
+         * "1,3,5-8"; pins beyond the last pin are ignored so that a
+         * list may be applied to a family of parts
+         *
+         * @return 0 for success, -1 if the list is malformed
+         */
+        int SetList( const std::string& aList, bool isSet );
+
+        /**
+         * Function SetPattern
+         * sets all pins from a pattern of '1' (set) and '0' (clear)
+         * which is repeated as necessary; for example "10" sets every
+         * other pin starting with pin 1
+         *
+         * @return 0 for success, -1 if the pattern is malformed
+         */
+        int SetPattern( const std::string& aPattern );
+
+        /**
+         * Function Count
+         * @return int: the number of pins which are set
+         */
+        int Count( void ) const;
+
+        /**
+         * Function Next
+         * finds the first set pin after the given pin; use Next( 0 )
+         * to find the first set pin
+         *
+         * @param aPin is the pin number to start after
+         * @return int: the next set pin or 0 if there are none
+         */
+        int Next( int aPin ) const;
+    };
+
+}    // namespace KC3D
+
+#endif // PINMASK_H
@@ -100,7 +100,7 @@ public:
      * @return 0 for success, -1 for failure
      */
     virtual int Paint( bool isCCW, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool reuseMaterial,
-            std::ofstream& aVRMLFile, int aTabDepth = 0 );
+            std::ostream& aVRMLFile, int aTabDepth = 0 );
 
     /**
      * \brief Render a surface defined by the perimeter of 2 polygons
@@ -121,7 +121,7 @@ public:
      * @return 0 for success, -1 for failure
      */
     virtual int Stitch( bool isCCW, POLYGON& aPolygon, TRANSFORM& aTransform, VRMLMAT& aMaterial,
-                         bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth );
+                         bool reuseMaterial, std::ostream& aVRMLFile, int aTabDepth );
 
     /**
      * \ Brief extrude a polygon and write to file
@@ -149,7 +149,7 @@ public:
                          TRANSFORM& aFinalTransform,
                          VRMLMAT& aMaterial,
                          bool reuseMaterial,
-                         std::ofstream& aVRMLFile,
+                         std::ostream& aVRMLFile,
                          int aTabDepth = 0 );
 
     /**
@@ -164,6 +164,25 @@ public:
      */
     int Xform( TRANSFORM& T );
 
+    /**
+     * \brief Copy translated vertices
+     *
+     * Set the vertices to those of another polygon with the same number
+     * of vertices plus an offset. This is much cheaper than Calc when
+     * the same feature is repeated at many positions; the results are
+     * identical to those of Calc with the translation added to its transform.
+     * Shapes made of several polygons (PIN, FUNNEL, HOLE) provide a
+     * Translate which does the same for each of their polygons; the
+     * shape being copied must have been set up via Calc.
+     *
+     * @param aPolygon [in] polygon to copy the vertices from
+     * @param dX [in] X offset
+     * @param dY [in] Y offset
+     * @param dZ [in] Z offset
+     * @return 0 for success, -1 for failure
+     */
+    int Translate( const POLYGON& aPolygon, double dX, double dY, double dZ );
+
     /**
      * \brief Retrieve the internal vertex list
      * @param px [out] pointer to internal array of X coordinates
@@ -59,6 +59,22 @@ class VRMLMAT;
  */
 int SetupVRML( std::string aFilename, std::ofstream& aOutputStream );
 
+/**
+ * \ingroup vrml_tools
+ * \fn int SetupVRML(std::string filename, std::string path, std::ofstream &fp)
+ * \brief Create the VRML header in a file at the given path
+ *
+ * This procedure is identical to SetupVRML(filename, fp) except
+ * that the file is created at the given path while the header
+ * records only the file name.
+ *
+ * @param aFilename [in] name of the file as recorded in the header
+ * @param aPath [in] path of the file to create or open
+ * @param aOutputStream [in,out] VRML output file stream
+ * @return 0 for success, -1 for failure
+ */
+int SetupVRML( std::string aFilename, std::string aPath, std::ofstream& aOutputStream );
+
 /**
  * \ingroup vrml_tools
  * \fn int SetupXForm(std::string name, std::ofstream &fp, int tabs = 0)
@@ -95,7 +111,7 @@ int CloseXForm( std::ofstream& aVRMLFile, int aTabDepth = 0 );
 
 /**
  * \ingroup vrml_tools
- * \fn int SetupShape(VRMLMat &color, bool reuse_color, std::ofstream &fp, int tabs = 0)
+ * \fn int SetupShape(VRMLMat &color, bool reuse_color, std::ostream &fp, int tabs = 0)
  * \brief Set up a VRML Shape block
  *
  * Write the opening statements of a VRML2.0 Shape block. The
@@ -108,11 +124,11 @@ int CloseXForm( std::ofstream& aVRMLFile, int aTabDepth = 0 );
  * @return 0 for success, -1 for failure
  */
 int SetupShape( VRMLMAT& aMaterial, bool reuseMaterial,
-        std::ofstream& aVRMLFile, int aTabDepth = 0 );
+        std::ostream& aVRMLFile, int aTabDepth = 0 );
 
 /**
  * \ingroup vrml_tools
- * \fn int CloseShape(std::ofstream &fp, int tabs = 0)
+ * \fn int CloseShape(std::ostream &fp, int tabs = 0)
  * \brief Close a VRML Shape block
  *
  * Write the closing braces for a VRML2.0 Shape block previously
@@ -122,11 +138,11 @@ int SetupShape( VRMLMAT& aMaterial, bool reuseMaterial,
  * @param aTabDepth [in] indent level for formatting
  * @return
  */
-int CloseShape( std::ofstream& aVRMLFile, int aTabDepth = 0 );
+int CloseShape( std::ostream& aVRMLFile, int aTabDepth = 0 );
 
 /**
  * \ingroup vrml_tools
- * \fn int WriteCoord(double *x, double *y, double *z, int np, std::ofstream &fp, int tabs = 0)
+ * \fn int WriteCoord(double *x, double *y, double *z, int np, std::ostream &fp, int tabs = 0)
  * \brief Write a VRML coordinate block
  *
  * This procedure writes out a VRML2.0 Coordinate block
@@ -141,11 +157,11 @@ int CloseShape( std::ofstream& aVRMLFile, int aTabDepth = 0 );
  * @return  0 for success, -1 for failure
  */
 int WriteCoord( double* x, double* y, double* z, int nPoints,
-                std::ofstream& aVRMLFile, int aTabDepth = 0 );
+                std::ostream& aVRMLFile, int aTabDepth = 0 );
 
 /**
  * \ingroup vrml_tools
- * \fn int SetupCoordIndex(std::ofstream &fp, int tabs = 0)
+ * \fn int SetupCoordIndex(std::ostream &fp, int tabs = 0)
  * \brief Set up a VRML coordIndex block
  *
  * This procedure writes the opening statement to a VRML2.0
@@ -160,11 +176,11 @@ int WriteCoord( double* x, double* y, double* z, int nPoints,
  * @param aTabDepth [in] indent level for formatting
  * @return 0 for success, -1 for failure
  */
-int SetupCoordIndex( std::ofstream& aVRMLFile, int aTabDepth = 0 );
+int SetupCoordIndex( std::ostream& aVRMLFile, int aTabDepth = 0 );
 
 /**
  * \ingroup vrml_tools
- * \fn int CloseCoordIndex(std::ofstream &fp, int tabs = 0)
+ * \fn int CloseCoordIndex(std::ostream &fp, int tabs = 0)
  * \brief Close a VRML coordIndex block
  *
  * Close a VRML2.0 coordIndex block which was previously
@@ -174,7 +190,23 @@ int SetupCoordIndex( std::ofstream& aVRMLFile, int aTabDepth = 0 );
  * @param aTabDepth [in] indent level for formatting
  * @return
  */
-int CloseCoordIndex( std::ofstream& aVRMLFile, int aTabDepth = 0 );
+int CloseCoordIndex( std::ostream& aVRMLFile, int aTabDepth = 0 );
+
+/**
+ * \ingroup vrml_tools
+ * \fn int LoadMaterial(VRMLMAT &material, const std::string &filename)
+ * \brief Load a material appearance file once per process
+ *
+ * The first call for a given file loads it via VRMLMAT::Load and
+ * keeps a copy; later calls for the same file return the copy.
+ * Model generators which create many parts from the same few
+ * appearance files should load them via this procedure.
+ *
+ * @param aMaterial [out] material appearance
+ * @param aFilename [in] name of the material appearance file
+ * @return 0 for success, -1 for failure
+ */
+int LoadMaterial( VRMLMAT& aMaterial, const std::string& aFilename );
 }    // namespace KC3D
 
 #endif // VCOM_H
@@ -0,0 +1,138 @@
+/*
+ *      file: vrmlmesh.h
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ *
+ *      This class holds a set of VRML Shapes in the form written by the
+ *      model generators (coordinate lists, a coordIndex list and a material)
+ *      and reads them from VRML2.0 files. The reader supports the subset of
+ *      VRML97 used by the generated models: Transform and Group nodes,
+ *      Shape, Appearance, Material, IndexedFaceSet and Coordinate nodes and
+ *      DEF/USE of any of these. Other nodes are skipped. All transforms are
+ *      applied while reading so the resulting shapes are in the coordinate
+ *      system of the file.
+ *
+ */
+
+#ifndef VRMLMESH_H
+#define VRMLMESH_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <vrmlmat.h>
+
+namespace KC3D
+{
+    class TRANSFORM;
+
+    /**
+     * \ingroup vrml_tools
+     * \brief A single VRML Shape with an IndexedFaceSet geometry
+     */
+    struct VRMLSHAPE
+    {
+        VRMLMAT material;           ///< material appearance of the shape
+        std::vector<double> x;      ///< X coordinates of the vertices
+        std::vector<double> y;      ///< Y coordinates of the vertices
+        std::vector<double> z;      ///< Z coordinates of the vertices
+        std::vector<int> index;     ///< coordIndex list; each facet is terminated by -1
+    };
+
+
+    /**
+     * \ingroup vrml_tools
+     * \brief A list of VRML Shapes which may be read, merged and written out
+     */
+    class VRMLMESH
+    {
+    private:
+        std::vector<VRMLSHAPE*> shapes;
+
+    public:
+        VRMLMESH();
+        ~VRMLMESH();
+
+        /**
+         * Function Read
+         * appends the shapes within a VRML2.0 file
+         *
+         * @param aFileName is the name of the file to read
+         * @return 0 for success, -1 for failure; on failure no shapes are added
+         */
+        int Read( const std::string& aFileName );
+
+        /**
+         * Function Append
+         * appends copies of the shapes of another mesh
+         *
+         * @param aMesh is the mesh to copy
+         */
+        void Append( const VRMLMESH& aMesh );
+
+        /**
+         * Function Transform
+         * transforms the vertices of a range of shapes
+         *
+         * @param aTransform is the transform to apply
+         * @param aFirstShape is the index of the first shape to transform
+         */
+        void Transform( TRANSFORM& aTransform, int aFirstShape = 0 );
+
+        /**
+         * Function Coalesce
+         * merges all shapes with identical materials into a single shape;
+         * the shapes retain the order of the first occurrence of each material
+         */
+        void Coalesce( void );
+
+        /**
+         * Function Write
+         * writes all shapes as VRML Shape blocks. Each material is defined
+         * once and subsequently reused; materials with a duplicate or
+         * empty name are given a unique name.
+         *
+         * @param aVRMLFile is the open output file
+         * @param aTabDepth is the indent level for formatting
+         * @return 0 for success, -1 for failure
+         */
+        int Write( std::ofstream& aVRMLFile, int aTabDepth = 0 );
+
+        /**
+         * Function Clear
+         * deletes all shapes
+         */
+        void Clear( void );
+
+        /**
+         * Function GetNShapes
+         * @return int: the number of shapes held
+         */
+        int GetNShapes( void ) const;
+
+        /**
+         * Function GetShape
+         * @param aIndex is the index of the shape, 0 .. GetNShapes() - 1
+         * @return VRMLSHAPE*: the requested shape or NULL if the index is invalid
+         */
+        VRMLSHAPE* GetShape( int aIndex );
+    };
+
+}    // namespace KC3D
+
+#endif // VRMLMESH_H
@@ -44,9 +44,19 @@
 #define GENHDR_H
 
 #include <iosfwd>
+#include <string>
 
 #include <vrmlmat.h>
 #include <transform.h>
+#include <hdrbase.h>
+#include <circle.h>
+#include <funnel.h>
+#include <pin.h>
+
+namespace KC3D
+{
+class OUTPATH;
+}
 
 namespace KC3DCONN
 {
@@ -96,6 +106,20 @@ private:
     bool hasColors;     // true when colors have been loaded
     bool hasBparams;    // true when body parameters have been set
     bool hasPparams;    // true when pin parameters have been set
+    bool hasGeometry;   // true when the geometry below is current
+    int nhidden;        // hidden faces omitted by the last BuildFamily()
+
+    // geometry which does not depend on the number of columns
+    KC3D::HDRBASE hbase;    // case
+    KC3D::PIN pin[2];       // pins at the origin
+    KC3D::CIRCLE circ[4];   // shroud circles at the origin
+    KC3D::FUNNEL fun;       // funnel at the origin
+
+    // calculate the case parameters, pins, shrouds and funnels
+    int calcGeometry( void );
+    int calcPins( void );
+    int calcShrouds( void );
+    int calcFunnels( void );
 
     // render the case
     int makeCase( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs = 0 );
@@ -124,6 +148,37 @@ public:
     int Build( KC3D::TRANSFORM& aTransform, std::string aPartName,
                std::ofstream& aVRMLFile, int aTabDepth = 0 );
 
+    /**
+     * Create the VRML objects for a range of columns; the case, pins
+     * and funnels are calculated once and reused by each model. The
+     * models are named [aPrefix][cols][aSuffix] where the number of
+     * columns has at least 2 digits and the field {cols} is set in
+     * aOutPath for each model. The number of columns set via
+     * SetCase is not changed. The number of hidden faces omitted
+     * from the family is available via GetHiddenFaces().
+     *
+     * @param aTransform [in] geometric transform to apply to output
+     * @param aMinCols [in] smallest number of columns (min: 1)
+     * @param aMaxCols [in] largest number of columns
+     * @param aPrefix [in] part name before the number of columns
+     * @param aSuffix [in] part name after the number of columns
+     * @param aOutPath [in] output path pattern for the files
+     * @return 0 for success, -1 for failure
+     */
+    int BuildFamily( KC3D::TRANSFORM& aTransform, int aMinCols, int aMaxCols,
+                     const std::string& aPrefix, const std::string& aSuffix,
+                     KC3D::OUTPATH& aOutPath );
+
+    /**
+     * Retrieve the number of hidden faces omitted by the last BuildFamily()
+     *
+     * @return number of faces omitted from all models of the family
+     */
+    int GetHiddenFaces( void ) const
+    {
+        return nhidden;
+    }
+
     /**
      * Read VRML material appearances from file
      *
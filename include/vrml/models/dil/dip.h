@@ -32,6 +32,14 @@
 #include <string>
 
 #include <vrmlmat.h>
+#include <pinmask.h>
+#include <dip_case.h>
+#include <dip_pin.h>
+
+namespace KC3D
+{
+    class OUTPATH;
+}
 
 namespace KC3DDIP
 {
@@ -72,10 +80,17 @@ class DIP
 private:
     DIPPARAMS params;
     int pins;
-    bool* haspin;
+    KC3D::PINMASK pinmask;  // pins which are rendered
     KC3D::VRMLMAT   pinmaterial;
     KC3D::VRMLMAT   casematerial;
 
+    // the case and pin geometry are kept between models with the
+    // same parameters; only the case length changes with the pins
+    DIPCASE iccase;
+    DIPPIN  icpin;
+    bool    caseValid;
+    bool    pinValid;
+
 public:
     DIP();
     virtual ~DIP();
@@ -89,8 +104,23 @@ public:
     // control whether a pin is rendered (on) or not
     int SetPin( int aPinNumber, bool isRendered );
 
-    // create the model
-    int Build( std::string aVRMLFilename );
+    // set all rendered pins at once; the mask must have the same
+    // number of pins as the DIP
+    int SetPinMask( const KC3D::PINMASK& aMask );
+
+    // retrieve the rendered pins for bulk changes; the mask is
+    // reset to all pins by SetPins()
+    KC3D::PINMASK& GetPinMask( void );
+
+    // create the model; the file is written to aOutputPath if it
+    // is not empty and the VRML header records aVRMLFilename
+    int Build( std::string aVRMLFilename, std::string aOutputPath = "" );
+
+    // create the models for every even number of pins from aMinPins
+    // to aMaxPins; the models are named [aPrefix][pins][aSuffix] and
+    // aOutPath gives each file; the field {pins} is set for each model
+    int BuildFamily( int aMinPins, int aMaxPins, const std::string& aPrefix,
+                     const std::string& aSuffix, KC3D::OUTPATH& aOutPath );
 
     // Set the pin color
     int SetPinColor( std::string aPinMatFName );
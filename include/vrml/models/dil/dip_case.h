@@ -172,6 +172,10 @@ public:
     /// calculate the vertices
     int Calc( void );
 
+    /// change the case length of the calculated vertices; the end
+    /// sections are moved apart without recalculating the case
+    int Stretch( double aCaseLength );
+
     /// write the point list as a VRML Coordinate{}
     int WriteCoord( KC3D::TRANSFORM& aTransform, std::ofstream& aVRMLFile, int aTabDepth = 0 );
 
@@ -0,0 +1,99 @@
+/*
+ *  file: diodebase.h
+ *
+ *  Copyright 2012-2014 Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#ifndef DIODEBASE_H
+#define DIODEBASE_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace KC3D
+{
+class OUTPATH;
+}
+
+namespace KC3DDIODE
+{
+/**
+ * Base class for the axial diodes; it keeps the list of models
+ * written by BuildVariants(). The body of each orientation is
+ * calculated once per call to BuildVariants() and is reused by
+ * all models of that orientation.
+ */
+class DIODEBASE
+{
+protected:
+    struct VARIANT
+    {
+        std::string name;   // part name
+        double pitch;       // lead pitch
+        bool horiz;         // true for horizontal orientation
+        bool vkflip;        // true if the cathode is at the long lead (vertical only)
+    };
+
+    // check the build constraints; a horizontal part has isVKFlipped reset
+    virtual int checkBuild( bool isHoriz, bool& isVKFlipped, double aPitch,
+                            double aLeadDepth ) = 0;
+    // calculate body set aBodySet (0 = horizontal, 1 = vertical, 2 = vertical flipped)
+    virtual void calcVariantBody( int aBodySet, bool isHoriz, bool isVKFlipped ) = 0;
+    // write a model using the body set aBodySet to an open VRML file
+    virtual int writeVariant( std::ofstream& aVRMLFile, const VARIANT& aVariant,
+                              int aBodySet, double aScale, double aLeadDepth ) = 0;
+
+private:
+    std::vector<VARIANT> variants;  // models to be written by BuildVariants()
+
+public:
+    DIODEBASE();
+    virtual ~DIODEBASE();
+
+    /**
+     * Add a model to the list written by BuildVariants()
+     *
+     * @param aPartname [in] name of the part
+     * @param isHoriz [in] true if horizontal orientation
+     * @param isVKFlipped [in] true if we wish to flip the anode/cathode in the vertical orientation
+     * @param aPitch [in] lead pitch
+     */
+    void AddVariant( const std::string& aPartname, bool isHoriz,
+                     bool isVKFlipped, double aPitch );
+
+    /**
+     * Remove all models added via AddVariant()
+     */
+    void ClearVariants( void );
+
+    /**
+     * Write all models added via AddVariant(); the body is calculated
+     * once per orientation and only the leads are calculated for each
+     * model. The field {orient} is set to "horiz" or "vert" for each
+     * model before the output path is expanded.
+     *
+     * @param aScale [in] scale to apply to output (0.3937 to match KiCAD VRML expectations)
+     * @param aLeadDepth  [in] lead length below the top of PCB
+     * @param aOutPath [in] output path pattern
+     * @return 0 for success, -1 for failure
+     */
+    int BuildVariants( double aScale, double aLeadDepth, KC3D::OUTPATH& aOutPath );
+};
+
+}    // namespace KC3DDIODE
+#endif  // DIODEBASE_H
@@ -22,8 +22,16 @@
 #define DO35_H
 
 #include <iosfwd>
+#include <string>
 
 #include <vrmlmat.h>
+#include <circle.h>
+#include <diodebase.h>
+
+namespace KC3D
+{
+class PIN;
+}
 
 namespace KC3DDIODE
 {
@@ -31,7 +39,7 @@ namespace KC3DDIODE
  * DO35 glass encapsulated package
  * such as a 1N4148 diode.
  */
-class DO35
+class DO35 : public DIODEBASE
 {
 private:
     bool hascol;        // true if the colors have been set
@@ -44,6 +52,24 @@ private:
     int ntv;            // number of vertices on tube
     int nb;             // number of segments in a 90 deg. bend
 
+    KC3D::CIRCLE vbody[3][5];   // body rings of each orientation for BuildVariants()
+    KC3D::CIRCLE vtube[3];      // inner tube of each orientation for BuildVariants()
+
+    // check the build constraints; a horizontal part has isVKFlipped reset
+    int checkBuild( bool isHoriz, bool& isVKFlipped, double aPitch, double aLeadDepth );
+    // calculate the glass body rings and the inner tube
+    void calcBody( KC3D::CIRCLE* aBody, KC3D::CIRCLE& aTube, bool isHoriz, bool isVKFlipped );
+    // calculate the leads
+    void calcLeads( KC3D::PIN* aLeads, bool isHoriz, double aPitch, double aLeadDepth );
+    // write the model to an open VRML file
+    int writeModel( std::ofstream& aVRMLFile, const std::string& aPartname,
+                    double aScale, bool isHoriz, bool isVKFlipped, double aPitch,
+                    KC3D::CIRCLE* aBody, KC3D::CIRCLE& aTube, KC3D::PIN* aLeads );
+    // DIODEBASE hooks for BuildVariants()
+    void calcVariantBody( int aBodySet, bool isHoriz, bool isVKFlipped );
+    int writeVariant( std::ofstream& aVRMLFile, const VARIANT& aVariant,
+                      int aBodySet, double aScale, double aLeadDepth );
+
 public:
     DO35();
     virtual ~DO35();
@@ -77,10 +103,12 @@ public:
      * @param isVKFlipped [in] true if we wish to flip the anode/cathode in the vertical orientation
      * @param aPitch [in] lead pitch
      * @param aLeadDepth  [in] lead length below the top of PCB (default 2.0 mm)
+     * @param aOutputPath [in] path of the output file (default [partname].wrl)
      * @return
      */
     int Build( const std::string& aPartname, double aScale, bool isHoriz,
-            bool isVKFlipped, double aPitch, double aLeadDepth = 2.0 );
+            bool isVKFlipped, double aPitch, double aLeadDepth = 2.0,
+            const std::string& aOutputPath = "" );
 };
 
 
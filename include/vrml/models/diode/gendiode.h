@@ -22,15 +22,23 @@
 #define GENDIODE_H
 
 #include <iosfwd>
+#include <string>
 
 #include <vrmlmat.h>
+#include <circle.h>
+#include <diodebase.h>
+
+namespace KC3D
+{
+class PIN;
+}
 
 namespace KC3DDIODE
 {
 /**
  * Generic plastic encapsulated cylindrical diode
  */
-class GENDIODE
+class GENDIODE : public DIODEBASE
 {
 private:
     bool hascol;        // true if the colors have been set
@@ -49,6 +57,24 @@ private:
     double wcath;       // cathode band's width
     double scath;       // distance from edge of diode to cathode band
 
+    KC3D::CIRCLE vbody[3][6];   // body rings of each orientation for BuildVariants()
+    int vnrings[3];             // number of rings used in each vbody set
+
+    // check the build constraints; a horizontal part has isVKFlipped reset
+    int checkBuild( bool isHoriz, bool& isVKFlipped, double aPitch, double aLeadDepth );
+    // calculate the body rings; returns the number of rings used (5 or 6)
+    int calcBody( KC3D::CIRCLE* aBody, bool isHoriz, bool isVKFlipped );
+    // calculate the leads
+    void calcLeads( KC3D::PIN* aLeads, bool isHoriz, double aPitch, double aLeadDepth );
+    // write the model to an open VRML file
+    int writeModel( std::ofstream& aVRMLFile, const std::string& aPartname,
+                    double aScale, bool isHoriz, bool isVKFlipped, double aPitch,
+                    KC3D::CIRCLE* aBody, int aNRings, KC3D::PIN* aLeads );
+    // DIODEBASE hooks for BuildVariants()
+    void calcVariantBody( int aBodySet, bool isHoriz, bool isVKFlipped );
+    int writeVariant( std::ofstream& aVRMLFile, const VARIANT& aVariant,
+                      int aBodySet, double aScale, double aLeadDepth );
+
 public:
     GENDIODE();
     virtual ~GENDIODE();
@@ -93,10 +119,12 @@ public:
      * @param isVKFlipped [in] true if we wish to flip the anode/cathode in the vertical orientation
      * @param aPitch [in] lead pitch
      * @param aLeadDepth  [in] lead length below the top of PCB (default 2.0 mm)
+     * @param aOutputPath [in] path of the output file (default [partname].wrl)
      * @return 0 for success, -1 for failure
      */
     int Build( const std::string& aPartname, double aScale, bool isHoriz,
-               bool isVKFlipped, double aPitch, double aLeadDepth = 2.0 );
+               bool isVKFlipped, double aPitch, double aLeadDepth = 2.0,
+               const std::string& aOutputPath = "" );
 };
 
 }    // namespace KC3DDIODE
@@ -22,6 +22,15 @@
 #define COLORCODES_H
 
 #include <iosfwd>
+#include <string>
+
+// minimum and maximum decades of a preferred value series
+#define MIN_DECADE  (0)
+#define MAX_DECADE  (10)
+
+// minimum and maximum gaps in color code
+#define MIN_GAP (0)
+#define MAX_GAP (4)
 
 namespace KC3DRESISTOR
 {
@@ -83,6 +92,48 @@ int GetValueCode5( int value, int exp, std::string& vcode );
 // exponent may be -2 .. 8. Fractional value resistances
 // are a special case not represented here.
 int GetValueCode4( int value, int exp, std::string& vcode );
+
+// Generator for the model names and color codes of a series of resistors
+// of preferred values (IEC 60063). The entries are produced one at a time
+// in order of increasing value and are identical to the 'name : code'
+// lines written by makeEnnn, so the list may be passed directly to
+// RESISTOR::Create() without an intermediate file.
+class ESERIES
+{
+    std::string partSeries;     // Part Series (for example LR0204)
+    const int*  values;         // preferred values of the series
+    int         nValues;        // number of values per decade
+    int         minDecade;      // lowest decade
+    int         maxDecade;      // highest decade
+    char        tol;            // tolerance code
+    char        tc;             // temperature coefficient code or 0
+    std::string gap;            // gap between color bands
+    int         nBands;         // number of bands, depends on 'tol'
+    int         decade;         // decade of the next entry
+    int         index;          // index of the next entry in 'values'
+
+    int makeEntry( int aDecade, int aValue, std::string& aName, std::string& aBands );
+
+public:
+    ESERIES();
+
+    // Set up the series; aSeries is one of 192, 96, 48, 24, 12 and
+    // aGap is the width of the gap between bands (MIN_GAP .. MAX_GAP).
+    // The generator is positioned at the first entry.
+    // Returns 0 on success, -1 if any parameter is invalid.
+    int Setup( const std::string& aPartSeries, int aSeries, int aMinDecade,
+               int aMaxDecade, char aTolerance, char aTCoeff = 0, int aGap = 1 );
+
+    // Position the generator at the first entry
+    void Rewind( void );
+
+    // Retrieve the next entry; values which cannot be represented are
+    // reported and skipped. Returns false when the series is exhausted.
+    bool Next( std::string& aName, std::string& aBands );
+
+    // Return the number of bands (4 or 5) or -1 if the series is not set up
+    int GetNBands( void ) const;
+};
 }    // namespace KC3DRESISTOR
 
 #endif // COLORCODES_H
@@ -92,6 +92,8 @@
 #define RESISTOR_H
 
 #include <iosfwd>
+#include <string>
+#include <vector>
 
 #include <vrmlmat.h>
 
@@ -124,18 +126,42 @@ struct RPARAMS
 class RESISTOR
 {
     RPARAMS params;
-    int makeHzLead( std::ofstream& fp );
-    int makeVtLead( std::ofstream& fp );
-    int makeBody( std::ofstream& fp, const std::string& bands );
+
+    // Geometry template: the text of the last model written, split at the
+    // band materials. Models with the same geometry parameters and number
+    // of bands are written from the template with only the band materials
+    // replaced; this avoids recalculating and reformatting the vertices
+    // for every value in a series.
+    RPARAMS tparams;                    // parameters used to build the template
+    size_t  tnbands;                    // number of bands in the template; 0 = no template
+    std::string tbody;                  // leads and body up to the first band
+    std::vector< std::string > tband;   // geometry of each band, following its material
+    std::string ttail;                  // body following the last band
+
+    int makeHzLead( std::ostream& fp );
+    int makeVtLead( std::ostream& fp );
+    int makeBody( std::ostream& fp, const std::string& bands,
+                  std::vector< std::streampos >* bandPos = NULL );
     int validateBands( const std::string& bands );
     int getColorIdx( int i, const std::string& bands );
+    bool matchTemplate( const std::string& bands );
+    void makeTemplate( const std::string& text, const std::vector< std::streampos >& marks );
+    int writeTemplate( std::ofstream& fp, const std::string& bands );
 
 public:
+    RESISTOR();
+
+    // Create the model; the file is written to aOutputPath if it is
+    // not empty, otherwise to GetModelName() + ".wrl" in the current directory
     int Create( RPARAMS& aParameters, const std::string& aBandString,
-                const std::string& aVRMLFname );
+                const std::string& aVRMLFname, const std::string& aOutputPath = "" );
 
     // Note: typically aVRMLFname = base filename =
     // [Part Series]_[Value]_[Tolerance][Tcoeff][End Style]_[Power]_[Lead Space]
+
+    // Return the name of the model (without the ".wrl" extension)
+    // which Create() produces for the given parameters and base filename
+    static std::string GetModelName( const RPARAMS& aParameters, const std::string& aVRMLFname );
 };
 
 }    // namespace KC3DRESISTOR
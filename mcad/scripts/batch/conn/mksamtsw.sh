@@ -1,210 +1,7 @@
-# Create the Samtec SL, SLD series female headers
+# Create the Samtec TSW series male headers
 
 # locate the scripts directory
 DIRPY="$(realpath "$(dirname "$0")/../../py")"
 
-python "${DIRPY}/samtec_tsw.py"
-
-# TSW single
-IDIR="mcad/vrml/thru/conn/samtec/tsw/05_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_05_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/05_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_06_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/07_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_07_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/08_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_08_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/09_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_09_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/10_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_10_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/11_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_11_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/12_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_12_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/13_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_13_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/14_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_14_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/15_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_15_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/16_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_16_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/17_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_17_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/18_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_18_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/19_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_19_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/20_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_20_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/21_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_21_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/22_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_22_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/23_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_23_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/24_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_24_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/25_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_25_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/27_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_27_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/28_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_28_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/29_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_29_G_S*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/30_S"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_30_G_S*.wrl ${IDIR}
-
-
-
-# TSW double
-IDIR="mcad/vrml/thru/conn/samtec/tsw/05_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_05_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/06_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_06_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/07_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_07_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/08_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_08_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/09_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_09_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/10_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_10_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/11_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_11_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/12_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_12_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/13_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_13_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/14_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_14_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/15_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_15_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/16_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_16_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/17_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_17_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/18_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_18_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/19_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_19_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/20_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_20_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/21_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_21_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/22_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_22_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/23_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_23_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/24_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_24_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/25_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_25_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/27_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_27_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/28_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_28_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/29_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_29_G_D*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/conn/samtec/tsw/30_D"
-mkdir -p ${IDIR}
-mv samtec_TSW_1*_30_G_D*.wrl ${IDIR}
+# models are written to tsw/[lead style]_[row option], for example tsw/05_S
+python "${DIRPY}/samtec_tsw.py" "mcad/vrml/thru/conn/samtec/tsw/{style}/{name}.wrl"
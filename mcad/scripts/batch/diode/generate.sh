@@ -1,46 +1,16 @@
 # locate the scripts directory
 DIRPY="$(realpath "$(dirname "$0")/../../py")"
 
-# Generate DO35 glass axial diodes
-python "${DIRPY}/do35.py"
-
-IDIR="mcad/vrml/thru/diode/horiz/do35"
-mkdir -p ${IDIR}
-mv -v do35*H*.wrl ${IDIR}
+OPATH="mcad/vrml/thru/diode/{orient}/{series}/{name}.wrl"
 
-IDIR="mcad/vrml/thru/diode/vert/do35"
-mkdir -p ${IDIR}
-mv -v do35*V*.wrl ${IDIR}
+# Generate DO35 glass axial diodes
+python "${DIRPY}/do35.py" "${OPATH}"
 
 # Generate DO41 axial diodes (1N4001)
-python "${DIRPY}/do41.py"
-
-IDIR="mcad/vrml/thru/diode/horiz/do41"
-mkdir -p ${IDIR}
-mv -v do41*H*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/diode/vert/do41"
-mkdir -p ${IDIR}
-mv -v do41*V*.wrl ${IDIR}
+python "${DIRPY}/do41.py" "${OPATH}"
 
 # Generate D201 axial diodes (1N5820)
-python "${DIRPY}/do201.py"
-
-IDIR="mcad/vrml/thru/diode/horiz/do201"
-mkdir -p ${IDIR}
-mv -v do201*H*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/diode/vert/do201"
-mkdir -p ${IDIR}
-mv -v do201*V*.wrl ${IDIR}
+python "${DIRPY}/do201.py" "${OPATH}"
 
 # Generate D204 axial diodes (ex: IR80SQ035)
-python "${DIRPY}/do204.py"
-
-IDIR="mcad/vrml/thru/diode/horiz/do204"
-mkdir -p ${IDIR}
-mv -v do204*H*.wrl ${IDIR}
-
-IDIR="mcad/vrml/thru/diode/vert/do204"
-mkdir -p ${IDIR}
-mv -v do204*V*.wrl ${IDIR}
+python "${DIRPY}/do204.py" "${OPATH}"
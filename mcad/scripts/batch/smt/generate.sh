@@ -1,60 +1,17 @@
 SDIR="$(realpath "$(dirname "$0")")"
 PDIR="$(realpath "$(dirname "$0")/../../py")"
 
-# QFP devices
-python ${PDIR}/smt_qfp_soic.py ${SDIR}/params.qfp
-
-IDIR="mcad/vrml/smt/lqfp"
-mkdir -p ${IDIR}
-mv LQFP*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/pqfp"
-mkdir -p ${IDIR}
-mv PQFP*.wrl ${IDIR}
+# models are written to mcad/vrml/smt/[package family]
+OPATH="mcad/vrml/smt/{family}/{name}.wrl"
 
-IDIR="mcad/vrml/smt/tqfp"
-mkdir -p ${IDIR}
-mv TQFP*.wrl ${IDIR}
+# QFP devices
+python ${PDIR}/smt_qfp_soic.py -n "${OPATH}" ${SDIR}/params.qfp
 
 # SOIC devices
-python ${PDIR}/smt_qfp_soic.py ${SDIR}/params.soic
-
-IDIR="mcad/vrml/smt/soic"
-mkdir -p ${IDIR}
-mv SOI*.wrl ${IDIR}
+python ${PDIR}/smt_qfp_soic.py -n "${OPATH}" ${SDIR}/params.soic
 
 # TSSOP devices
-python ${PDIR}/smt_qfp_soic.py ${SDIR}/params.tssop
-
-IDIR="mcad/vrml/smt/msop"
-mkdir -p ${IDIR}
-mv MSOP*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/qsop"
-mkdir -p ${IDIR}
-mv QSOP*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/ssop"
-mkdir -p ${IDIR}
-mv SSOP*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/tssop"
-mkdir -p ${IDIR}
-mv TSSOP*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/vso"
-mkdir -p ${IDIR}
-mv VSO*.wrl ${IDIR}
+python ${PDIR}/smt_qfp_soic.py -n "${OPATH}" ${SDIR}/params.tssop
 
 # DFN/QFN devices
-python ${PDIR}/smt_qfp_soic.py ${SDIR}/params.qfn
-
-IDIR="mcad/vrml/smt/dfn"
-mkdir -p ${IDIR}
-mv DFN*.wrl ${IDIR}
-mv ?DFN*.wrl ${IDIR}
-
-IDIR="mcad/vrml/smt/qfn"
-mkdir -p ${IDIR}
-mv QFN*.wrl ${IDIR}
-mv ?QFN*.wrl ${IDIR}
+python ${PDIR}/smt_qfp_soic.py -n "${OPATH}" ${SDIR}/params.qfn
@@ -37,6 +37,8 @@ import kc3ddiode
 from kc3d import *
 from kc3ddiode import *
 
+opath = OutPath(sys.argv[1] if len(sys.argv) > 1 else "{name}.wrl")
+
 diode = GenDiode()
 diode.setNVertices(16, 48, 5)
 #DO204 has max material for dwire = 1.32, dbody = 6.35, lbody = 9.52
@@ -45,18 +47,21 @@ diode.setColors( os.path.join(matpath,"tin.mat"), os.path.join(matpath,"rcc_blk_
                 os.path.join(matpath,"rcc_wht_g.mat") )
 
 # horizontal orientation (pin 1 is always the cathode)
-diode.build("do204_0I600H", 0.3937, True, False, 15.24, 4)
-diode.build("do204_0I700H", 0.3937, True, False, 17.78, 4)
-diode.build("do204_0I800H", 0.3937, True, False, 20.32, 4)
-diode.build("do204_0I900H", 0.3937, True, False, 22.86, 4)
-diode.build("do204_1I000H", 0.3937, True, False, 25.4, 4)
+diode.addVariant("do204_0I600H", True, False, 15.24)
+diode.addVariant("do204_0I700H", True, False, 17.78)
+diode.addVariant("do204_0I800H", True, False, 20.32)
+diode.addVariant("do204_0I900H", True, False, 22.86)
+diode.addVariant("do204_1I000H", True, False, 25.4)
+diode.buildVariants(0.3937, 4, opath)
+diode.clearVariants()
 
 diode.setNVertices(16, 48, 10)
 
 # vertical orientation, pin 1 is cathode, short lead on cathode
-diode.build("do204_0I200V", 0.3937, False, False, 5.08, 4)
-diode.build("do204_0I300V", 0.3937, False, False, 7.62, 4)
+diode.addVariant("do204_0I200V", False, False, 5.08)
+diode.addVariant("do204_0I300V", False, False, 7.62)
 
 # vertical orientation, pin 1 is cathode, short lead on anode
-diode.build("do204_0I200VA", 0.3937, False, True, 5.08, 4)
-diode.build("do204_0I300VA", 0.3937, False, True, 7.62, 4)
+diode.addVariant("do204_0I200VA", False, True, 5.08)
+diode.addVariant("do204_0I300VA", False, True, 7.62)
+diode.buildVariants(0.3937, 4, opath)
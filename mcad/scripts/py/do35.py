@@ -38,27 +38,32 @@ import kc3ddiode
 from kc3d import *
 from kc3ddiode import *
 
+opath = OutPath(sys.argv[1] if len(sys.argv) > 1 else "{name}.wrl")
+
 diode = do35()
 diode.setNVertices(16, 48, 5)
 diode.setColors( os.path.join(matpath,"tin.mat"), os.path.join(matpath,"glass_clr.mat"), \
                 os.path.join(matpath,"glass_blk.mat"), os.path.join(matpath,"copper.mat") )
 
 # horizontal orientation (pin 1 is always the cathode)
-diode.build("do35_0I300H", 0.3937, True, False, 7.62, 4)
-diode.build("do35_0I400H", 0.3937, True, False, 10.16, 4)
-diode.build("do35_0I500H", 0.3937, True, False, 12.7, 4)
-diode.build("do35_0I600H", 0.3937, True, False, 15.24, 4)
-diode.build("do35_0I700H", 0.3937, True, False, 17.78, 4)
-diode.build("do35_0I800H", 0.3937, True, False, 20.32, 4)
-diode.build("do35_0I900H", 0.3937, True, False, 22.86, 4)
-diode.build("do35_1I000H", 0.3937, True, False, 25.4, 4)
+diode.addVariant("do35_0I300H", True, False, 7.62)
+diode.addVariant("do35_0I400H", True, False, 10.16)
+diode.addVariant("do35_0I500H", True, False, 12.7)
+diode.addVariant("do35_0I600H", True, False, 15.24)
+diode.addVariant("do35_0I700H", True, False, 17.78)
+diode.addVariant("do35_0I800H", True, False, 20.32)
+diode.addVariant("do35_0I900H", True, False, 22.86)
+diode.addVariant("do35_1I000H", True, False, 25.4)
+diode.buildVariants(0.3937, 4, opath)
+diode.clearVariants()
 
 diode.setNVertices(16, 48, 10)
 
 # vertical orientation, pin 1 is cathode, short lead on cathode
-diode.build("do35_0I100V", 0.3937, False, False, 2.54, 4)
-diode.build("do35_0I200V", 0.3937, False, False, 5.08, 4)
+diode.addVariant("do35_0I100V", False, False, 2.54)
+diode.addVariant("do35_0I200V", False, False, 5.08)
 
 # vertical orientation, pin 1 is cathode, short lead on anode
-diode.build("do35_0I100VA", 0.3937, False, True, 2.54, 4)
-diode.build("do35_0I200VA", 0.3937, False, True, 5.08, 4)
+diode.addVariant("do35_0I100VA", False, True, 2.54)
+diode.addVariant("do35_0I200VA", False, True, 5.08)
+diode.buildVariants(0.3937, 4, opath)
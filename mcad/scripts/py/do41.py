@@ -37,6 +37,8 @@ import kc3ddiode
 from kc3d import *
 from kc3ddiode import *
 
+opath = OutPath(sys.argv[1] if len(sys.argv) > 1 else "{name}.wrl")
+
 diode = GenDiode()
 diode.setNVertices(16, 48, 5)
 #DO41 has max material for dwire = 0.864, dbody = 2.72, lbody = 5.21
@@ -45,20 +47,23 @@ diode.setColors( os.path.join(matpath,"tin.mat"), os.path.join(matpath,"rcc_blk_
                 os.path.join(matpath,"rcc_wht_g.mat") )
 
 # horizontal orientation (pin 1 is always the cathode)
-diode.build("do41_0I400H", 0.3937, True, False, 10.16, 4)
-diode.build("do41_0I500H", 0.3937, True, False, 12.7, 4)
-diode.build("do41_0I600H", 0.3937, True, False, 15.24, 4)
-diode.build("do41_0I700H", 0.3937, True, False, 17.78, 4)
-diode.build("do41_0I800H", 0.3937, True, False, 20.32, 4)
-diode.build("do41_0I900H", 0.3937, True, False, 22.86, 4)
-diode.build("do41_1I000H", 0.3937, True, False, 25.4, 4)
+diode.addVariant("do41_0I400H", True, False, 10.16)
+diode.addVariant("do41_0I500H", True, False, 12.7)
+diode.addVariant("do41_0I600H", True, False, 15.24)
+diode.addVariant("do41_0I700H", True, False, 17.78)
+diode.addVariant("do41_0I800H", True, False, 20.32)
+diode.addVariant("do41_0I900H", True, False, 22.86)
+diode.addVariant("do41_1I000H", True, False, 25.4)
+diode.buildVariants(0.3937, 4, opath)
+diode.clearVariants()
 
 diode.setNVertices(16, 48, 10)
 
 # vertical orientation, pin 1 is cathode with short lead
-diode.build("do41_0I100V", 0.3937, False, False, 2.54, 4)
-diode.build("do41_0I200V", 0.3937, False, False, 5.08, 4)
+diode.addVariant("do41_0I100V", False, False, 2.54)
+diode.addVariant("do41_0I200V", False, False, 5.08)
 
 # vertical orientation, pin 1 is cathode, anode has short lead
-diode.build("do41_0I100VA", 0.3937, False, True, 2.54, 4)
-diode.build("do41_0I200VA", 0.3937, False, True, 5.08, 4)
+diode.addVariant("do41_0I100VA", False, True, 2.54)
+diode.addVariant("do41_0I200VA", False, True, 5.08)
+diode.buildVariants(0.3937, 4, opath)
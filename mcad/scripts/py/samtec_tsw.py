@@ -38,11 +38,14 @@ from kc3d import *
 import kc3dconn
 from kc3dconn import *
 
-out = ofstream()
 hdr = Genhdr()
 tx = Transform()
 tx.setScale(0.3937)
 
+# output path pattern, for example "tsw/{style}/{name}.wrl"; {style} is
+# the lead style and row option of the part, for example 05_S
+opath = OutPath(sys.argv[1] if len(sys.argv) > 1 else "{name}.wrl")
+
 #    int SetPins(bool squarebot, bool squaretop, bool male, double pbev, double fbev,
 #            double depth, double length, double pd0, double pdy, double pd1,
 #            double pd2, double pd3, double ftc, double taper, double ts, int sides, double funneldepth);
@@ -96,27 +99,19 @@ PARTEND  = "_05_G_S_XX"
 H0 = 3.30
 H1 = 8.51
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-05-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_05_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   06: 2.41    7.62
 # Samtec TSW-1xx-06-S-XX
@@ -125,27 +120,19 @@ PARTEND  = "_06_G_S_XX"
 H0 = 2.41
 H1 = 7.62
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-06-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_06_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   07: 2.54    10.92
 # Samtec TSW-1xx-07-S-XX
@@ -154,27 +141,19 @@ PARTEND  = "_07_G_S_XX"
 H0 = 2.54
 H1 = 10.92
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-07-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_07_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   08: 5.08    13.46
 # Samtec TSW-1xx-08-S-XX
@@ -183,27 +162,19 @@ PARTEND  = "_08_G_S_XX"
 H0 = 5.08
 H1 = 13.46
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-08-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_08_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   09: 10.16   18.54
 # Samtec TSW-1xx-09-S-XX
@@ -212,27 +183,19 @@ PARTEND  = "_09_G_S_XX"
 H0 = 10.16
 H1 = 18.54
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-09-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_09_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   10: 12.70   21.08
 # Samtec TSW-1xx-10-S-XX
@@ -241,27 +204,19 @@ PARTEND  = "_10_G_S_XX"
 H0 = 12.70
 H1 = 21.08
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-10-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_10_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   11: 15.24   23.62
 # Samtec TSW-1xx-11-S-XX
@@ -270,27 +225,19 @@ PARTEND  = "_11_G_S_XX"
 H0 = 15.24
 H1 = 23.62
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-11-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_11_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   12: 17.78   26.16
 # Samtec TSW-1xx-12-S-XX
@@ -299,27 +246,19 @@ PARTEND  = "_12_G_S_XX"
 H0 = 17.78
 H1 = 26.16
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-12-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_12_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   13: 22.86   31.24
 # Samtec TSW-1xx-13-S-XX
@@ -328,27 +267,19 @@ PARTEND  = "_13_G_S_XX"
 H0 = 22.86
 H1 = 31.24
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-13-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_13_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   14: 2.79    13.46
 # Samtec TSW-1xx-14-S-XX
@@ -357,27 +288,19 @@ PARTEND  = "_14_G_S_XX"
 H0 = 2.79
 H1 = 13.46
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-14-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_14_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   15: 2.79    18.54
 # Samtec TSW-1xx-15-S-XX
@@ -386,27 +309,19 @@ PARTEND  = "_15_G_S_XX"
 H0 = 2.79
 H1 = 18.54
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-15-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_15_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   16: 7.87    18.54
 # Samtec TSW-1xx-16-S-XX
@@ -415,27 +330,19 @@ PARTEND  = "_16_G_S_XX"
 H0 = 7.87
 H1 = 18.54
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-16-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_16_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   17: 2.79    21.08
 # Samtec TSW-1xx-17-S-XX
@@ -444,27 +351,19 @@ PARTEND  = "_17_G_S_XX"
 H0 = 2.79
 H1 = 21.08
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-17-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_17_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   18: 2.79    23.62
 # Samtec TSW-1xx-18-S-XX
@@ -473,27 +372,19 @@ PARTEND  = "_18_G_S_XX"
 H0 = 2.79
 H1 = 23.62
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-18-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_18_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   19: 2.79    26.16
 # Samtec TSW-1xx-19-S-XX
@@ -502,27 +393,19 @@ PARTEND  = "_19_G_S_XX"
 H0 = 2.79
 H1 = 26.16
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-19-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_19_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   20: 2.79    31.24
 # Samtec TSW-1xx-20-S-XX
@@ -531,27 +414,19 @@ PARTEND  = "_20_G_S_XX"
 H0 = 2.79
 H1 = 31.24
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-20-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_20_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   21: 2.79    36.32
 # Samtec TSW-1xx-21-S-XX
@@ -560,27 +435,19 @@ PARTEND  = "_21_G_S_XX"
 H0 = 2.79
 H1 = 36.32
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-21-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_21_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   22: 7.62    16.00
 # Samtec TSW-1xx-22-S-XX
@@ -589,27 +456,19 @@ PARTEND  = "_22_G_S_XX"
 H0 = 7.62
 H1 = 16.00
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-22-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_22_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   23: 2.92    11.30
 # Samtec TSW-1xx-23-S-XX
@@ -618,27 +477,19 @@ PARTEND  = "_23_G_S_XX"
 H0 = 2.92
 H1 = 11.30
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-23-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_23_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   24: 2.92    12.15
 # Samtec TSW-1xx-24-S-XX
@@ -647,27 +498,19 @@ PARTEND  = "_24_G_S_XX"
 H0 = 2.92
 H1 = 12.15
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-24-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_24_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   25: 5.33    16.00
 # Samtec TSW-1xx-25-S-XX
@@ -676,27 +519,19 @@ PARTEND  = "_25_G_S_XX"
 H0 = 5.33
 H1 = 16.00
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-25-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_25_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   27: 25.4    33.78
 # Samtec TSW-1xx-27-S-XX
@@ -705,27 +540,19 @@ PARTEND  = "_27_G_S_XX"
 H0 = 25.4
 H1 = 33.78
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-27-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_27_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   28: 20.32   28.70
 # Samtec TSW-1xx-28-S-XX
@@ -734,27 +561,19 @@ PARTEND  = "_28_G_S_XX"
 H0 = 20.32
 H1 = 28.70
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-28-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_28_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   29: 23.11   33.78
 # Samtec TSW-1xx-29-S-XX
@@ -763,27 +582,19 @@ PARTEND  = "_29_G_S_XX"
 H0 = 23.11
 H1 = 33.78
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-29-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_29_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 #   30: 18.03   28.70
 # Samtec TSW-1xx-30-S-XX
@@ -792,24 +603,16 @@ PARTEND  = "_30_G_S_XX"
 H0 = 18.03
 H1 = 28.70
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 1, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
 
 # Samtec TSW-1xx-30-D-XX
 PARTBASE = "samtec_TSW_1"
 PARTEND  = "_30_G_D_XX"
 
-for idx in range (MINPIN, MAXPIN):
-    PARTNAME = PARTBASE + str(idx).zfill(2) + PARTEND
-    FILENAME = PARTNAME + ".wrl"
-    SetupVRML(FILENAME, out)
-    hdr.setCase(idx, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
-    hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
-    hdr.build(tx, PARTNAME, out, 0)
-    out.close()
+opath.setField("style", PARTEND[1:3] + "_" + PARTEND[6])
+hdr.setCase(MINPIN, 2, 2.54, 2.54, 2.54, 0.4, True, 0.5)
+hdr.setPins(True, True, True, -1, -1, H0, H1, 0.64, 0.64, 0, 0, 0, 0, 0.3, 0.4, 4, 0)
+hdr.createFamily(tx, MINPIN, MAXPIN - 1, PARTBASE, PARTEND, opath)
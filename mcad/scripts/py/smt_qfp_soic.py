@@ -53,6 +53,12 @@
 #   format. Default parameter values can be specified in a [DEFAULT]
 #   section.
 #
+#   Usage: smt_qfp_soic.py [-n pathPattern] paramFile [paramFile ...]
+#
+#   The path pattern may contain the fields {name}, {series} and
+#   {family}; {family} is the lower case package family such as
+#   lqfp, soic or qfn, for example: mcad/vrml/smt/{family}/{name}.wrl
+#
 
 #
 # Example file:
@@ -124,6 +130,22 @@ def sanitize( aString ):
 
     return aString
 
+# package family of a part used as the {family} output path field;
+# for example SOIJ-8 is in the soic family and UQFN-16 is in qfn
+def family( aName ):
+    pfx = aName.split( "-" )[0].lower()
+
+    if pfx.startswith( "soi" ):
+        return "soic"
+
+    if pfx.endswith( "dfn" ):
+        return "dfn"
+
+    if pfx.endswith( "qfn" ):
+        return "qfn"
+
+    return pfx
+
 # define the pin geometry for QFN
 def PinQFN( length, width ):
     tx = Transform()
@@ -555,14 +577,13 @@ def MakeQFP( out, body_size_x, body_size_y, body_size_z, body_standoff,
         pcount += 1
 
 
-def process( params ):
+def process( params, opath ):
     cp = ConfigParser.ConfigParser()
     cp.read( params )
     out = ofstream()
 
     for X in cp.sections():
         print "Processing section: '%s'" % X
-        fname = X + ".wrl"
         pkgtype = cp.get( X, "pkgtype" )
         scale = float( cp.get( X, "scale" ) )
         npcolor = cp.get( X, "pin_color" )
@@ -599,7 +620,8 @@ def process( params ):
         # decide which model to invoke
         if ( pkgtype.lower() == "qfp" or pkgtype.lower() == "soic" or
             pkgtype.lower() == "tssop" ):
-            SetupVRML( fname, out )
+            opath.setField( "family", family( X ) )
+            opath.open( X, out )
             SetupXForm( sanitize( X ), out, 0 )
 
             MakeQFP( out, bs_x, bs_y, bs_z, bstand,
@@ -611,7 +633,8 @@ def process( params ):
             CloseXForm( out, 0 )
             out.close()
         elif pkgtype.lower() == "qfn" :
-            SetupVRML( fname, out )
+            opath.setField( "family", family( X ) )
+            opath.open( X, out )
             SetupXForm( sanitize( X ), out, 0 )
 
             MakeQFN( out, bs_x, bs_y, bs_z, bstand,
@@ -632,12 +655,21 @@ def process( params ):
 ##
 ##
 
-if len( sys.argv ) == 1:
+ARGS = sys.argv[1:]
+opath = OutPath( "{name}.wrl" )
+
+if len( ARGS ) > 1 and ARGS[0] == "-n" :
+    if opath.setPattern( ARGS[1] ) != 0 :
+        exit( 1 )
+
+    ARGS = ARGS[2:]
+
+if len( ARGS ) == 0:
     print "No parameter files specified"
     exit()
 
-for PARAMS in sys.argv[1:] :
+for PARAMS in ARGS :
     print "Processing file: %s" % PARAMS
-    process( PARAMS )
+    process( PARAMS, opath )
 
 exit()
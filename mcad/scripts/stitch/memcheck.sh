@@ -0,0 +1,114 @@
+#!/bin/sh
+# Check that vrmlstitch assembles large boards in bounded memory.
+#
+# usage: memcheck.sh [path to vrmlstitch]
+#
+# A set of synthetic part models and an assembly of NPARTS (default
+# 10000) placements of those parts are generated in a temporary
+# directory. The assembly is stitched with 1 and with JOBS (default 4)
+# threads under a virtual memory limit of VMEM_KB (default 400000) KB
+# and the peak RSS reported by 'vrmlstitch -v' is checked:
+#
+# + the peak RSS must not exceed MAX_RSS_KB (default 65536) KB
+# + the peak RSS must not grow by more than GROW_KB (default 8192) KB
+#   from an assembly of NPARTS/10 placements to one of NPARTS
+#
+# The exit code is 0 if all checks pass.
+
+STITCH="${1:-vrmlstitch}"
+NPARTS="${NPARTS:-10000}"
+NMODELS="${NMODELS:-32}"
+JOBS="${JOBS:-4}"
+VMEM_KB="${VMEM_KB:-400000}"
+MAX_RSS_KB="${MAX_RSS_KB:-65536}"
+GROW_KB="${GROW_KB:-8192}"
+
+WORK="$(mktemp -d)" || exit 1
+trap 'rm -rf "${WORK}"' EXIT
+
+# write part model #$1: a plate with a grid of (8 + $1) x 8 vertices
+mkpart()
+{
+    awk -v n="$1" 'BEGIN {
+        nx = 8 + n; ny = 8;
+        printf( "#VRML V2.0 utf8\n\nDEF part%d Transform {\n    children [\n", n );
+        printf( "        Shape {\n            appearance Appearance {\n" );
+        printf( "                material DEF mat%d Material {\n", n % 4 );
+        printf( "                    diffuseColor 0.%d 0.5 0.5\n", n % 4 );
+        printf( "                }\n            }\n" );
+        printf( "            geometry IndexedFaceSet {\n            coord Coordinate { point [\n" );
+        for( j = 0; j < ny; ++j )
+        {
+            for( i = 0; i < nx; ++i )
+                printf( "                %g %g %g%s\n", i * 0.1, j * 0.1, ( i + j ) % 3 * 0.05,
+                    ( i == nx - 1 && j == ny - 1 ) ? " ]" : "," );
+        }
+        printf( "            }\n            coordIndex [\n" );
+        for( j = 0; j < ny - 1; ++j )
+        {
+            for( i = 0; i < nx - 1; ++i )
+            {
+                k = j * nx + i;
+                printf( "                %d,%d,%d,%d,-1\n", k, k + 1, k + nx + 1, k + nx );
+            }
+        }
+        printf( "            ]\n            }\n        }\n    ]\n}\n" );
+    }' > "${WORK}/part$1.wrl"
+}
+
+# write an assembly input $1 with $2 placements on a 100-column grid
+mkinput()
+{
+    awk -v name="$1" -v np="$2" -v nm="${NMODELS}" -v dir="${WORK}" 'BEGIN {
+        printf( "file: %s\n\n", name );
+        for( i = 0; i < np; ++i )
+        {
+            printf( ".begin\nname: %s/part%d.wrl\n", dir, i % nm );
+            printf( "r: 0.5 0 0 1\nt: %d %d 0\n.end\n\n", ( i % 100 ) * 3, int( i / 100 ) * 3 );
+        }
+    }' > "${WORK}/$1.in"
+}
+
+# stitch input $1 with the extra arguments $2 and print the peak RSS in KB
+peakrss()
+{
+    ( cd "${WORK}" && ulimit -v "${VMEM_KB}" && "${STITCH}" $2 -m 16 -v "$1.in" ) 2>&1 \
+        | sed -n 's/.*peak RSS: \([0-9]*\) KB.*/\1/p'
+    rm -f "${WORK}/$1.wrl"
+}
+
+i=0
+while [ $i -lt "${NMODELS}" ]; do
+    mkpart $i
+    i=$((i + 1))
+done
+
+mkinput small $((NPARTS / 10))
+mkinput large "${NPARTS}"
+
+FAIL=0
+
+for ARGS in "" "-j ${JOBS}"; do
+    RSS0="$(peakrss small "${ARGS}")"
+    RSS1="$(peakrss large "${ARGS}")"
+
+    if [ -z "${RSS0}" ] || [ -z "${RSS1}" ]; then
+        echo "vrmlstitch ${ARGS}: failed (no peak RSS reported)"
+        FAIL=1
+        continue
+    fi
+
+    echo "vrmlstitch ${ARGS}: peak RSS $((NPARTS / 10)) parts: ${RSS0} KB, ${NPARTS} parts: ${RSS1} KB"
+
+    if [ "${RSS1}" -gt "${MAX_RSS_KB}" ]; then
+        echo "    peak RSS exceeds ${MAX_RSS_KB} KB"
+        FAIL=1
+    fi
+
+    if [ "${RSS1}" -gt $((RSS0 + GROW_KB)) ]; then
+        echo "    peak RSS grows by more than ${GROW_KB} KB with the number of parts"
+        FAIL=1
+    fi
+done
+
+exit ${FAIL}
@@ -26,7 +26,7 @@
 using namespace std;
 using namespace KC3D;
 
-int VRMLMAT::WriteMaterial( std::ofstream& aVRMLFile, int aTabDepth )
+int VRMLMAT::WriteMaterial( std::ostream& aVRMLFile, int aTabDepth )
 {
     if( aTabDepth < 0 )
         aTabDepth = 0;
@@ -37,6 +37,8 @@
 #include <wire.h>
 #include <kc3dtess.h>
 #include <dimple.h>
+#include <outpath.h>
+#include <pinmask.h>
 
 using namespace boost::python;
 using namespace KC3D;
@@ -58,7 +60,12 @@ bool (std::ofstream::* ofs_isopen)() = &std::ofstream::is_open;
 
 
 BOOST_PYTHON_MODULE( kc3d ) {
-    object class_ofstream = class_<std::ofstream, boost::noncopyable>( "ofstream" )
+    // the VRML writers take a std::ostream; an ofstream must be
+    // registered as derived from it to be accepted by them
+    class_<std::ostream, boost::noncopyable>( "ostream", no_init );
+
+    object class_ofstream = class_<std::ofstream, bases<std::ostream>,
+                                   boost::noncopyable>( "ofstream" )
                             .def( "open", &std::ofstream::open, ofs_open_var() )
                             .def( "close", &std::ofstream::close )
                             .def( "good", &std::ofstream::good )
@@ -82,4 +89,6 @@ BOOST_PYTHON_MODULE( kc3d ) {
 #include <wire.pyinc>
 #include <kc3dtess.pyinc>
 #include <dimple.pyinc>
+#include <outpath.pyinc>
+#include <pinmask.pyinc>
 }
@@ -21,6 +21,7 @@
 #include <boost/python.hpp>
 
 #include <genhdr.h>
+#include <outpath.h>
 
 using namespace boost::python;
 
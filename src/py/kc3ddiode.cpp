@@ -23,6 +23,7 @@
 
 #include <do35.h>
 #include <gendiode.h>
+#include <outpath.h>
 
 using namespace boost::python;
 
@@ -22,9 +22,11 @@
 #include <iostream>
 
 #include <dip.h>
+#include <outpath.h>
 
 using namespace boost::python;
 
+#include <dil.pydef>
 
 BOOST_PYTHON_MODULE( kc3ddip ) {
 #include <dil.pyinc>
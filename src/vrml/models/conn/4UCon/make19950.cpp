@@ -73,7 +73,18 @@ void printUsage( void )
     return;
 }
 
-int makeHdr( int np, const std::string &kc3ddir );
+// parts which do not depend on the length of the header; these are
+// calculated once and shared by all models
+static PIN      pin;
+static FUNNEL   fun;
+static HOLE     bh[3];          // bottom holes, leftmost, mid, rightmost
+static HOLE     th[3];          // top holes, leftmost, mid, rightmost
+static int      holeType = 0;   // pins (1, 2 or 3 for >= 3) of the current holes
+static VRMLMAT  pcol, bcol;     // pin and body color
+
+int calcParts( const std::string &kc3ddir );
+int calcHoles( int np );
+int makeHdr( int np );
 
 int main( int argc, char** argv )
 {
@@ -128,9 +139,12 @@ int main( int argc, char** argv )
         kc3ddir = evp;
     }
 
+    if( calcParts( kc3ddir ) )
+        return -1;
+
     for( i = 3; i <= 40; ++i )
     {
-        if( makeHdr( i, kc3ddir ) )
+        if( makeHdr( i ) )
         {
             cerr << "* errors creating " << i << "-pin part; terminating program\n";
             return -1;
@@ -141,11 +155,10 @@ int main( int argc, char** argv )
 }
 
 
-int makeHdr( int np, const std::string &kc3ddir )
+int calcParts( const std::string &kc3ddir )
 {
     TRANSFORM   t0;
     PPARAMS     pinarg;
-    PIN pin;
 
     string colorGold;
     string colorBlack;
@@ -159,20 +172,6 @@ int makeHdr( int np, const std::string &kc3ddir )
         colorBlack = TO_UTF8( cb.GetFullPath() );
     } while(0);
 
-    if( np < 1 )
-    {
-        ERRBLURB;
-        cerr << "invalid number of pins (< 1)\n";
-        return -1;
-    }
-
-    if( np > 100 )
-    {
-        ERRBLURB;
-        cerr << "invalid number of pins (> 100)\n";
-        return -1;
-    }
-
     pinarg.w    = 0.64;
     pinarg.d    = 0.4;
     pinarg.h    = 0.8 + 10.5;           // shoulder height + pin length
@@ -181,24 +180,42 @@ int makeHdr( int np, const std::string &kc3ddir )
     pinarg.std  = 1.0;                  // no taper on d dimension
     pinarg.dbltap = false;
     t0.SetTranslation( 0, 0, -10.5 );   // shift the pin to the correct vertical location
-    pin.Calc( pinarg, t0 );
-
-    // length
-    double l = 2.54 * np + 0.25;
 
-    SHOULDER bump;
-    t0.SetTranslation( 0.0, 0.0, 0.0 );    // center along X
-    bump.Calc( l, 0.8, 0.75, 0.0, 0.3, t0 );
+    int acc = 0;
+    acc += pin.Calc( pinarg, t0 );
 
-    FUNNEL fun;
     t0.SetTranslation( 0.0, 0.0, 8.5 );    // shift up to vertical location
-    fun.Calc( 1.8, 1.8, 0.9, 0.9, 0.5, 0.5, 4, t0 );
+    acc += fun.Calc( 1.8, 1.8, 0.9, 0.9, 0.5, 0.5, 4, t0 );
+
+    acc += pcol.Load( colorGold );
+    acc += bcol.Load( colorBlack );
+
+    if( acc )
+    {
+        ERRBLURB;
+        cerr << "problems calculating the pin and funnel or loading the colors\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// the end holes are offset so that the casing extends past the
+// last pin; only headers with 1 and 2 pins differ
+int calcHoles( int np )
+{
+    int type = np < 3 ? np : 3;
+
+    if( type == holeType )
+        return 0;
+
+    TRANSFORM t0;
 
     // bottom holes, leftmost, mid, rightmost
-    HOLE bh[3];
     t0.SetTranslation( 0.0, 0.0, 0.8 );    // shift up to vertical location
 
-    switch( np )
+    switch( type )
     {
     case 1:
         bh[0].Calc( 2.79, 1.0, 0.64, 0.4, t0, true, 0, 0 );
@@ -217,10 +234,9 @@ int makeHdr( int np, const std::string &kc3ddir )
     }
 
     // top holes, leftmost, mid, rightmost
-    HOLE th[3];
     t0.SetTranslation( 0.0, 0.0, 8.5 );    // shift up to vertical location
 
-    switch( np )
+    switch( type )
     {
     case 1:
         th[0].Calc( 2.79, 2.5, 1.8, 1.8, t0, true, 0, 0 );
@@ -238,6 +254,39 @@ int makeHdr( int np, const std::string &kc3ddir )
         break;
     }
 
+    holeType = type;
+    return 0;
+}
+
+
+int makeHdr( int np )
+{
+    TRANSFORM   t0;
+
+    if( np < 1 )
+    {
+        ERRBLURB;
+        cerr << "invalid number of pins (< 1)\n";
+        return -1;
+    }
+
+    if( np > 100 )
+    {
+        ERRBLURB;
+        cerr << "invalid number of pins (> 100)\n";
+        return -1;
+    }
+
+    if( calcHoles( np ) )
+        return -1;
+
+    // length
+    double l = 2.54 * np + 0.25;
+
+    SHOULDER bump;
+    t0.SetTranslation( 0.0, 0.0, 0.0 );    // center along X
+    bump.Calc( l, 0.8, 0.75, 0.0, 0.3, t0 );
+
     RECTANGLE blk[2];    // casing
     t0.SetTranslation( 0.0, 0.0, 0.8 );
     blk[0].Calc( l, 2.5, t0 );
@@ -250,10 +299,6 @@ int makeHdr( int np, const std::string &kc3ddir )
     t0.SetTranslation( 0.0, 0.0, 8.4 );
     shd[1].Calc( l - 0.3, 2.2, t0 );
 
-    VRMLMAT pcol, bcol;    // pin and body color
-    pcol.Load( colorGold );
-    bcol.Load( colorBlack );
-
     ofstream output;
     ostringstream fname, bname;
     bname << "X4UCON_19950_" << np;
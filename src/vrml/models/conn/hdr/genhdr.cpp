@@ -19,6 +19,8 @@
  */
 
 #include <iostream>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <fstream>
 
@@ -30,6 +32,7 @@
 #include <circle.h>
 #include <funnel.h>
 #include <pin.h>
+#include <outpath.h>
 #include <genhdr.h>
 
 using namespace std;
@@ -42,6 +45,8 @@ GENHDR::GENHDR()
     hasColors = false;
     hasBparams  = false;
     hasPparams  = false;
+    hasGeometry = false;
+    nhidden = 0;
 
     cols = 1;
     rows = 1;
@@ -104,6 +109,9 @@ int GENHDR::Build( KC3D::TRANSFORM& aTransform, std::string aPartName,
         return -1;
     }
 
+    if( !hasGeometry && calcGeometry() )
+        return -1;
+
     int val = 0;
     val += SetupXForm( aPartName, aVRMLFile, aTabDepth );
 
@@ -158,6 +166,63 @@ int GENHDR::Build( KC3D::TRANSFORM& aTransform, std::string aPartName,
 }
 
 
+int GENHDR::BuildFamily( KC3D::TRANSFORM& aTransform, int aMinCols, int aMaxCols,
+                         const std::string& aPrefix, const std::string& aSuffix,
+                         KC3D::OUTPATH& aOutPath )
+{
+    if( (aMinCols < 1) || (aMaxCols < aMinCols) )
+    {
+        ERRBLURB;
+        cerr << "invalid column range (" << aMinCols << " .. " << aMaxCols;
+        cerr << "); the minimum must be >= 1\n";
+        return -1;
+    }
+
+    ostringstream name;
+    ostringstream ncols;
+    ofstream fp;
+    int ocols = cols;   // restored on return
+
+    nhidden = 0;
+
+    for( int i = aMinCols; i <= aMaxCols; ++i )
+    {
+        // only the case outline depends on the number of columns
+        cols = i;
+
+        name.str( "" );
+        name << aPrefix << setfill( '0' ) << setw( 2 ) << i << aSuffix;
+        ncols.str( "" );
+        ncols << i;
+        aOutPath.SetField( "cols", ncols.str() );
+
+        if( aOutPath.Open( name.str(), fp ) )
+        {
+            ERRBLURB;
+            cerr << "could not open the file for model '" << name.str() << "'\n";
+            cols = ocols;
+            return -1;
+        }
+
+        int val = Build( aTransform, name.str(), fp );
+        fp.close();
+
+        if( val )
+        {
+            ERRBLURB;
+            cerr << "could not create model '" << name.str() << "'\n";
+            cols = ocols;
+            return -1;
+        }
+
+        nhidden += hbase.GetHiddenFaces();
+    }
+
+    cols = ocols;
+    return 0;
+}
+
+
 int GENHDR::SetColors( std::string aBodyMatFileName, std::string aPinMatFileName,
                        std::string aFunnelMatFileName, std::string aShroudMatFileName )
 {
@@ -185,6 +250,7 @@ int GENHDR::SetCase( int nCols, int nRows, double aColPitch, double aRowPitch,
                      double aHeight, double aShoulder, bool hasShoulder, double aBevel )
 {
     hasBparams = false;
+    hasGeometry = false;
 
     if( nCols < 1 )
     {
@@ -263,6 +329,7 @@ int GENHDR::SetPins( bool isBotSquare, bool isTopSquare, bool isMale, double aPi
                      double aSocketDepth )
 {
     hasPparams = false;
+    hasGeometry = false;
 
     male = isMale;
 
@@ -416,12 +483,11 @@ int GENHDR::SetPins( bool isBotSquare, bool isTopSquare, bool isMale, double aPi
 }
 
 
-// render the case
-int GENHDR::makeCase( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+// calculate the case, pins, shrouds and funnels; none of these
+// depend on the number of columns
+int GENHDR::calcGeometry( void )
 {
     int val = 0;
-    HDRBASE hbase;
-
     double ch = bh;
 
     if( (!male) && (fd < 0.0) )
@@ -445,6 +511,26 @@ int GENHDR::makeCase( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         return -1;
     }
 
+    if( calcPins() )
+        return -1;
+
+    if( (!male) && (!squaretop) && calcShrouds() )
+        return -1;
+
+    if( (!male) && calcFunnels() )
+        return -1;
+
+    hasGeometry = true;
+    return 0;
+}
+
+
+// render the case
+int GENHDR::makeCase( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+{
+    int val = 0;
+
+    val += hbase.SetColumns( cols );
     val += hbase.Build( t, bcolor, false, fp, tabs );
 
     if( val )
@@ -454,13 +540,12 @@ int GENHDR::makeCase( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
 }
 
 
-// render the pins
-int GENHDR::makePins( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+// calculate the pins at the origin
+int GENHDR::calcPins( void )
 {
     int val = 0;
 
     TRANSFORM t0, t1;
-    PIN pin[2];
 
     pin[0].SetShape( squarebot );
     pin[1].SetShape( squarebot );
@@ -552,6 +637,34 @@ int GENHDR::makePins( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         p1.stw  = tps;
     }
 
+    // all pins are identical so they are calculated once and
+    // translated to each position
+    t0.SetTranslation( 0, 0, -pd );
+    val += pin[0].Calc( p0, t0 );
+
+    if( (!male) && (!squarebot) )
+    {
+        t1.SetTranslation( 0, 0, tpo );
+        val += pin[1].Calc( p1, t1 );
+    }
+
+    if( val )
+    {
+        ERRBLURB;
+        cerr << "problems calculating the pins\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// render the pins
+int GENHDR::makePins( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+{
+    int val = 0;
+    PIN ppin[2];    // positioned copies
+
     int i, j;
     double ox, oy, oxb, oyb;    // offset information
     ox  = (1 - cols) * xp / 2.0;
@@ -566,21 +679,19 @@ int GENHDR::makePins( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         for( j = 0; j < cols; ++j )
         {
             oxb = ox + j * xp;
-            t0.SetTranslation( oxb, oyb, -pd );
-            val += pin[0].Calc( p0, t0 );
+            val += ppin[0].Translate( pin[0], oxb, oyb, 0 );
 
             if( male )
-                val += pin[0].Build( true, true, t, pcolor, reuse_pc, fp, tabs );
+                val += ppin[0].Build( true, true, t, pcolor, reuse_pc, fp, tabs );
             else
-                val += pin[0].Build( true, false, t, pcolor, reuse_pc, fp, tabs );
+                val += ppin[0].Build( true, false, t, pcolor, reuse_pc, fp, tabs );
 
             reuse_pc = true;
 
             if( (!male) && (!squarebot) )
             {
-                t1.SetTranslation( oxb, oyb, tpo );
-                val += pin[1].Calc( p1, t1 );
-                val += pin[1].Build( false, false, t, pcolor, true, fp, tabs );
+                val += ppin[1].Translate( pin[1], oxb, oyb, 0 );
+                val += ppin[1].Build( false, false, t, pcolor, true, fp, tabs );
             }
         }
     }
@@ -596,8 +707,8 @@ int GENHDR::makePins( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
 }
 
 
-// render shrouds for circular pins in female headers
-int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+// calculate the shroud circles at the origin
+int GENHDR::calcShrouds( void )
 {
     // relevant parameters:
     // pd1;     // pin diameter 1 (Female, pin dia. within header)
@@ -610,33 +721,51 @@ int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
     // circle[1] : depressed circle surrounding funnel
     // circle[2] : inner circle 1, planar with circle[1]
     // circle[3] : inner circle 2, planar with circle[1]
-    CIRCLE circ[4];
-
     TRANSFORM t0, t1;
 
-    int i, j;
     int val = 0;
     double td1  = pd2 * ftc;
     double td0  = td1 + (pd1 - td1) * 0.4;
+    double ch = bh; // case height
+
+    if( (!male) && (fd < -1e-9) )
+        ch = bh + fd;
+
+    for( int i = 0; i < 4; ++i )
+        circ[i].SetNVertices( ns );
+
+    t0.SetTranslation( 0, 0, ch );
+    t1.SetTranslation( 0, 0, ch - fd );
+    val += circ[0].Calc( pd1, pd1, t0 );
+    val += circ[1].Calc( pd1, pd1, t1 );
+    val += circ[2].Calc( td0, td0, t1 );
+    val += circ[3].Calc( td1, td1, t1 );
+
+    if( val )
+    {
+        ERRBLURB;
+        cerr << "problems calculating the shrouds\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// render shrouds for circular pins in female headers
+int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+{
+    int i, j;
+    int val = 0;
     double ox, oy, oxb, oyb;
 
     ox  = (1 - cols) * xp / 2.0;
     oy  = (1 - rows) * yp / 2.0;
 
-    double ch = bh; // case height
     bool raised = false;
 
-    if( !male )
-    {
-        if( fd < -1e-9 )
-        {
-            raised = true;
-            ch = bh + fd;
-        }
-
-        if( fd > 1e-9 )
-            raised = true;
-    }
+    if( (!male) && ( (fd < -1e-9) || (fd > 1e-9) ) )
+        raised = true;
 
     bool reuse = false;
 
@@ -646,8 +775,10 @@ int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
     if( !pcolor.GetName().compare( scolor.GetName() ) )
         reuse = true;
 
-    for( i = 0; i < 4; ++i )
-        circ[i].SetNVertices( ns );
+    CIRCLE pc0( circ[0] );
+    CIRCLE pc1( circ[1] );
+    CIRCLE pc2( circ[2] );
+    CIRCLE pc3( circ[3] );
 
     for( i = 0; i < rows; ++i )
     {
@@ -656,18 +787,18 @@ int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         for( j = 0; j < cols; ++j )
         {
             oxb = ox + j * xp;
-            t0.SetTranslation( oxb, oyb, ch );
-            t1.SetTranslation( oxb, oyb, ch - fd );
-            circ[0].Calc( pd1, pd1, t0 );
-            circ[1].Calc( pd1, pd1, t1 );
-            circ[2].Calc( td0, td0, t1 );
-            circ[3].Calc( td1, td1, t1 );
+            val += pc1.Translate( circ[1], oxb, oyb, 0 );
+            val += pc2.Translate( circ[2], oxb, oyb, 0 );
+            val += pc3.Translate( circ[3], oxb, oyb, 0 );
 
             if( raised )
-                val += circ[0].Stitch( true, circ[1], t, scolor, reuse, fp, tabs );
+            {
+                val += pc0.Translate( circ[0], oxb, oyb, 0 );
+                val += pc0.Stitch( true, pc1, t, scolor, reuse, fp, tabs );
+            }
 
-            val += circ[1].Stitch( true, circ[2], t, scolor, true, fp, tabs );
-            val += circ[2].Stitch( true, circ[3], t, pcolor, true, fp, tabs );
+            val += pc1.Stitch( true, pc2, t, scolor, true, fp, tabs );
+            val += pc2.Stitch( true, pc3, t, pcolor, true, fp, tabs );
         }
     }
 
@@ -682,8 +813,8 @@ int GENHDR::makeShrouds( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
 }
 
 
-// render funnels for female headers
-int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+// calculate the funnel at the origin
+int GENHDR::calcFunnels( void )
 {
     // relevant parameters:
     // pd1;     // pin diameter 1 (Female, pin dia. within header)
@@ -692,13 +823,10 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
     // fd;      // funnel depth (for female headers)
     // bh;      // case height
 
-    FUNNEL fun;    // circular or square funnel
-    int val = 0;
     // set the parameters based on square/circle and funnel depth
     double fdia;            // funnel diameter
     double fh0, fh1, fh2;   // funnel flute and stem heights
     double fz;              // z offset for funnels
-    VRMLMAT* f0col, * f1col;
 
     double tvar = bh;    // room for the funnel
 
@@ -721,9 +849,6 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         }
     }
 
-    bool reuse_f0col    = false;
-    bool reuse_f1col    = false;
-
     if( squaretop )
     {
         fun.SetShape( true, fbev );
@@ -738,8 +863,6 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
             fh1 = tvar / 3.0;
 
         fh2 = tvar - fh1;
-        f0col = &bcolor;
-        f1col = &fcolor;
     }
     else
     {
@@ -764,10 +887,39 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
 
         fh1 = 0.0;
         fh2 = tvar - fh0;
-        f0col = &fcolor;
-        f1col = &fcolor;
     }
 
+    TRANSFORM t0;
+    t0.SetTranslation( 0, 0, fz );
+
+    if( fun.Calc( fdia, fdia, pd2, pd2, fh0, fh1, fh2, t0, ns ) )
+    {
+        ERRBLURB;
+        cerr << "problems calculating the funnel\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// render funnels for female headers
+int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
+{
+    FUNNEL pfun;    // positioned copy
+    int val = 0;
+    VRMLMAT* f0col, * f1col;
+
+    bool reuse_f0col    = false;
+    bool reuse_f1col    = false;
+
+    if( squaretop )
+        f0col = &bcolor;
+    else
+        f0col = &fcolor;
+
+    f1col = &fcolor;
+
     // conditions under which we reuse the colors
     if( !f0col->GetName().compare( bcolor.GetName() ) )
         reuse_f0col = true;
@@ -787,7 +939,6 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
     if( ( !f1col->GetName().compare( scolor.GetName() ) ) && (!male) && (!squaretop) )
         reuse_f1col = true;
 
-    TRANSFORM t0;
     int i, j;
     double ox, oy, oxb, oyb;    // offset information
     ox  = (1 - cols) * xp / 2.0;
@@ -800,9 +951,8 @@ int GENHDR::makeFunnels( KC3D::TRANSFORM& t, std::ofstream& fp, int tabs )
         for( j = 0; j < cols; ++j )
         {
             oxb = ox + j * xp;
-            t0.SetTranslation( oxb, oyb, fz );
-            val += fun.Calc( fdia, fdia, pd2, pd2, fh0, fh1, fh2, t0, ns );
-            val += fun.Build( true, t, *f0col, reuse_f0col, *f1col, reuse_f1col, fp, tabs );
+            val += pfun.Translate( fun, oxb, oyb, 0 );
+            val += pfun.Build( true, t, *f0col, reuse_f0col, *f1col, reuse_f1col, fp, tabs );
             reuse_f0col = true;
             reuse_f1col = true;
         }
@@ -0,0 +1,122 @@
+/*
+ *  file: diodebase.cpp
+ *
+ *  Copyright 2012-2014 Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include <vdefs.h>
+#include <diodebase.h>
+#include <outpath.h>
+
+using namespace std;
+using namespace KC3D;
+using namespace KC3DDIODE;
+
+DIODEBASE::DIODEBASE()
+{
+}
+
+
+DIODEBASE::~DIODEBASE()
+{
+}
+
+
+void DIODEBASE::AddVariant( const std::string& aPartname, bool isHoriz,
+                            bool isVKFlipped, double aPitch )
+{
+    VARIANT v;
+    v.name   = aPartname;
+    v.pitch  = aPitch;
+    v.horiz  = isHoriz;
+    v.vkflip = isVKFlipped;
+    variants.push_back( v );
+    return;
+}
+
+
+void DIODEBASE::ClearVariants( void )
+{
+    variants.clear();
+    return;
+}
+
+
+int DIODEBASE::BuildVariants( double aScale, double aLeadDepth, KC3D::OUTPATH& aOutPath )
+{
+    if( variants.empty() )
+    {
+        ERRBLURB;
+        cerr << "invoked without prior call to AddVariant()\n";
+        return -1;
+    }
+
+    size_t i;
+
+    // check every variant before any file is written
+    for( i = 0; i < variants.size(); ++i )
+    {
+        if( checkBuild( variants[i].horiz, variants[i].vkflip,
+                        variants[i].pitch, aLeadDepth ) )
+        {
+            cerr << "* invalid variant '" << variants[i].name << "'\n";
+            return -1;
+        }
+    }
+
+    // each body set is only calculated when first used
+    bool hasbody[3] = { false, false, false };
+    int acc = 0;
+
+    for( i = 0; i < variants.size(); ++i )
+    {
+        const VARIANT& v = variants[i];
+        int bi = v.horiz ? 0 : ( v.vkflip ? 2 : 1 );
+
+        if( !hasbody[bi] )
+        {
+            calcVariantBody( bi, v.horiz, v.vkflip );
+            hasbody[bi] = true;
+        }
+
+        ofstream fp;
+        aOutPath.SetField( "orient", v.horiz ? "horiz" : "vert" );
+
+        if( aOutPath.Open( v.name, fp ) )
+        {
+            ERRBLURB;
+            cerr << "could not open output file for part '" << v.name << "'\n";
+            return -1;
+        }
+
+        acc = writeVariant( fp, v, bi, aScale, aLeadDepth );
+        fp.close();
+
+        if( acc )
+        {
+            ERRBLURB;
+            cerr << "problems writing diode data to file for part '" << v.name << "'\n";
+            return -1;
+        }
+    }
+
+    return 0;
+}
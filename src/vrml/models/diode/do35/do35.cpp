@@ -87,10 +87,10 @@ int DO35::SetColors( const std::string& aWireMatFname,
 {
     int acc = 0;
 
-    acc += wcol.Load( aWireMatFname );
-    acc += gcol.Load( aGlassMatFname );
-    acc += kcol.Load( aCathodeMatFname );
-    acc += tcol.Load( aInnerTubeMatFname );
+    acc += LoadMaterial( wcol, aWireMatFname );
+    acc += LoadMaterial( gcol, aGlassMatFname );
+    acc += LoadMaterial( kcol, aCathodeMatFname );
+    acc += LoadMaterial( tcol, aInnerTubeMatFname );
 
     if( acc )
     {
@@ -106,30 +106,8 @@ int DO35::SetColors( const std::string& aWireMatFname,
 }
 
 
-int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
-            bool isVKFlipped, double aPitch, double aLeadDepth )
+int DO35::checkBuild( bool isHoriz, bool& isVKFlipped, double aPitch, double aLeadDepth )
 {
-    /*
-     * Dimensions per DO-35 package specification:
-     *      + D: 1.53 .. 2.28   (body diameter)
-     *      + B: 3.05 .. 4.15   (body length)
-     *      + C: 0.46 .. 0.56   (lead diameter)
-     *      + A: 25.40 .. 38.10 (lead length - doesn't really matter)
-     *
-     * Other dimensions:
-     *      + 0.9: edge taper (chamfer is 10% of body diameter)
-     *      + 0.5: thickness of cathode band
-     *      + 0.7: inner tube is 70% of outer body size
-     *      + 0.3: 0.3mm is the thickness of the glass at the ends
-     *      + vertical offsets:
-     *          > horiz: ~D/2 + C == 1.7 mm to axis of body
-     *          > vert: C == 0.56 to edge of body
-     */
-
-    CIRCLE body[5]; // outer body (including cathode)
-    CIRCLE tube;    // inner tube
-    PIN leads[2];
-
     // constraint: colors must be successfully loaded (hascol = true)
     if( !hascol )
     {
@@ -168,92 +146,62 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
         return -1;
     }
 
+    return 0;
+}
+
+
+void DO35::calcBody( CIRCLE* aBody, CIRCLE& aTube, bool isHoriz, bool isVKFlipped )
+{
     int i;
 
     for( i = 0; i < 5; ++i )
-        body[i].SetNVertices( ntv );
+        aBody[i].SetNVertices( ntv );
 
-    tube.SetNVertices( ntv );
+    aTube.SetNVertices( ntv );
 
-    TRANSFORM t0, t1;
-    QUAT q0;
-    double r, l0, l1;    // bend radius and lengths for lead
-    PPARAMS pp;
-    pp.tap  = -1.0;
-    pp.w    = 0.56;
-    pp.d    = 0.56;
-    leads[0].SetShape( false );
-    leads[1].SetShape( false );
+    TRANSFORM t0;
+    double l0, l1;
 
     if( isHoriz )
     {
-        // leads
-        t0.SetTranslation( 0, 0, -aLeadDepth );
-        r = 0.84;                               // 0.56 * 1.5
-        l0  = 1.7 - r + aLeadDepth;             // length of vertical section
-        l1  = (aPitch - 4.15 + 0.6) / 2.0 - r;  // length of horizontal section
-        pp.h = l0;
-        pp.r = r;
-        pp.nb = nb;
-        pp.l = l1;
-        pp.bend = M_PI / 2.0;
-        pp.ns = nwv;
-        leads[0].Calc( pp, t0 );
-        t0.SetTranslation( aPitch, 0, -aLeadDepth );
-        t0.SetRotation( M_PI, 0, 0, 1 );
-        leads[1].Calc( pp, t0 );
+        // the body is centered on x = 0 so that it does not depend
+        // on the pitch; writeModel() moves it to the middle of the leads
         // glass body
-        l0 = (aPitch - 4.15) / 2.0;
+        l0 = -4.15 / 2.0;
         t0.SetTranslation( l0, 0, 1.7 );
         t0.SetRotation( M_PI / 2.0, 0, 1, 0 );
         l1 = 0.9 * 2.28;
-        body[0].Calc( l1, l1, t0 );
+        aBody[0].Calc( l1, l1, t0 );
         l0 += 0.228;
         t0.SetTranslation( l0, 0, 1.7 );
-        body[1].Calc( 2.28, 2.28, t0 );
+        aBody[1].Calc( 2.28, 2.28, t0 );
         l0 += 0.772;    // 0.772 = 1mm cathode band - 0.228mm envelope edge
         t0.SetTranslation( l0, 0, 1.7 );
-        body[2].Calc( 2.28, 2.28, t0 );
-        l0 = (aPitch - 4.15) / 2.0 + 4.15 - 0.228;
+        aBody[2].Calc( 2.28, 2.28, t0 );
+        l0 = 4.15 / 2.0 - 0.228;
         t0.SetTranslation( l0, 0, 1.7 );
-        body[3].Calc( 2.28, 2.28, t0 );
+        aBody[3].Calc( 2.28, 2.28, t0 );
         l0 += 0.228;
         t0.SetTranslation( l0, 0, 1.7 );
-        body[4].Calc( l1, l1, t0 );
+        aBody[4].Calc( l1, l1, t0 );
         // inner tube
-        l0  = (aPitch - 4.15) / 2.0 + 0.3;
+        l0  = -4.15 / 2.0 + 0.3;
         l1  = 1.596; // 2.28 * 0.7
         t0.SetTranslation( l0, 0, 1.7 );
-        tube.Calc( l1, l1, t0 );
+        aTube.Calc( l1, l1, t0 );
     }
     else
     {
-        // leads
-        t0.SetTranslation( 0, 0, -aLeadDepth );
-        l0 = aLeadDepth + 0.86;     // 0.86 = 0.56 + 0.3
-        pp.h = l0;
-        pp.r = -1;
-        pp.nb = nb;
-        pp.l = -1;
-        pp.bend = 0.0;
-        pp.ns = nwv;
-        leads[0].Calc( pp, t0 );
-        t0.SetTranslation( 0, 0, 4.41 );    // 4.41 = 0.56 + 4.15 - 0.3
-        pp.h = 0.5;
-        pp.r = aPitch / 2.0;
-        pp.l = aLeadDepth + 4.91;           // 4.91 = 4.41 + 0.5
-        pp.bend = M_PI;
-        leads[1].Calc( pp, t0 );
         // inner tube
         l1 = 1.596;                         // 2.28 * 0.7
         t0.SetTranslation( 0, 0, 0.86 );    // 0.86 = 0.56 + 0.3
-        tube.Calc( l1, l1, t0 );
+        aTube.Calc( l1, l1, t0 );
         // glass body
         t0.SetTranslation( 0, 0, 0.56 );
         l1 = 0.9 * 2.28;
-        body[0].Calc( l1, l1, t0 );
+        aBody[0].Calc( l1, l1, t0 );
         t0.SetTranslation( 0, 0, 0.788 );    // 0.788 = 0.56 + 0.228
-        body[1].Calc( 2.28, 2.28, t0 );
+        aBody[1].Calc( 2.28, 2.28, t0 );
 
         if( !isVKFlipped )
         {
@@ -264,28 +212,79 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
             t0.SetTranslation( 0, 0, 3.71 );    // 3.71 = 0.56 + 4.15 - 1.0 cathode band
         }
 
-        body[2].Calc( 2.28, 2.28, t0 );
+        aBody[2].Calc( 2.28, 2.28, t0 );
         t0.SetTranslation( 0, 0, 4.482 );   // 4.21 = 0.56 + 4.15 - 0.228
-        body[3].Calc( 2.28, 2.28, t0 );
+        aBody[3].Calc( 2.28, 2.28, t0 );
         t0.SetTranslation( 0, 0, 4.71 );    // 4.71 = 0.56 + 4.15
-        body[4].Calc( l1, l1, t0 );
+        aBody[4].Calc( l1, l1, t0 );
     }
 
-    int acc = 0;
+    return;
+}
 
-    // open the file
-    ofstream fp;
-    ostringstream filename;
-    filename << aPartname << ".wrl";
-    acc += SetupVRML( filename.str(), fp );
 
-    if( acc )
+void DO35::calcLeads( PIN* aLeads, bool isHoriz, double aPitch, double aLeadDepth )
+{
+    TRANSFORM t0;
+    double r, l0, l1;    // bend radius and lengths for lead
+    PPARAMS pp;
+    pp.tap  = -1.0;
+    pp.w    = 0.56;
+    pp.d    = 0.56;
+    aLeads[0].SetShape( false );
+    aLeads[1].SetShape( false );
+
+    if( isHoriz )
     {
-        ERRBLURB;
-        cerr << "could not open output file '" << filename.str().c_str() << "'\n";
-        return -1;
+        t0.SetTranslation( 0, 0, -aLeadDepth );
+        r = 0.84;                               // 0.56 * 1.5
+        l0  = 1.7 - r + aLeadDepth;             // length of vertical section
+        l1  = (aPitch - 4.15 + 0.6) / 2.0 - r;  // length of horizontal section
+        pp.h = l0;
+        pp.r = r;
+        pp.nb = nb;
+        pp.l = l1;
+        pp.bend = M_PI / 2.0;
+        pp.ns = nwv;
+        aLeads[0].Calc( pp, t0 );
+        t0.SetTranslation( aPitch, 0, -aLeadDepth );
+        t0.SetRotation( M_PI, 0, 0, 1 );
+        aLeads[1].Calc( pp, t0 );
+    }
+    else
+    {
+        t0.SetTranslation( 0, 0, -aLeadDepth );
+        l0 = aLeadDepth + 0.86;     // 0.86 = 0.56 + 0.3
+        pp.h = l0;
+        pp.r = -1;
+        pp.nb = nb;
+        pp.l = -1;
+        pp.bend = 0.0;
+        pp.ns = nwv;
+        aLeads[0].Calc( pp, t0 );
+        t0.SetTranslation( 0, 0, 4.41 );    // 4.41 = 0.56 + 4.15 - 0.3
+        pp.h = 0.5;
+        pp.r = aPitch / 2.0;
+        pp.l = aLeadDepth + 4.91;           // 4.91 = 4.41 + 0.5
+        pp.bend = M_PI;
+        aLeads[1].Calc( pp, t0 );
     }
 
+    return;
+}
+
+
+int DO35::writeModel( std::ofstream& aVRMLFile, const std::string& aPartname,
+                      double aScale, bool isHoriz, bool isVKFlipped, double aPitch,
+                      CIRCLE* aBody, CIRCLE& aTube, PIN* aLeads )
+{
+    int acc = 0;
+    std::ofstream& fp = aVRMLFile;
+    CIRCLE* body = aBody;
+    TRANSFORM t0, t1, tb;
+    QUAT q0;
+    double l0;
+
     acc += SetupXForm( aPartname, fp, 0 );
 
     l0 = aPitch / 2.0;
@@ -295,21 +294,26 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
     if( isHoriz )
     {
+        // the body is centered on x = 0 rather than at l0
+        tb.SetTranslation( l0 * aScale - l0, 0, 0 );
+        tb.SetRotation( 0, 0, 0, 0 );
+        tb.SetScale( aScale );
+
         // leads
-        acc += leads[0].Build( true, false, t0, wcol, false, fp, 2 );
-        acc += leads[1].Build( true, false, t0, wcol, true, fp, 2 );
+        acc += aLeads[0].Build( true, false, t0, wcol, false, fp, 2 );
+        acc += aLeads[1].Build( true, false, t0, wcol, true, fp, 2 );
         // inner tube
         t1.SetTranslation( 3.55, 0, 0 );    // 3.55 = 4.15 - 2*0.3
-        q0.Set( 0, (aPitch - 4.15) / 2.0 + 0.3, 0, 0 );
-        acc += tube.Extrude( true, true, true, q0, t1, t0, tcol, false, fp, 2 );
+        q0.Set( 0, -4.15 / 2.0 + 0.3, 0, 0 );
+        acc += aTube.Extrude( true, true, true, q0, t1, tb, tcol, false, fp, 2 );
         // glass
-        acc += body[0].Paint( false, t0, kcol, false, fp, 2 );
-        acc += body[1].Paint( true, t0, kcol, false, fp, 2 );
-        acc += body[0].Stitch( true, body[1], t0, kcol, true, fp, 2 );
-        acc += body[1].Stitch( true, body[2], t0, kcol, true, fp, 2 );
-        acc += body[2].Stitch( true, body[3], t0, gcol, false, fp, 2 );
-        acc += body[3].Stitch( true, body[4], t0, gcol, true, fp, 2 );
-        acc += body[4].Paint( true, t0, gcol, true, fp, 2 );
+        acc += body[0].Paint( false, tb, kcol, false, fp, 2 );
+        acc += body[1].Paint( true, tb, kcol, false, fp, 2 );
+        acc += body[0].Stitch( true, body[1], tb, kcol, true, fp, 2 );
+        acc += body[1].Stitch( true, body[2], tb, kcol, true, fp, 2 );
+        acc += body[2].Stitch( true, body[3], tb, gcol, false, fp, 2 );
+        acc += body[3].Stitch( true, body[4], tb, gcol, true, fp, 2 );
+        acc += body[4].Paint( true, tb, gcol, true, fp, 2 );
     }
     else
     {
@@ -320,12 +324,12 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
         }
 
         // leads
-        acc += leads[0].Build( true, false, t0, wcol, false, fp, 2 );
-        acc += leads[1].Build( false, true, t0, wcol, true, fp, 2 );
+        acc += aLeads[0].Build( true, false, t0, wcol, false, fp, 2 );
+        acc += aLeads[1].Build( false, true, t0, wcol, true, fp, 2 );
         // inner tube
         t1.SetTranslation( 0, 0, 3.55 );    // 3.55 = 4.15 - 2*0.3
         q0.Set( 0, 0, 0, 0.86 );            // 0.86 = 0.56 + 0.3
-        acc += tube.Extrude( true, true, true, q0, t1, t0, tcol, false, fp, 2 );
+        acc += aTube.Extrude( true, true, true, q0, t1, t0, tcol, false, fp, 2 );
 
         // glass
         if( !isVKFlipped )
@@ -351,6 +355,63 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
     }
 
     acc += CloseXForm( fp, 0 );
+
+    if( acc )
+        return -1;
+
+    return 0;
+}
+
+
+int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
+            bool isVKFlipped, double aPitch, double aLeadDepth,
+            const std::string& aOutputPath )
+{
+    /*
+     * Dimensions per DO-35 package specification:
+     *      + D: 1.53 .. 2.28   (body diameter)
+     *      + B: 3.05 .. 4.15   (body length)
+     *      + C: 0.46 .. 0.56   (lead diameter)
+     *      + A: 25.40 .. 38.10 (lead length - doesn't really matter)
+     *
+     * Other dimensions:
+     *      + 0.9: edge taper (chamfer is 10% of body diameter)
+     *      + 0.5: thickness of cathode band
+     *      + 0.7: inner tube is 70% of outer body size
+     *      + 0.3: 0.3mm is the thickness of the glass at the ends
+     *      + vertical offsets:
+     *          > horiz: ~D/2 + C == 1.7 mm to axis of body
+     *          > vert: C == 0.56 to edge of body
+     */
+
+    CIRCLE body[5]; // outer body (including cathode)
+    CIRCLE tube;    // inner tube
+    PIN leads[2];
+
+    if( checkBuild( isHoriz, isVKFlipped, aPitch, aLeadDepth ) )
+        return -1;
+
+    calcBody( body, tube, isHoriz, isVKFlipped );
+    calcLeads( leads, isHoriz, aPitch, aLeadDepth );
+
+    int acc = 0;
+
+    // open the file
+    ofstream fp;
+    ostringstream filename;
+    filename << aPartname << ".wrl";
+    string path = aOutputPath.empty() ? filename.str() : aOutputPath;
+    acc += SetupVRML( filename.str(), path, fp );
+
+    if( acc )
+    {
+        ERRBLURB;
+        cerr << "could not open output file '" << path << "'\n";
+        return -1;
+    }
+
+    acc += writeModel( fp, aPartname, aScale, isHoriz, isVKFlipped, aPitch,
+                       body, tube, leads );
     fp.close();
 
     if( acc )
@@ -362,3 +423,23 @@ int DO35::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
     return 0;
 }       // Build()
+
+
+void DO35::calcVariantBody( int aBodySet, bool isHoriz, bool isVKFlipped )
+{
+    calcBody( vbody[aBodySet], vtube[aBodySet], isHoriz, isVKFlipped );
+    return;
+}
+
+
+int DO35::writeVariant( std::ofstream& aVRMLFile, const VARIANT& aVariant,
+                        int aBodySet, double aScale, double aLeadDepth )
+{
+    PIN leads[2];
+
+    calcLeads( leads, aVariant.horiz, aVariant.pitch, aLeadDepth );
+
+    return writeModel( aVRMLFile, aVariant.name, aScale, aVariant.horiz,
+                       aVariant.vkflip, aVariant.pitch, vbody[aBodySet],
+                       vtube[aBodySet], leads );
+}
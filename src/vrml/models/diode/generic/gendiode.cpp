@@ -155,9 +155,9 @@ int GENDIODE::SetColors( const std::string& aWireMatFname, const std::string& aB
 {
     int acc = 0;
 
-    acc += wcol.Load( aWireMatFname );
-    acc += bcol.Load( aBodyMatFname );
-    acc += kcol.Load( aCathodeMatFname );
+    acc += LoadMaterial( wcol, aWireMatFname );
+    acc += LoadMaterial( bcol, aBodyMatFname );
+    acc += LoadMaterial( kcol, aCathodeMatFname );
 
     if( acc )
     {
@@ -173,29 +173,8 @@ int GENDIODE::SetColors( const std::string& aWireMatFname, const std::string& aB
 }
 
 
-int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
-               bool isVKFlipped, double aPitch, double aLeadDepth )
+int GENDIODE::checkBuild( bool isHoriz, bool& isVKFlipped, double aPitch, double aLeadDepth )
 {
-    /*
-     * Dimensions per DO-35 package specification:
-     *      + D: 1.53 .. 2.28   (body diameter)
-     *      + B: 3.05 .. 4.15   (body length)
-     *      + C: 0.46 .. 0.56   (lead diameter)
-     *      + A: 25.40 .. 38.10 (lead length - doesn't really matter)
-     *
-     * Other dimensions:
-     *      + 0.9: edge taper (chamfer is 10% of body diameter)
-     *      + 0.5: thickness of cathode band
-     *      + 0.7: inner tube is 70% of outer body size
-     *      + 0.3: 0.3mm is the thickness of the glass at the ends
-     *      + vertical offsets:
-     *          > horiz: ~D/2 + C == 1.7 mm to axis of body
-     *          > vert: C == 0.56 to edge of body
-     */
-
-    CIRCLE body[6];    // outer body (including cathode)
-    PIN leads[2];
-
     // constraint: colors must be successfully loaded (hascol = true)
     if( !hascol )
     {
@@ -246,10 +225,16 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
         return -1;
     }
 
+    return 0;
+}
+
+
+int GENDIODE::calcBody( CIRCLE* aBody, bool isHoriz, bool isVKFlipped )
+{
     int i, j;
 
     for( i = 0; i < 6; ++i )
-        body[i].SetNVertices( ntv );
+        aBody[i].SetNVertices( ntv );
 
     int nc;    // number of circles used in description (only 5 if 'space' is zero, otherwise 6)
 
@@ -258,44 +243,23 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
     else
         nc = 6;
 
-    TRANSFORM t0, t1;
-    QUAT q0;
-    double r, l0, l1, l2;    // bend radius and lengths/offsets
-    PPARAMS pp;
-    pp.tap  = -1.0;
-    pp.w    = dwire;
-    pp.d    = dwire;
-    leads[0].SetShape( false );
-    leads[1].SetShape( false );
+    TRANSFORM t0;
+    double l0, l1, l2;
 
     if( isHoriz )
     {
-        // leads
-        t0.SetTranslation( 0, 0, -aLeadDepth );
-        r = 1.5 * dwire;
-        l0  = dbody / 2.0 + dwire + aLeadDepth - r;   // length of vertical section
-        l1  = (aPitch - lbody) / 2.0 - r;        // length of horizontal section
-        pp.h = l0;
-        pp.r = r;
-        pp.nb = nb;
-        pp.l = l1;
-        pp.bend = M_PI / 2.0;
-        pp.ns = nwv;
-        leads[0].Calc( pp, t0 );
-        t0.SetTranslation( aPitch, 0, -aLeadDepth );
-        t0.SetRotation( M_PI, 0, 0, 1 );
-        leads[1].Calc( pp, t0 );
-        // body
+        // the body is centered on x = 0 so that it does not depend
+        // on the pitch; writeModel() moves it to the middle of the leads
         j = 0;
         l2  = 0.5 * dbody + dwire;
-        l0  = (aPitch - lbody) / 2.0;
+        l0  = -0.5 * lbody;
         t0.SetTranslation( l0, 0, l2 );
         t0.SetRotation( M_PI / 2.0, 0, 1, 0 );
         l1 = 0.98 * dbody;
-        body[j++].Calc( l1, l1, t0 );
+        aBody[j++].Calc( l1, l1, t0 );
         l0 += 0.02 * dbody;
         t0.SetTranslation( l0, 0, l2 );
-        body[j++].Calc( dbody, dbody, t0 );
+        aBody[j++].Calc( dbody, dbody, t0 );
 
         if( scath > 1e-9 )
         {
@@ -305,7 +269,7 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
             {
                 l0 += l1;
                 t0.SetTranslation( l0, 0, l2 );
-                body[j++].Calc( dbody, dbody, t0 );
+                aBody[j++].Calc( dbody, dbody, t0 );
             }
             else
             {
@@ -315,41 +279,24 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
         l0 += wcath;
         t0.SetTranslation( l0, 0, l2 );
-        body[j++].Calc( dbody, dbody, t0 );
-        l0 = (aPitch - lbody) / 2.0 + 0.98 * lbody;
+        aBody[j++].Calc( dbody, dbody, t0 );
+        l0 = -0.5 * lbody + 0.98 * lbody;
         t0.SetTranslation( l0, 0, l2 );
-        body[j++].Calc( dbody, dbody, t0 );
+        aBody[j++].Calc( dbody, dbody, t0 );
         l0 += 0.02 * lbody;
         t0.SetTranslation( l0, 0, l2 );
         l1 = 0.98 * dbody;
-        body[j++].Calc( l1, l1, t0 );
+        aBody[j++].Calc( l1, l1, t0 );
     }
     else
     {
-        // leads
-        t0.SetTranslation( 0, 0, -aLeadDepth );
-        l0 = aLeadDepth + dwire;
-        pp.h = l0;
-        pp.r = -1;
-        pp.nb = nb;
-        pp.l = -1;
-        pp.bend = 0.0;
-        pp.ns = nwv;
-        leads[0].Calc( pp, t0 );
-        t0.SetTranslation( 0, 0, dwire + lbody );
-        pp.h = dwire;
-        pp.r = aPitch / 2.0;
-        pp.l = aLeadDepth + 2.0 * dwire + lbody;
-        pp.bend = M_PI;
-        leads[1].Calc( pp, t0 );
-        // body
         j = 0;
         t0.SetTranslation( 0, 0, dwire );
         l1 = 0.98 * dbody;
-        body[j++].Calc( l1, l1, t0 );
+        aBody[j++].Calc( l1, l1, t0 );
         l0 = dwire + 0.02 * dbody;
         t0.SetTranslation( 0, 0, l0 );
-        body[j++].Calc( dbody, dbody, t0 );
+        aBody[j++].Calc( dbody, dbody, t0 );
 
         if( !isVKFlipped )
         {
@@ -362,7 +309,7 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
                 {
                     l0 += l1;
                     t0.SetTranslation( 0, 0, l0 );
-                    body[j++].Calc( dbody, dbody, t0 );
+                    aBody[j++].Calc( dbody, dbody, t0 );
                 }
                 else
                 {
@@ -372,14 +319,14 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
             l0 += wcath;
             t0.SetTranslation( 0, 0, l0 );
-            body[j++].Calc( dbody, dbody, t0 );
+            aBody[j++].Calc( dbody, dbody, t0 );
         }
         else
         {
             // cathode is at long lead
             l0 = dwire + lbody - scath - wcath;
             t0.SetTranslation( 0, 0, l0 );
-            body[j++].Calc( dbody, dbody, t0 );
+            aBody[j++].Calc( dbody, dbody, t0 );
 
             if( scath > 1e-9 )
             {
@@ -389,7 +336,7 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
                 {
                     l0 += wcath;
                     t0.SetTranslation( 0, 0, l0 );
-                    body[j++].Calc( dbody, dbody, t0 );
+                    aBody[j++].Calc( dbody, dbody, t0 );
                 }
                 else
                 {
@@ -400,27 +347,79 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
         l0 = dwire + lbody - 0.02 * dbody;
         t0.SetTranslation( 0, 0, l0 );
-        body[j++].Calc( dbody, dbody, t0 );
+        aBody[j++].Calc( dbody, dbody, t0 );
         l1  = dbody * 0.98;
         l0  = dwire + lbody;
         t0.SetTranslation( 0, 0, l0 );
-        body[j++].Calc( l1, l1, t0 );
+        aBody[j++].Calc( l1, l1, t0 );
     }
 
-    int acc = 0;
+    return nc;
+}
 
-    // open the file
-    ofstream fp;
-    ostringstream filename;
-    filename << aPartname << ".wrl";
-    acc += SetupVRML( filename.str(), fp );
 
-    if( acc )
+void GENDIODE::calcLeads( PIN* aLeads, bool isHoriz, double aPitch, double aLeadDepth )
+{
+    TRANSFORM t0;
+    double r, l0, l1;    // bend radius and lengths/offsets
+    PPARAMS pp;
+    pp.tap  = -1.0;
+    pp.w    = dwire;
+    pp.d    = dwire;
+    aLeads[0].SetShape( false );
+    aLeads[1].SetShape( false );
+
+    if( isHoriz )
     {
-        ERRBLURB;
-        cerr << "could not open output file '" << filename.str().c_str() << "'\n";
-        return -1;
+        t0.SetTranslation( 0, 0, -aLeadDepth );
+        r = 1.5 * dwire;
+        l0  = dbody / 2.0 + dwire + aLeadDepth - r;   // length of vertical section
+        l1  = (aPitch - lbody) / 2.0 - r;        // length of horizontal section
+        pp.h = l0;
+        pp.r = r;
+        pp.nb = nb;
+        pp.l = l1;
+        pp.bend = M_PI / 2.0;
+        pp.ns = nwv;
+        aLeads[0].Calc( pp, t0 );
+        t0.SetTranslation( aPitch, 0, -aLeadDepth );
+        t0.SetRotation( M_PI, 0, 0, 1 );
+        aLeads[1].Calc( pp, t0 );
     }
+    else
+    {
+        t0.SetTranslation( 0, 0, -aLeadDepth );
+        l0 = aLeadDepth + dwire;
+        pp.h = l0;
+        pp.r = -1;
+        pp.nb = nb;
+        pp.l = -1;
+        pp.bend = 0.0;
+        pp.ns = nwv;
+        aLeads[0].Calc( pp, t0 );
+        t0.SetTranslation( 0, 0, dwire + lbody );
+        pp.h = dwire;
+        pp.r = aPitch / 2.0;
+        pp.l = aLeadDepth + 2.0 * dwire + lbody;
+        pp.bend = M_PI;
+        aLeads[1].Calc( pp, t0 );
+    }
+
+    return;
+}
+
+
+int GENDIODE::writeModel( std::ofstream& aVRMLFile, const std::string& aPartname,
+                          double aScale, bool isHoriz, bool isVKFlipped, double aPitch,
+                          CIRCLE* aBody, int aNRings, PIN* aLeads )
+{
+    int acc = 0;
+    int j;
+    int nc = aNRings;
+    std::ofstream& fp = aVRMLFile;
+    CIRCLE* body = aBody;
+    TRANSFORM t0, tb;
+    double l0;
 
     acc += SetupXForm( aPartname, fp, 0 );
 
@@ -431,26 +430,31 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
     if( isHoriz )
     {
+        // the body is centered on x = 0 rather than at l0
+        tb.SetTranslation( l0 * aScale - l0, 0, 0 );
+        tb.SetRotation( 0, 0, 0, 0 );
+        tb.SetScale( aScale );
+
         // leads
-        acc += leads[0].Build( true, false, t0, wcol, false, fp, 2 );
-        acc += leads[1].Build( true, false, t0, wcol, true, fp, 2 );
+        acc += aLeads[0].Build( true, false, t0, wcol, false, fp, 2 );
+        acc += aLeads[1].Build( true, false, t0, wcol, true, fp, 2 );
         // body
-        acc += body[0].Paint( false, t0, bcol, false, fp, 2 );
-        acc += body[nc - 1].Paint( true, t0, bcol, true, fp, 2 );
-        acc += body[0].Stitch( true, body[1], t0, bcol, true, fp, 2 );
+        acc += body[0].Paint( false, tb, bcol, false, fp, 2 );
+        acc += body[nc - 1].Paint( true, tb, bcol, true, fp, 2 );
+        acc += body[0].Stitch( true, body[1], tb, bcol, true, fp, 2 );
         j = 1;
 
         if( nc == 6 )
         {
-            acc += body[j].Stitch( true, body[j + 1], t0, bcol, true, fp, 2 );
+            acc += body[j].Stitch( true, body[j + 1], tb, bcol, true, fp, 2 );
             ++j;
         }
 
-        acc += body[j].Stitch( true, body[j + 1], t0, kcol, false, fp, 2 );
+        acc += body[j].Stitch( true, body[j + 1], tb, kcol, false, fp, 2 );
 
         while( ++j < (nc - 1) )
         {
-            acc += body[j].Stitch( true, body[j + 1], t0, bcol, true, fp, 2 );
+            acc += body[j].Stitch( true, body[j + 1], tb, bcol, true, fp, 2 );
         }
     }
     else
@@ -462,8 +466,8 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
         }
 
         // leads
-        acc += leads[0].Build( true, false, t0, wcol, false, fp, 2 );
-        acc += leads[1].Build( false, true, t0, wcol, true, fp, 2 );
+        acc += aLeads[0].Build( true, false, t0, wcol, false, fp, 2 );
+        acc += aLeads[1].Build( false, true, t0, wcol, true, fp, 2 );
 
         // body
         if( !isVKFlipped )
@@ -506,6 +510,62 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
     }
 
     acc += CloseXForm( fp, 0 );
+
+    if( acc )
+        return -1;
+
+    return 0;
+}
+
+
+int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
+               bool isVKFlipped, double aPitch, double aLeadDepth,
+               const std::string& aOutputPath )
+{
+    /*
+     * Dimensions per DO-35 package specification:
+     *      + D: 1.53 .. 2.28   (body diameter)
+     *      + B: 3.05 .. 4.15   (body length)
+     *      + C: 0.46 .. 0.56   (lead diameter)
+     *      + A: 25.40 .. 38.10 (lead length - doesn't really matter)
+     *
+     * Other dimensions:
+     *      + 0.9: edge taper (chamfer is 10% of body diameter)
+     *      + 0.5: thickness of cathode band
+     *      + 0.7: inner tube is 70% of outer body size
+     *      + 0.3: 0.3mm is the thickness of the glass at the ends
+     *      + vertical offsets:
+     *          > horiz: ~D/2 + C == 1.7 mm to axis of body
+     *          > vert: C == 0.56 to edge of body
+     */
+
+    CIRCLE body[6];    // outer body (including cathode)
+    PIN leads[2];
+
+    if( checkBuild( isHoriz, isVKFlipped, aPitch, aLeadDepth ) )
+        return -1;
+
+    int nc = calcBody( body, isHoriz, isVKFlipped );
+    calcLeads( leads, isHoriz, aPitch, aLeadDepth );
+
+    int acc = 0;
+
+    // open the file
+    ofstream fp;
+    ostringstream filename;
+    filename << aPartname << ".wrl";
+    string path = aOutputPath.empty() ? filename.str() : aOutputPath;
+    acc += SetupVRML( filename.str(), path, fp );
+
+    if( acc )
+    {
+        ERRBLURB;
+        cerr << "could not open output file '" << path << "'\n";
+        return -1;
+    }
+
+    acc += writeModel( fp, aPartname, aScale, isHoriz, isVKFlipped, aPitch,
+                       body, nc, leads );
     fp.close();
 
     if( acc )
@@ -517,3 +577,23 @@ int GENDIODE::Build( const std::string& aPartname, double aScale, bool isHoriz,
 
     return 0;
 }       // Build()
+
+
+void GENDIODE::calcVariantBody( int aBodySet, bool isHoriz, bool isVKFlipped )
+{
+    vnrings[aBodySet] = calcBody( vbody[aBodySet], isHoriz, isVKFlipped );
+    return;
+}
+
+
+int GENDIODE::writeVariant( std::ofstream& aVRMLFile, const VARIANT& aVariant,
+                            int aBodySet, double aScale, double aLeadDepth )
+{
+    PIN leads[2];
+
+    calcLeads( leads, aVariant.horiz, aVariant.pitch, aLeadDepth );
+
+    return writeModel( aVRMLFile, aVariant.name, aScale, aVariant.horiz,
+                       aVariant.vkflip, aVariant.pitch, vbody[aBodySet],
+                       vnrings[aBodySet], leads );
+}
@@ -27,6 +27,7 @@
 
 #include <vdefs.h>
 #include <vcom.h>
+#include <outpath.h>
 #include <transform.h>
 #include <dip.h>
 #include <dip_case.h>
@@ -79,23 +80,19 @@ int DIP::SetCaseColor( std::string filename )
 DIP::DIP()
 {
     pins = 0;
-    haspin = NULL;
+    caseValid = false;
+    pinValid = false;
 }
 
 
 DIP::~DIP()
 {
-    if( (pins) && (haspin) )
-        delete [] haspin;
+    return;
 }
 
 
 int DIP::SetPins( int aNPins )
 {
-    if( (pins) && (haspin) )
-        delete [] haspin;
-
-    haspin = NULL;
     pins = 0;
 
     if( (aNPins < 4) || (aNPins % 2) )
@@ -105,19 +102,8 @@ int DIP::SetPins( int aNPins )
         return -1;
     }
 
-    haspin = new (nothrow) bool[aNPins];
-
-    if( haspin == NULL )
-    {
-        ERRBLURB;
-        cerr << "could not allocate memory for pin inclusion map\n";
+    if( pinmask.SetSize( aNPins ) )
         return -1;
-    }
-
-    int i;
-
-    for( i = 0; i < aNPins; ++i )
-        haspin[i] = true;
 
     pins = aNPins;
     return 0;
@@ -141,12 +127,32 @@ int DIP::SetPin( int aPinNumber, bool isRendered )
         return -1;
     }
 
-    haspin[aPinNumber - 1] = isRendered;
+    return pinmask.Set( aPinNumber, isRendered );
+}
+
+
+int DIP::SetPinMask( const KC3D::PINMASK& aMask )
+{
+    if( aMask.GetSize() != pins || !pins )
+    {
+        ERRBLURB;
+        cerr << "mask size (" << aMask.GetSize();
+        cerr << ") does not match the number of pins (" << pins << ")\n";
+        return -1;
+    }
+
+    pinmask = aMask;
     return 0;
 }
 
 
-int DIP::Build( std::string aVRMLFilename )
+KC3D::PINMASK& DIP::GetPinMask( void )
+{
+    return pinmask;
+}
+
+
+int DIP::Build( std::string aVRMLFilename, std::string aOutputPath )
 {
     int pin, hpin;
     ofstream fp;
@@ -166,9 +172,6 @@ int DIP::Build( std::string aVRMLFilename )
         return -1;
     }
 
-    DIPCASE iccase;
-    DIPPIN  icpin;
-
     const double tan5 = 0.0874886635259;
 
     if( params.DW < 0.0 )
@@ -189,25 +192,21 @@ int DIP::Build( std::string aVRMLFilename )
     // length of case, nominal Pins/2 + DW
     double D = pins * 0.5 * params.e + 0.5 * params.DW;
 
-    iccase.SetCaseLength( D );
-    iccase.SetCaseWidth( params.E1 );
-    iccase.SetBaseHeight( params.A1 );
-    iccase.SetCaseDepth( params.A2 );
-    iccase.SetCaseTaper( params.S );
-    iccase.SetCaseMidHeight( params.MID );
-    iccase.SetNotchLength( params.NL );
-    iccase.SetNotchDepth( params.ND );
-
-    // derived pin parameters
-    double h = params.A1 + 0.5 * params.A2;
-    double w = 0.5 * (params.E - params.E1);
-    acc += icpin.Calc( h, params.L, w, params.c, params.B1, params.b, params.pinbev );
-
-    if( acc )
+    if( !pinValid )
     {
-        ERRBLURB;
-        cerr << "problems calculating pin appearance\n";
-        return -1;
+        // derived pin parameters
+        double h = params.A1 + 0.5 * params.A2;
+        double w = 0.5 * (params.E - params.E1);
+        acc += icpin.Calc( h, params.L, w, params.c, params.B1, params.b, params.pinbev );
+
+        if( acc )
+        {
+            ERRBLURB;
+            cerr << "problems calculating pin appearance\n";
+            return -1;
+        }
+
+        pinValid = true;
     }
 
     TRANSFORM T, TC;
@@ -220,19 +219,40 @@ int DIP::Build( std::string aVRMLFilename )
     TC.SetRotation( rot);
     TC.SetTranslation( tr * params.scale );
 
-    acc += iccase.Calc();
+    if( !caseValid )
+    {
+        iccase.SetCaseLength( D );
+        iccase.SetCaseWidth( params.E1 );
+        iccase.SetBaseHeight( params.A1 );
+        iccase.SetCaseDepth( params.A2 );
+        iccase.SetCaseTaper( params.S );
+        iccase.SetCaseMidHeight( params.MID );
+        iccase.SetNotchLength( params.NL );
+        iccase.SetNotchDepth( params.ND );
+        acc += iccase.Calc();
+    }
+    else if( D != iccase.GetCaseLength() )
+    {
+        acc += iccase.Stretch( D );
+    }
 
     if( acc )
     {
+        caseValid = false;
         ERRBLURB;
         cerr << "problems calculating case appearance\n";
         return -1;
     }
 
-    if( SetupVRML( aVRMLFilename, fp ) )
+    caseValid = true;
+
+    if( aOutputPath.empty() )
+        aOutputPath = aVRMLFilename;
+
+    if( SetupVRML( aVRMLFilename, aOutputPath, fp ) )
     {
         ERRBLURB;
-        cerr << "could not open file '" << aVRMLFilename << "'\n";
+        cerr << "could not open file '" << aOutputPath << "'\n";
         return -1;
     }
 
@@ -257,55 +277,52 @@ int DIP::Build( std::string aVRMLFilename )
 
     T.SetScale( params.scale );
 
-    // Pin1
-    if( haspin[0] )
-        acc += icpin.Build( T, pinmaterial, false, fp, 2 );
-
-    // Pin 2 .. (pins/2)
+    // Pin 1 .. (pins/2) are spaced by o1 from pin 1
     hpin = pins / 2;
     QUAT o1( 0.0, params.e, 0.0, 0.0 );
     rot.Rotate( o1 );
-    offset.x = 0.0;
-    offset.y = 0.0;
-    offset.z = 0.0;
-
-    for( pin = 2; pin <= hpin; ++pin )
-    {
-        offset.x = offset.x + o1.x;
-        offset.y = offset.y + o1.y;
-
-        if( !(haspin[pin - 1]) )
-            continue;
 
-        tr.Set( offset * params.scale );
-        T.SetTranslation( tr );
-        acc += icpin.Build( T, pinmaterial, true, fp, 2 );
-    }
-
-    // Pin (pins/2 +1)..
-    offset.x = (pins / 2.0 - 1.0) * params.e;
-    offset.y = params.E1;
-    offset.z = 0.0;
-    rot.Set( params.rotation, 0, 0, 1 );
-    rot.Rotate( offset );
+    // Pin (pins/2 +1).. are rotated by 180 degrees and spaced by o2
+    // from pin (pins/2 +1)
+    TRANSFORM T2;
+    QUAT o2( 0.0, params.e, 0.0, 0.0 );
+    QUAT base2( 0.0, (pins / 2.0 - 1.0) * params.e, params.E1, 0.0 );
+    rot.Rotate( base2 );
     rot.Set( M_PI + params.rotation, 0, 0, 1 );
-    T.SetRotation( rot );
-    tr.Set( offset * params.scale );
-    T.SetTranslation( tr );
-    o1.x = params.e;
-    o1.y = 0.0;
-    o1.z = 0.0;
-    rot.Rotate( o1 );
+    rot.Rotate( o2 );
+    T2.SetRotation( rot );
+    T2.SetScale( params.scale );
 
-    for( pin = hpin + 1; pin <= pins; ++pin )
-    {
-        if( haspin[pin - 1] )
-            acc += icpin.Build( T, pinmaterial, true, fp, 2 );
+    // only the rendered pins are visited; the first pin written
+    // defines the pin material
+    bool reuse = false;
 
-        offset.x += o1.x;
-        offset.y += o1.y;
-        tr.Set( offset * params.scale );
-        T.SetTranslation( tr );
+    for( pin = pinmask.Next( 0 ); pin > 0; pin = pinmask.Next( pin ) )
+    {
+        if( pin <= hpin )
+        {
+            if( pin > 1 )
+            {
+                offset.x = o1.x * ( pin - 1 );
+                offset.y = o1.y * ( pin - 1 );
+                offset.z = 0.0;
+                tr.Set( offset * params.scale );
+                T.SetTranslation( tr );
+            }
+
+            acc += icpin.Build( T, pinmaterial, reuse, fp, 2 );
+        }
+        else
+        {
+            offset.x = base2.x + o2.x * ( pin - hpin - 1 );
+            offset.y = base2.y + o2.y * ( pin - hpin - 1 );
+            offset.z = 0.0;
+            tr.Set( offset * params.scale );
+            T2.SetTranslation( tr );
+            acc += icpin.Build( T2, pinmaterial, reuse, fp, 2 );
+        }
+
+        reuse = true;
     }
 
     if( CloseXForm( fp ) )
@@ -318,6 +335,42 @@ int DIP::Build( std::string aVRMLFilename )
 }
 
 
+int DIP::BuildFamily( int aMinPins, int aMaxPins, const std::string& aPrefix,
+                      const std::string& aSuffix, KC3D::OUTPATH& aOutPath )
+{
+    if( (aMinPins < 4) || (aMinPins % 2) || (aMaxPins < aMinPins) )
+    {
+        ERRBLURB;
+        cerr << "invalid pin range (" << aMinPins << " .. " << aMaxPins;
+        cerr << "); the minimum must be >= 4 and a multiple of 2\n";
+        return -1;
+    }
+
+    ostringstream name;
+    ostringstream npins;
+    string path;
+
+    for( int i = aMinPins; i <= aMaxPins; i += 2 )
+    {
+        name.str( "" );
+        name << aPrefix << i << aSuffix;
+        npins.str( "" );
+        npins << i;
+        aOutPath.SetField( "pins", npins.str() );
+        path = aOutPath.MakePath( name.str() );
+
+        if( path.empty() || SetPins( i ) || Build( name.str() + ".wrl", path ) )
+        {
+            ERRBLURB;
+            cerr << "could not create model '" << name.str() << "'\n";
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
 int DIP::SetParams( const DIPPARAMS& aParams )
 {
     if( aParams.pinbev > aParams.c / 3 )
@@ -344,5 +397,7 @@ int DIP::SetParams( const DIPPARAMS& aParams )
     // XXX - validate parameters
 
     params = aParams;
+    caseValid = false;
+    pinValid = false;
     return 0;
 }
@@ -376,6 +376,50 @@ int DIPCASE::Calc( void )
 }
 
 
+int DIPCASE::Stretch( double aCaseLength )
+{
+    // vertices which belong to the +X end of the case; all others
+    // are on the -X end (which includes the notch)
+    static const int rend[] = { 1, 2, 6, 7, 8, 9, 14, 15, 16, 17, 22, 23, 24, 25,
+                                54, 55, 56, 57, 72, 73, 77, 78 };
+    static const int nrend = sizeof( rend ) / sizeof( rend[0] );
+
+    if( !valid )
+    {
+        ERRBLURB;
+        cerr << "invoked without prior successful call to calc()\n";
+        return -1;
+    }
+
+    if( aCaseLength <= 0.0 )
+    {
+        ERRBLURB;
+        cerr << "invalid value; must be > 0\n";
+        return -1;
+    }
+
+    double dx = ( aCaseLength - D ) / 2.0;
+    int i;
+    int j = 0;
+
+    for( i = 0; i < CASE_NP; ++i )
+    {
+        if( j < nrend && rend[j] == i )
+        {
+            p[i].x += dx;
+            ++j;
+        }
+        else
+        {
+            p[i].x -= dx;
+        }
+    }
+
+    D = aCaseLength;
+    return 0;
+}
+
+
 int DIPCASE::WriteCoord( TRANSFORM& aTransform, std::ofstream& aVRMLFile, int aTabDepth )
 {
     int i;
@@ -24,15 +24,50 @@
  *
  */
 
+/*
+ *  Options:
+ *
+ *  -n pat  : output path pattern; missing directories are created. The
+ *            following fields are replaced (default "{name}.wrl"):
+ *              {name}   : model name, for example dil14_i300
+ *              {pins}   : number of pins, for example 14
+ *              {row}    : row spacing, I300 or I600
+ *  -p file : parameter file for a family of DIPs; -p may be given several
+ *            times. Without -p the 0.3 and 0.6 inch families are built.
+ *
+ *  Parameter file keys (key : value); all keys are optional:
+ *
+ *  A1, A2, L, e, E, E1, B1, b, c, NW, ND, NL, casebev, pinbev, scale
+ *              : package dimensions; see DIPPARAMS in dip.h
+ *  pins        : range of pin counts, for example 4-28 (default 4-28)
+ *  prefix      : model name prefix (default dil); the model name is
+ *                [prefix][pins][suffix]
+ *  suffix      : model name suffix (default _i300)
+ *  row         : value of the {row} field (default I300)
+ *  case_color  : case appearance file (default ceram_gry.mat)
+ *  pin_color   : pin appearance file (default tin.mat)
+ *  pin_pattern : repeating pattern of rendered pins, for example 10 for
+ *                every other pin starting at pin 1
+ *  pins_omitted: pins which are not rendered, for example 3-6,9; pins
+ *                beyond the last pin of a model are ignored
+ */
+
 #include <unistd.h>
 #include <stdio.h>
+#include <cstdlib>
 #include <string>
+#include <sstream>
+#include <vector>
+#include <map>
 #include <wx/filename.h>
 
 #include <macros.h>
 #include <vdefs.h>
 #include <dip.h>
 #include <transform.h>
+#include <outpath.h>
+#include <pinmask.h>
+#include <keyvalparser.h>
 #include <k3dconfig.h>
 
 using namespace std;
@@ -42,17 +77,24 @@ extern char* optarg;
 extern int optopt;
 
 // 0.3" DIP
-int mkI300( const std::string& matdir );
+int mkI300( const std::string& matdir, KC3D::OUTPATH& outpath );
 
 // 0.6" DIP
-int mkI600( const std::string& matdir );
+int mkI600( const std::string& matdir, KC3D::OUTPATH& outpath );
+
+// family described by a parameter file
+int mkFamily( const std::string& pfile, const std::string& matdir, KC3D::OUTPATH& outpath );
 
 void printUsage( void )
 {
-    cout << "Usage: makeDip [-k appearances_path]\n";
+    cout << "Usage: makeDip [-k appearances_path] [-n pathPattern] [-p paramFile ...]\n";
     cout << "When invoked without a path specification, the environment\n";
     cout << "variable KC3DPATH must be set to the directory of the VRML\n";
     cout << "material appearance (ex: /usr/local/shared/kicad/kc3d/appearances)\n";
+    cout << "The path pattern may contain the fields {name}, {pins} and {row};\n";
+    cout << "for example: mcad/vrml/thru/dil/{row}/{name}.wrl\n";
+    cout << "Without a parameter file the 0.3 and 0.6 inch DILs are created;\n";
+    cout << "see makeDip.cpp for the parameter file keys\n";
 
     return;
 }
@@ -61,8 +103,10 @@ int main( int argc, char **argv )
 {
     int ic;
     string kc3ddir;
+    KC3D::OUTPATH outpath;
+    std::vector<string> paramFiles;
 
-    while( ( ic = getopt( argc, argv, ":k:h" ) ) > 0 )
+    while( ( ic = getopt( argc, argv, ":k:n:p:h" ) ) > 0 )
     {
         if( ic == ':' )
         {
@@ -89,9 +133,25 @@ int main( int argc, char **argv )
         if( ic == 'k' )
         {
             kc3ddir = optarg;
-            break;
+            continue;
+        }
+
+        if( ic == 'n' )
+        {
+            if( outpath.SetPattern( optarg ) )
+            {
+                printUsage();
+                return -1;
+            }
+
+            continue;
         }
 
+        if( ic == 'p' )
+        {
+            paramFiles.push_back( optarg );
+            continue;
+        }
     }
 
     if( kc3ddir.empty() )
@@ -108,13 +168,27 @@ int main( int argc, char **argv )
         kc3ddir = evp;
     }
 
-    if( mkI300( kc3ddir ) )
+    if( !paramFiles.empty() )
+    {
+        for( size_t i = 0; i < paramFiles.size(); ++i )
+        {
+            if( mkFamily( paramFiles[i], kc3ddir, outpath ) )
+            {
+                fprintf( stderr, "problems creating DILs from '%s'\n", paramFiles[i].c_str() );
+                return -1;
+            }
+        }
+
+        return 0;
+    }
+
+    if( mkI300( kc3ddir, outpath ) )
     {
         fprintf( stderr, "problems creating 0.3-inch DILs\n" );
         return -1;
     }
 
-    if( mkI600( kc3ddir ) )
+    if( mkI600( kc3ddir, outpath ) )
     {
         fprintf( stderr, "problems creating 0.3-inch DILs\n" );
         return -1;
@@ -124,11 +198,9 @@ int main( int argc, char **argv )
 }
 
 
-int mkI300( const std::string& matdir )
+int mkI300( const std::string& matdir, KC3D::OUTPATH& outpath )
 {
     DIP dil;
-    char    name[256];
-    int     i;
     DIPPARAMS dp;
 
     string colorHsg;
@@ -147,14 +219,10 @@ int mkI300( const std::string& matdir )
     dil.SetPinColor( colorPin );
     dil.SetParams( dp );
 
-    for( i = 4; i <= 28; i += 2 )
-    {
-        sprintf( name, "dil%d_i300.wrl", i );
-        dil.SetPins( i );
+    outpath.SetField( "row", "I300" );
 
-        if( dil.Build( name ) )
-            return -1;
-    }
+    if( dil.BuildFamily( 4, 28, "dil", "_i300", outpath ) )
+        return -1;
 
     /*
      *  // demo of the pin skipping function
@@ -175,11 +243,9 @@ int mkI300( const std::string& matdir )
 }
 
 
-int mkI600( const std::string& matdir )
+int mkI600( const std::string& matdir, KC3D::OUTPATH& outpath )
 {
     DIP dil;
-    char    name[256];
-    int     i;
     DIPPARAMS dp;
 
     string colorHsg;
@@ -205,12 +271,167 @@ int mkI600( const std::string& matdir )
     dp.E1   = 0.545;
     dil.SetParams( dp );
 
-    for( i = 40; i <= 40; i += 2 )
+    outpath.SetField( "row", "I600" );
+
+    if( dil.BuildFamily( 40, 40, "dil", "_i600", outpath ) )
+        return -1;
+
+    return 0;
+}
+
+
+int mkFamily( const std::string& pfile, const std::string& matdir, KC3D::OUTPATH& outpath )
+{
+    KC3D::KEYVAL_PARSER p;
+
+    if( p.LoadKeys( pfile ) <= 0 )
+    {
+        ERRBLURB;
+        cerr << "unable to read parameters from file: '" << pfile << "'\n";
+        return -1;
+    }
+
+    DIPPARAMS dp;
+    const map<string, string>& k = p.GetKeys();
+    map<string, string>::const_iterator kp;
+    map<string, string>::const_iterator kend = k.end();
+
+    struct
+    {
+        const char* key;
+        double* val;
+    } dims[] = {
+        { "A1", &dp.A1 }, { "A2", &dp.A2 }, { "L", &dp.L }, { "e", &dp.e },
+        { "E", &dp.E }, { "E1", &dp.E1 }, { "B1", &dp.B1 }, { "b", &dp.b },
+        { "c", &dp.c }, { "NW", &dp.NW }, { "ND", &dp.ND }, { "NL", &dp.NL },
+        { "casebev", &dp.casebev }, { "pinbev", &dp.pinbev }, { "scale", &dp.scale }
+    };
+
+    istringstream os;
+
+    for( size_t i = 0; i < sizeof( dims ) / sizeof( dims[0] ); ++i )
+    {
+        kp = k.find( dims[i].key );
+
+        if( kp == kend )
+            continue;
+
+        os.clear();
+        os.str( kp->second );
+        os >> *dims[i].val;
+
+        if( os.fail() )
+        {
+            ERRBLURB;
+            cerr << "invalid value for '" << dims[i].key << "' in '" << pfile << "'\n";
+            return -1;
+        }
+    }
+
+    string prefix = "dil";
+    string suffix = "_i300";
+    string row = "I300";
+    string colorHsg = "ceram_gry.mat";
+    string colorPin = "tin.mat";
+    string pattern;
+    string omitted;
+    int minPins = 4;
+    int maxPins = 28;
+
+    if( ( kp = k.find( "prefix" ) ) != kend )
+        prefix = kp->second;
+
+    if( ( kp = k.find( "suffix" ) ) != kend )
+        suffix = kp->second;
+
+    if( ( kp = k.find( "row" ) ) != kend )
+        row = kp->second;
+
+    if( ( kp = k.find( "case_color" ) ) != kend )
+        colorHsg = kp->second;
+
+    if( ( kp = k.find( "pin_color" ) ) != kend )
+        colorPin = kp->second;
+
+    if( ( kp = k.find( "pin_pattern" ) ) != kend )
+        pattern = kp->second;
+
+    if( ( kp = k.find( "pins_omitted" ) ) != kend )
+        omitted = kp->second;
+
+    if( ( kp = k.find( "pins" ) ) != kend )
+    {
+        char dash = '-';
+
+        os.clear();
+        os.str( kp->second );
+        os >> minPins;
+
+        if( !os.eof() )
+            os >> dash >> maxPins;
+        else
+            maxPins = minPins;
+
+        if( os.fail() || dash != '-' || minPins < 4 || ( minPins % 2 ) || maxPins < minPins )
+        {
+            ERRBLURB;
+            cerr << "invalid pin range '" << kp->second << "' in '" << pfile << "'\n";
+            return -1;
+        }
+    }
+
+    // check the masks once before any model is built
+    KC3D::PINMASK mask( maxPins );
+
+    if( ( !pattern.empty() && mask.SetPattern( pattern ) )
+        || ( !omitted.empty() && mask.SetList( omitted, false ) ) )
+        return -1;
+
+    DIP dil;
+
+    do
+    {
+        wxFileName chn( FROM_UTF8( matdir.c_str() ), FROM_UTF8( colorHsg.c_str() ) );
+        wxFileName cpn( FROM_UTF8( matdir.c_str() ), FROM_UTF8( colorPin.c_str() ) );
+
+        colorHsg = TO_UTF8( chn.GetFullPath() );
+        colorPin = TO_UTF8( cpn.GetFullPath() );
+    } while(0);
+
+    if( dil.SetCaseColor( colorHsg ) || dil.SetPinColor( colorPin ) || dil.SetParams( dp ) )
+        return -1;
+
+    outpath.SetField( "row", row );
+
+    // without masks the whole family shares a single call
+    if( pattern.empty() && omitted.empty() )
+        return dil.BuildFamily( minPins, maxPins, prefix, suffix, outpath );
+
+    ostringstream name;
+    ostringstream npins;
+    string path;
+
+    for( int i = minPins; i <= maxPins; i += 2 )
     {
-        sprintf( name, "dil%d_i600.wrl", i );
-        dil.SetPins( i );
+        name.str( "" );
+        name << prefix << i << suffix;
+        npins.str( "" );
+        npins << i;
+        outpath.SetField( "pins", npins.str() );
+        path = outpath.MakePath( name.str() );
+
+        if( path.empty() || dil.SetPins( i ) )
+            return -1;
+
+        KC3D::PINMASK& pm = dil.GetPinMask();
+
+        if( !pattern.empty() )
+            pm.SetPattern( pattern );
+
+        if( !omitted.empty() )
+            pm.SetList( omitted, false );
 
-        if( dil.Build( name ) )
+        if( dil.Build( name.str() + ".wrl", path ) )
             return -1;
     }
 
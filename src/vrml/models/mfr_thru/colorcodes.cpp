@@ -21,8 +21,10 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <cctype>
 
 #include <vdefs.h>
+#include <colorcodes.h>
 
 using namespace std;
 
@@ -31,6 +33,58 @@ using namespace std;
 #define MAX_EXP (9)
 
 
+// Resistor series E192 (1%) according to IEC 60063
+// ================================================
+
+static const int e192[192] =
+{
+    100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114,
+    115, 117, 118, 120, 121, 123, 124, 126, 127, 129, 130, 132,
+    133, 135, 137, 138, 140, 142, 143, 145, 147, 149, 150, 152,
+    154, 156, 158, 160, 162, 164, 165, 167, 169, 172, 174, 176,
+    178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203,
+    205, 208, 210, 213, 215, 218, 221, 223, 226, 229, 232, 234,
+    237, 240, 243, 246, 249, 252, 255, 258, 261, 264, 267, 271,
+    274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312,
+    316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 357, 361,
+    365, 370, 374, 379, 383, 388, 392, 397, 402, 407, 412, 417,
+    422, 427, 432, 437, 442, 448, 453, 459, 464, 470, 475, 481,
+    487, 493, 499, 505, 511, 517, 523, 530, 536, 542, 549, 556,
+    562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642,
+    649, 657, 665, 673, 681, 690, 698, 706, 715, 723, 732, 741,
+    750, 759, 768, 777, 787, 796, 806, 816, 825, 835, 845, 856,
+    866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988
+};
+
+static const int e96[96] =
+{
+    100, 102, 105, 107, 110, 113, 115, 118, 121, 124, 127, 130,
+    133, 137, 140, 143, 147, 150, 154, 158, 162, 165, 169, 174,
+    178, 182, 187, 191, 196, 200, 205, 210, 215, 221, 226, 232,
+    237, 243, 249, 255, 261, 267, 274, 280, 287, 294, 301, 309,
+    316, 324, 332, 340, 348, 357, 365, 374, 383, 392, 402, 412,
+    422, 432, 442, 453, 464, 475, 487, 499, 511, 523, 536, 549,
+    562, 576, 590, 604, 619, 634, 649, 665, 681, 698, 715, 732,
+    750, 768, 787, 806, 825, 845, 866, 887, 909, 931, 953, 976
+};
+
+static const int e48[48] =
+{
+    100, 105, 110, 115, 121, 127, 133, 140, 147, 154, 162, 169,
+    178, 187, 196, 205, 215, 226, 237, 249, 261, 274, 287, 301,
+    316, 332, 348, 365, 383, 402, 422, 442, 464, 487, 511, 536,
+    562, 590, 619, 649, 681, 715, 750, 787, 825, 866, 909, 953
+};
+
+static const int e24[24] =
+{
+    100, 110, 120, 130, 150, 160, 180, 200, 220, 240, 270, 300,
+    330, 360, 390, 430, 470, 510, 560, 620, 680, 750, 820, 910
+};
+
+static const int e12[12] = { 100, 120, 150, 180, 220, 270, 330, 390, 470, 560, 680, 820 };
+
+
 namespace KC3DRESISTOR
 {
 // Return an index into the color table for the given tolerance code.
@@ -447,4 +501,304 @@ int GetValueCode4( int value, int exp, std::string& vcode )
     return 0;
 }
 
+
+
+ESERIES::ESERIES()
+{
+    values = NULL;
+    nValues = 0;
+    minDecade = 0;
+    maxDecade = -1;
+    tol = 'F';
+    tc = 0;
+    nBands = -1;
+    decade = 0;
+    index = 0;
+}
+
+
+int ESERIES::Setup( const std::string& aPartSeries, int aSeries, int aMinDecade,
+                    int aMaxDecade, char aTolerance, char aTCoeff, int aGap )
+{
+    bool fail = false;
+
+    values = NULL;
+    nValues = 0;
+    nBands = -1;
+
+    switch( aSeries )
+    {
+    case 192:
+        values = e192;
+        break;
+
+    case 96:
+        values = e96;
+        break;
+
+    case 48:
+        values = e48;
+        break;
+
+    case 24:
+        values = e24;
+        break;
+
+    case 12:
+        values = e12;
+        break;
+
+    default:
+        ERRBLURB;
+        cerr << "unsupported E series (" << aSeries << "); " <<
+            "accepted values are 192, 96, 48, 24, and 12\n";
+        fail = true;
+        break;
+    }
+
+    if( (aMinDecade < MIN_DECADE)||(aMinDecade > MAX_DECADE)
+        ||(aMaxDecade < MIN_DECADE)||(aMaxDecade > MAX_DECADE) )
+    {
+        ERRBLURB;
+        cerr << "invalid decades (" << aMinDecade << " to " << aMaxDecade <<
+            "); accepted values are " << MIN_DECADE << " to " << MAX_DECADE << "\n";
+        fail = true;
+    }
+    else if( aMinDecade > aMaxDecade )
+    {
+        ERRBLURB;
+        cerr << "lower decade (" << aMinDecade << ") exceeds upper decade (" <<
+            aMaxDecade << ")\n";
+        fail = true;
+    }
+
+    if( (aTolerance) && (GetToleranceIndex( aTolerance ) < 0) )
+    {
+        ERRBLURB;
+        cerr << "invalid tolerance code ('" << aTolerance << "'); code is case sensitive.\n";
+        fail = true;
+    }
+
+    if( (aTCoeff) && (GetTCIndex( aTCoeff ) < 0) )
+    {
+        ERRBLURB;
+        cerr << "invalid temperature coefficient code ('" << aTCoeff <<
+            "'); code is case sensitive.\n";
+        fail = true;
+    }
+
+    if( (aGap < MIN_GAP)||(aGap > MAX_GAP) )
+    {
+        ERRBLURB;
+        cerr << "invalid gap value; accepted values are " <<
+            MIN_GAP << " to " << MAX_GAP << "\n";
+        fail = true;
+    }
+
+    if( aPartSeries.empty() || !isalpha( aPartSeries.c_str()[0] ) )
+    {
+        ERRBLURB;
+        cerr << "invalid series name; the name must begin with an alphabet character\n";
+        fail = true;
+    }
+
+    if( fail )
+    {
+        values = NULL;
+        return -1;
+    }
+
+    nValues = aSeries;
+    partSeries = aPartSeries;
+    minDecade = aMinDecade;
+    maxDecade = aMaxDecade;
+    tol = aTolerance;
+    tc = aTCoeff;
+    gap.assign( aGap, 'X' );
+    nBands = KC3DRESISTOR::GetNBands( tol );
+    Rewind();
+
+    return 0;
+}
+
+
+void ESERIES::Rewind( void )
+{
+    decade = minDecade;
+    index = 0;
+}
+
+
+bool ESERIES::Next( std::string& aName, std::string& aBands )
+{
+    if( !values )
+        return false;
+
+    while( decade <= maxDecade )
+    {
+        int i = decade;
+        int j = index++;
+
+        if( index >= nValues )
+        {
+            index = 0;
+            ++decade;
+        }
+
+        if( !makeEntry( i, values[j], aName, aBands ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+int ESERIES::GetNBands( void ) const
+{
+    if( !values )
+        return -1;
+
+    return nBands;
+}
+
+
+// basename = [Part Series]_[Value]_[Tolerance][TCoeff]
+int ESERIES::makeEntry( int aDecade, int aValue, std::string& aName, std::string& aBands )
+{
+    ostringstream basename;
+    ostringstream code;
+    string codestr;
+    int v0, v1, v2;     // elements of the resistor code
+    int k;
+    char oc = 0;        // temporary output character
+
+    v0  = aValue / 100;
+    v1  = (aValue % 100) / 10;
+    v2  = aValue % 10;
+
+    switch( nBands )
+    {
+    case 5:
+
+        if( GetValueCode5( aValue, aDecade - 2, codestr ) )
+        {
+            ERRBLURB;
+            cerr << "val(" << aValue << "), exp(" << aDecade - 2 << ")\n";
+            return -1;
+        }
+
+        break;
+
+    case 4:
+
+        if( GetValueCode4( aValue, aDecade - 2, codestr ) )
+        {
+            ERRBLURB;
+            cerr << "val(" << aValue << "), exp(" << aDecade - 2 << ")\n";
+            return -1;
+        }
+
+        break;
+
+    default:
+        ERRBLURB;
+        cerr << "invalid number of bands (" << nBands << "); valid values are 4 or 5 only\n";
+        return -1;
+        break;
+    }
+
+    basename << partSeries << "_" << codestr << "_" << tol;
+
+    if( tc )
+        basename << tc;
+    else
+        basename << "_";
+
+    k = aDecade - 2;
+
+    if( nBands == 4 )
+        k += 1;
+
+    if( k > 9 )
+    {
+        ERRBLURB;
+        cerr << "invalid exponent (>9); a decade > 11 must have been specified\n";
+        return -1;
+    }
+
+    if( k < -2 )
+    {
+        ERRBLURB;
+        cerr << "invalid exponent (<-2); a decade < 0 must have been specified\n";
+        return -1;
+    }
+
+    if( k >= 0 )
+    {
+        oc = 48 + k;
+    }
+    else
+    {
+        if( k == -2 )
+            oc = 'S';
+
+        if( k == -1 )
+            oc = 'G';
+    }
+
+    // code up to Multiplier
+    if( nBands == 5 )
+        code << v0 << v0 << gap << v1 << v1 << gap << v2 << v2 << gap << oc << oc << gap << "XX" << gap;
+    else
+        code << v0 << v0 << gap << v1 << v1 << gap << oc << oc << gap << "XX" << gap;
+
+    // add in the tolerance
+    k = GetToleranceIndex( tol );
+
+    if( k < 0 )
+        k = 12;
+
+    if( k < 10 )
+    {
+        oc = 48 + k;
+        code << oc << oc << oc;
+    }
+    else
+    {
+        if( k == 10 )
+            code << "GGG";
+
+        if( k == 11 )
+            code << "SSS";
+
+        if( k == 12 )
+            code << "XXX";
+    }
+
+    // add in the temperature coefficient
+    if( (tc) && ( ( k = GetTCIndex( tc ) ) >= 0 ) )
+    {
+        code << gap;
+
+        if( k < 10 )
+        {
+            oc = 48 + k;
+            code << oc << oc;
+        }
+        else
+        {
+            if( k == 10 )
+                code << "GG";
+
+            if( k == 11 )
+                code << "SS";
+        }
+    }
+
+    aName = basename.str();
+    aBands = code.str();
+
+    return 0;
+}
+
 }   // namespace KC3DRESISTOR
@@ -55,6 +55,40 @@
  *
  */
 
+/*
+ *  Options:
+ *
+ *  -j N    : build the models on N threads; each thread has its own
+ *            RESISTOR instance and writes its own files
+ *  -x      : stop at the first model which cannot be created; by default
+ *            the failure is reported and the remaining models are built
+ *  -p file : parameter file; -p may be given several times to build every
+ *            model of the list with each set of parameters
+ *  -n pat  : output path pattern; missing directories are created. The
+ *            following fields are replaced (default "{name}.wrl"):
+ *              {name}   : model name, for example MFR_12K1_F_B_0W50_0I40H
+ *              {series} : part series, for example MFR
+ *              {value}  : value code, for example 12K1
+ *              {decade} : decade of the value, for example 10K
+ *              {orient} : 'horiz' or 'vert'
+ *              {pwr}    : power suffix (pwrsuf)
+ *              {spc}    : lead spacing suffix (spcsuf)
+ *              {pitch}  : lead spacing suffix without the trailing
+ *                         orientation letter, for example 0I40 for 0I40H
+ *              {param}  : name of the parameter file without the directory
+ *
+ *  Instead of an output list (-o) the models may be generated directly
+ *  from a series of preferred values using the same options as makeEnnn:
+ *
+ *  -e N    : E series (192, 96, 48, 24, 12)
+ *  -s name : Part Series (for example, LR0204); the -p of makeEnnn
+ *  -l N    : minimum decade (0 .. 10, default 0)
+ *  -u N    : maximum decade (0 .. 10, default 6)
+ *  -t code : tolerance code (default F)
+ *  -c code : temperature coefficient code (default = no code)
+ *  -g N    : width of gap between bands (0 .. 4, default 1)
+ */
+
 /*
  *  Suggestion for the directory structure:
  *
@@ -71,8 +105,14 @@
 #include <fstream>
 #include <string>
 #include <sstream>
+#include <vector>
+#include <cstdlib>
 #include <wx/filename.h>
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include <macros.h>
 #include <vdefs.h>
 #include <polygon.h>
@@ -80,7 +120,9 @@
 #include <transform.h>
 #include <vrmlmat.h>
 #include <resistor.h>
+#include <colorcodes.h>
 #include <keyvalparser.h>
+#include <outpath.h>
 
 extern char*    optarg;
 extern int      optopt;
@@ -91,25 +133,69 @@ using namespace KC3DRESISTOR;
 
 void printUsage( void )
 {
-    cout << "Usage: makeMFR [-h] [-k appearances_path] -p paramFile -o outputList\n";
+    cout << "Usage: makeMFR [-h] [-j N] [-x] [-k appearances_path] [-n pathPattern]\n";
+    cout << "               -p paramFile [-p paramFile ...] -o outputList\n";
+    cout << "       makeMFR [-h] [-j N] [-x] [-k appearances_path] [-n pathPattern]\n";
+    cout << "               -p paramFile [-p paramFile ...] -e series -s partSeries\n";
+    cout << "               [-l minDecade] [-u maxDecade] [-t tolCode] [-c tcCode] [-g gap]\n";
     return;
 }
 
 
+// a single model in the output list
+struct MFRITEM
+{
+    std::string name;       // base filename
+    std::string bands;      // color code
+};
+
+
+// the list of models shared by all worker threads; every item
+// is built once with each parameter set
+struct MFRJOB
+{
+    const std::vector<RPARAMS>* params;
+    const std::vector<std::string>* paramNames;
+    const std::vector<MFRITEM>* items;
+    const OUTPATH* outpath; // output path pattern or NULL
+    size_t next;            // index of the next model to be built
+    int nFail;              // number of items which could not be built
+    bool stopOnError;       // stop at the first failure
+    bool stop;              // no more items are to be built
+#ifndef _WIN32
+    pthread_mutex_t lock;
+#endif
+};
+
+
 int GetParams( const std::string& pfile, RPARAMS& rp, const std::string& matdir );
+void SetFields( OUTPATH& aOutPath, const MFRITEM& aItem, const RPARAMS& aParams,
+                const std::string& aParamName );
+void* BuildModels( void* arg );
 
 int main( int argc, char** argv )
 {
     KEYVAL_PARSER outputs;
-    RPARAMS params;
-    string  paramFile;
+    std::vector<RPARAMS> params;
+    std::vector<string> paramFiles;
+    std::vector<string> paramNames;
     string  outFile;
-    RESISTOR res;
+    string  pattern;
     string kc3ddir;
+    int nThreads = 1;
+    bool stopOnError = false;
+    // preferred values series; see makeEnnn
+    int nser = 0;
+    int ldec = 0;
+    int udec = 6;
+    char tol = 'F';
+    char tc = 0;
+    int gap = 1;
+    string series;
 
     int ich;
 
-    while( ( ich = getopt( argc, argv, ":hp:o:k:" ) ) > 0 )
+    while( ( ich = getopt( argc, argv, ":hp:o:k:j:xe:s:l:u:t:c:g:n:" ) ) > 0 )
     {
         if( ich == ':' )
         {
@@ -135,8 +221,14 @@ int main( int argc, char** argv )
 
         if( ich == 'p' )
         {
-            paramFile.assign( optarg );
-            cerr << "param file: " << paramFile << "\n";
+            paramFiles.push_back( optarg );
+            cerr << "param file: " << paramFiles.back() << "\n";
+            continue;
+        }
+
+        if( ich == 'n' )
+        {
+            pattern = optarg;
             continue;
         }
 
@@ -153,6 +245,68 @@ int main( int argc, char** argv )
             continue;
         }
 
+        if( ich == 'j' )
+        {
+            nThreads = atoi( optarg );
+
+            if( nThreads < 1 || nThreads > 256 )
+            {
+                ERRBLURB;
+                cerr << "invalid number of threads; valid range is 1 .. 256\n";
+                return -1;
+            }
+
+            continue;
+        }
+
+        if( ich == 'x' )
+        {
+            stopOnError = true;
+            continue;
+        }
+
+        if( ich == 'e' )
+        {
+            nser = atoi( optarg );
+            continue;
+        }
+
+        if( ich == 's' )
+        {
+            series = optarg;
+            continue;
+        }
+
+        if( ich == 'l' )
+        {
+            ldec = atoi( optarg );
+            continue;
+        }
+
+        if( ich == 'u' )
+        {
+            udec = atoi( optarg );
+            continue;
+        }
+
+        if( ich == 't' )
+        {
+            tol = *optarg;
+            continue;
+        }
+
+        if( ich == 'c' )
+        {
+            tc = *optarg;
+            continue;
+        }
+
+        if( ich == 'g' )
+        {
+            gap = atoi( optarg );
+            continue;
+        }
+
     }   // optarg parsing
 
     if( kc3ddir.empty() )
@@ -169,7 +323,7 @@ int main( int argc, char** argv )
         kc3ddir = evp;
     }
 
-    if( paramFile.empty() )
+    if( paramFiles.empty() )
     {
         ERRBLURB;
         cerr << "no parameters file specified\n";
@@ -177,58 +331,312 @@ int main( int argc, char** argv )
         return -1;
     }
 
-    if( outFile.empty() )
+    if( outFile.empty() && !nser )
     {
         ERRBLURB;
-        cerr << "no output file list specified\n";
+        cerr << "no output file list or E series specified\n";
         printUsage();
         return -1;
     }
 
-    if( GetParams( paramFile, params, kc3ddir ) )
+    if( !outFile.empty() && nser )
     {
         ERRBLURB;
-        cerr << "unable to read parameters from file: '" << paramFile << "'\n";
+        cerr << "options -o and -e are mutually exclusive\n";
+        printUsage();
         return -1;
     }
 
-    if( outputs.LoadKeys( outFile ) <= 0 )
+    ESERIES eser;
+
+    if( nser && eser.Setup( series, nser, ldec, udec, tol, tc, gap ) )
     {
         ERRBLURB;
-        cerr << "unable to read output list from file: '" << paramFile << "'\n";
+        cerr << "invalid preferred values series\n";
+        printUsage();
         return -1;
     }
 
-    map<string, string>::const_iterator lstart = outputs.GetKeys().begin();
-    map<string, string>::const_iterator lend = outputs.GetKeys().end();
+    for( size_t i = 0; i < paramFiles.size(); ++i )
+    {
+        params.push_back( RPARAMS() );
+
+        if( GetParams( paramFiles[i], params.back(), kc3ddir ) )
+        {
+            ERRBLURB;
+            cerr << "unable to read parameters from file: '" << paramFiles[i] << "'\n";
+            return -1;
+        }
+
+        size_t sep = paramFiles[i].find_last_of( "/\\" );
+
+        if( sep == string::npos )
+            paramNames.push_back( paramFiles[i] );
+        else
+            paramNames.push_back( paramFiles[i].substr( sep + 1 ) );
+    }
 
-    int i = 0;
+    std::vector<MFRITEM> items;
 
-    while( lstart != lend )
+    if( nser )
     {
-        ++i;
+        MFRITEM item;
 
-        if( res.Create( params, lstart->second, lstart->first ) )
+        while( eser.Next( item.name, item.bands ) )
+            items.push_back( item );
+    }
+    else
+    {
+        if( outputs.LoadKeys( outFile ) <= 0 )
         {
             ERRBLURB;
-            cerr << "bailing out due to error\n";
-            cerr << "Problems at item #" << i << "\n";
+            cerr << "unable to read output list from file: '" << outFile << "'\n";
             return -1;
         }
 
-        ++lstart;
+        map<string, string>::const_iterator lstart = outputs.GetKeys().begin();
+        map<string, string>::const_iterator lend = outputs.GetKeys().end();
+
+        while( lstart != lend )
+        {
+            items.push_back( MFRITEM() );
+            items.back().name = lstart->first;
+            items.back().bands = lstart->second;
+            ++lstart;
+        }
+    }
+
+    if( items.empty() )
+    {
+        ERRBLURB;
+        cerr << "no models to build\n";
+        return -1;
+    }
+
+    // check the pattern before any model is built
+    OUTPATH outpath;
+
+    if( !pattern.empty() )
+    {
+        string path;
+
+        if( !outpath.SetPattern( pattern ) )
+        {
+            SetFields( outpath, items[0], params[0], paramNames[0] );
+            outpath.Expand( RESISTOR::GetModelName( params[0], items[0].name ), path );
+        }
+
+        if( path.empty() )
+        {
+            ERRBLURB;
+            cerr << "invalid output path pattern: '" << pattern << "'\n";
+            return -1;
+        }
+    }
+
+    size_t nModels = items.size() * params.size();
+
+#ifdef _WIN32
+    if( nThreads > 1 )
+    {
+        cerr << "threads are not supported on this platform; using a single thread\n";
+        nThreads = 1;
+    }
+#endif
+
+    if( nThreads > (int) nModels )
+        nThreads = nModels;
+
+    MFRJOB job;
+    job.params = &params;
+    job.paramNames = &paramNames;
+    job.items = &items;
+    job.outpath = pattern.empty() ? NULL : &outpath;
+    job.next = 0;
+    job.nFail = 0;
+    job.stopOnError = stopOnError;
+    job.stop = false;
+
+#ifdef _WIN32
+    BuildModels( &job );
+#else
+    pthread_mutex_init( &job.lock, NULL );
+
+    if( nThreads > 1 )
+    {
+        std::vector<pthread_t> tid( nThreads );
+        int nt = 0;
+
+        for( ; nt < nThreads; ++nt )
+        {
+            if( pthread_create( &tid[nt], NULL, BuildModels, &job ) )
+                break;
+        }
+
+        // no threads could be created; build the models on this thread
+        if( nt == 0 )
+            BuildModels( &job );
+
+        for( int i = 0; i < nt; ++i )
+            pthread_join( tid[i], NULL );
+    }
+    else
+    {
+        BuildModels( &job );
+    }
+
+    pthread_mutex_destroy( &job.lock );
+#endif
+
+    if( job.nFail )
+    {
+        ERRBLURB;
+        cerr << job.nFail << " of " << nModels << " models could not be created";
+
+        if( job.stop )
+            cerr << "; stopped at the first failure";
+
+        cerr << "\n";
+        return -1;
     }
 
     return 0;
 }
 
 
+// build models from the shared list until it is exhausted; each
+// invocation has its own RESISTOR for each parameter set so that
+// the geometry templates are reused between the models built by
+// the same thread
+void* BuildModels( void* arg )
+{
+    MFRJOB* job = (MFRJOB*) arg;
+    std::vector<RPARAMS> params = *job->params;
+    std::vector<RESISTOR> res( params.size() );
+    OUTPATH outpath;                // private copy of the pattern and directory cache
+    size_t nItems = job->items->size();
+    size_t nModels = nItems * params.size();
+    std::string path;
+    size_t i;
+
+    if( job->outpath )
+        outpath = *job->outpath;
+
+    while( true )
+    {
+#ifndef _WIN32
+        pthread_mutex_lock( &job->lock );
+#endif
+
+        if( job->stop || job->next >= nModels )
+        {
+#ifndef _WIN32
+            pthread_mutex_unlock( &job->lock );
+#endif
+            break;
+        }
+
+        i = job->next++;
+
+#ifndef _WIN32
+        pthread_mutex_unlock( &job->lock );
+#endif
+
+        // all models of one parameter set are built before the next
+        size_t ip = i / nItems;
+        const MFRITEM& item = (*job->items)[i % nItems];
+        int ret = 0;
+
+        path.clear();
+
+        if( job->outpath )
+        {
+            SetFields( outpath, item, params[ip], (*job->paramNames)[ip] );
+            ret = outpath.Expand( RESISTOR::GetModelName( params[ip], item.name ), path );
+
+            if( !ret )
+                ret = outpath.MakeDirs( path );
+        }
+
+        if( !ret )
+            ret = res[ip].Create( params[ip], item.bands, item.name, path );
+
+        if( ret )
+        {
+#ifndef _WIN32
+            pthread_mutex_lock( &job->lock );
+#endif
+            ++job->nFail;
+            ERRBLURB;
+            cerr << "problems at item #" << i % nItems + 1 << " ('" << item.name << "')";
+
+            if( params.size() > 1 )
+                cerr << " with parameters '" << (*job->paramNames)[ip] << "'";
+
+            cerr << "\n";
+
+            if( job->stopOnError )
+                job->stop = true;
+
+#ifndef _WIN32
+            pthread_mutex_unlock( &job->lock );
+#endif
+        }
+    }
+
+    return NULL;
+}
+
+
+// set the fields of the output path pattern for a model; {name}
+// is provided by OUTPATH
+void SetFields( OUTPATH& aOutPath, const MFRITEM& aItem, const RPARAMS& aParams,
+                const std::string& aParamName )
+{
+    // the base name is [Part Series]_[Value]_...
+    string value;
+    size_t s0 = aItem.name.find( '_' );
+
+    if( s0 != string::npos )
+        value = aItem.name.substr( s0 + 1, aItem.name.find( '_', s0 + 1 ) - s0 - 1 );
+
+    // the decade is 1, 10 or 100 followed by the multiplier of the value
+    string decade;
+    size_t nd = value.find_first_not_of( "0123456789" );
+
+    if( nd != string::npos && nd > 0 )
+    {
+        decade = "1";
+        decade.append( nd - 1, '0' );
+        decade.append( 1, value[nd] );
+    }
+
+    aOutPath.SetField( "series", aItem.name.substr( 0, s0 ) );
+    aOutPath.SetField( "value", value );
+    aOutPath.SetField( "decade", decade );
+    aOutPath.SetField( "orient", aParams.horiz ? "horiz" : "vert" );
+    aOutPath.SetField( "pwr", aParams.pwrsuf );
+    aOutPath.SetField( "spc", aParams.spcsuf );
+
+    // the library directories use the spacing without the H or V suffix
+    string pitch = aParams.spcsuf;
+
+    if( !pitch.empty() && ( pitch[pitch.size() - 1] == 'H' || pitch[pitch.size() - 1] == 'V' ) )
+        pitch.erase( pitch.size() - 1 );
+
+    aOutPath.SetField( "pitch", pitch );
+    aOutPath.SetField( "param", aParamName );
+    return;
+}
+
+
 int GetParams( const std::string& pfile, RPARAMS& rp, const std::string& matdir )
 {
     KEYVAL_PARSER p;
 
+    // a missing or empty file would leave the colors unset
     if( p.LoadKeys( pfile ) <= 0 )
-        return 0;
+        return -1;
 
     const map<string, string>& k = p.GetKeys();
     map<string, string>::const_iterator kp;
@@ -388,12 +796,14 @@ int GetParams( const std::string& pfile, RPARAMS& rp, const std::string& matdir
         if( kp != kend )
         {
             wxFileName cfn( FROM_UTF8( matdir.c_str() ), FROM_UTF8( kp->second.c_str() ) );
+            string mpath( TO_UTF8( cfn.GetFullPath() ) );
 
-            if( rp.colors[i].Load( TO_UTF8( cfn.GetFullPath() ) ) )
+            // the materials are loaded once and shared by all parameter sets
+            if( LoadMaterial( rp.colors[i], mpath ) )
             {
                 ERRBLURB;
                 cerr << "cannot load color #" << i << " ('";
-                cerr << TO_UTF8( cfn.GetFullPath() ) << "')\n";
+                cerr << mpath << "')\n";
                 return -1;
             }
         }
@@ -27,6 +27,8 @@
 #include <new>
 #include <iomanip>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <vdefs.h>
 #include <vcom.h>
@@ -60,7 +62,13 @@ RPARAMS::RPARAMS()
 }
 
 
-int RESISTOR::makeHzLead( std::ofstream& fp )
+RESISTOR::RESISTOR()
+{
+    tnbands = 0;
+}
+
+
+int RESISTOR::makeHzLead( std::ostream& fp )
 {
     // XXX - TODO: refactor using class PIN
 
@@ -206,7 +214,7 @@ int RESISTOR::makeHzLead( std::ofstream& fp )
 }
 
 
-int RESISTOR::makeVtLead( std::ofstream& fp )
+int RESISTOR::makeVtLead( std::ostream& fp )
 {
     TRANSFORM t0;
     PPARAMS lp;
@@ -304,7 +312,8 @@ int RESISTOR::makeVtLead( std::ofstream& fp )
 }
 
 
-int RESISTOR::makeBody( std::ofstream& fp, const std::string& bands )
+int RESISTOR::makeBody( std::ostream& fp, const std::string& bands,
+                         std::vector< std::streampos >* bandPos )
 {
     // Notes:
     // Hz start of body:   ((p - L)/2, 0, (D/2 + 0.2))
@@ -570,6 +579,9 @@ int RESISTOR::makeBody( std::ofstream& fp, const std::string& bands )
 
     for( i = 0; i < nb - 1; ++i )
     {
+        if( bandPos )
+            bandPos->push_back( fp.tellp() );
+
         idx = getColorIdx( i, bands );
         body[i + j].Stitch( true, body[i + j + 1], tx, params.colors[idx], used[idx], fp, 2 );
 
@@ -577,6 +589,9 @@ int RESISTOR::makeBody( std::ofstream& fp, const std::string& bands )
             used[idx] = true;
     }
 
+    if( bandPos )
+        bandPos->push_back( fp.tellp() );
+
     for( i = ntot - nend; i < ntot - 1; ++i )
     {
         body[i].Stitch( true, body[i + 1], tx, params.colors[12], true, fp, 2 );
@@ -589,7 +604,7 @@ int RESISTOR::makeBody( std::ofstream& fp, const std::string& bands )
 
 
 int RESISTOR::Create( RPARAMS& aParameters, const std::string& aBandString,
-                const std::string& aVRMLFname )
+                const std::string& aVRMLFname, const std::string& aOutputPath )
 {
     int i;
     bool fail = false;
@@ -691,22 +706,14 @@ int RESISTOR::Create( RPARAMS& aParameters, const std::string& aBandString,
 
 
     params = aParameters;
-    ostringstream fname;
-    fname << aVRMLFname << params.endshape;
-
-    if( !params.pwrsuf.empty() )
-        fname << "_" << params.pwrsuf;
-
-    if( !params.spcsuf.empty() )
-        fname << "_" << params.spcsuf;
+    string modname( GetModelName( params, aVRMLFname ) );
+    string fname( modname + ".wrl" );
+    string path( aOutputPath.empty() ? fname : aOutputPath );
 
-    string modname( fname.str() );
-    fname << ".wrl";
-
-    if( SetupVRML( fname.str(), fp ) )
+    if( SetupVRML( fname, path, fp ) )
     {
         ERRBLURB;
-        cerr << "could not open file: '" << aVRMLFname << "'\n";
+        cerr << "could not open file: '" << path << "'\n";
         return -1;
     }
 
@@ -714,19 +721,44 @@ int RESISTOR::Create( RPARAMS& aParameters, const std::string& aBandString,
     int acc = 0;
     acc += SetupXForm( modname, fp, 0 );
 
-    if( params.horiz )
+    if( matchTemplate( aBandString ) )
     {
-        acc += makeHzLead( fp );
-        acc += makeBody( fp, aBandString );
+        acc += writeTemplate( fp, aBandString );
+        acc += CloseXForm( fp, 0 );
+        fp.close();
     }
     else
     {
-        acc += makeVtLead( fp );
-        acc += makeBody( fp, aBandString );
-    }
+        // render the leads and body into memory so that the text may be
+        // kept as the template; marks: start of each band, start of the
+        // remainder of the body
+        std::ostringstream tfp;
+        std::vector< std::streampos > marks;
+
+        tfp.copyfmt( fp );
+
+        if( params.horiz )
+            acc += makeHzLead( tfp );
+        else
+            acc += makeVtLead( tfp );
 
-    acc += CloseXForm( fp, 0 );
-    fp.close();
+        acc += makeBody( tfp, aBandString, &marks );
+        fp.copyfmt( tfp );
+
+        std::string text( tfp.str() );
+        fp << text;
+        acc += CloseXForm( fp, 0 );
+        fp.close();
+
+        tnbands = 0;
+
+        if( !acc )
+        {
+            tparams = params;
+            tnbands = aBandString.size();
+            makeTemplate( text, marks );
+        }
+    }
 
     if( acc )
     {
@@ -739,6 +771,162 @@ int RESISTOR::Create( RPARAMS& aParameters, const std::string& aBandString,
 }    // Create
 
 
+std::string RESISTOR::GetModelName( const RPARAMS& aParameters, const std::string& aVRMLFname )
+{
+    ostringstream fname;
+    fname << aVRMLFname << aParameters.endshape;
+
+    if( !aParameters.pwrsuf.empty() )
+        fname << "_" << aParameters.pwrsuf;
+
+    if( !aParameters.spcsuf.empty() )
+        fname << "_" << aParameters.spcsuf;
+
+    return fname.str();
+}
+
+
+// compare the appearance of two materials
+static bool sameMaterial( VRMLMAT& m0, VRMLMAT& m1 )
+{
+    if( m0.GetName() != m1.GetName()
+        || m0.GetAmbientIntensity() != m1.GetAmbientIntensity()
+        || m0.GetTransparency() != m1.GetTransparency()
+        || m0.GetShininess() != m1.GetShininess() )
+        return false;
+
+    float c0[3];
+    float c1[3];
+
+    m0.GetDiffuse( c0 );
+    m1.GetDiffuse( c1 );
+
+    if( memcmp( c0, c1, sizeof( c0 ) ) )
+        return false;
+
+    m0.GetEmissivity( c0 );
+    m1.GetEmissivity( c1 );
+
+    if( memcmp( c0, c1, sizeof( c0 ) ) )
+        return false;
+
+    m0.GetSpecular( c0 );
+    m1.GetSpecular( c1 );
+
+    if( memcmp( c0, c1, sizeof( c0 ) ) )
+        return false;
+
+    return true;
+}
+
+
+// determine whether the template may be used for the current
+// parameters and band code; only the band colors may differ
+bool RESISTOR::matchTemplate( const std::string& bands )
+{
+    if( tnbands == 0 || tnbands != bands.size() )
+        return false;
+
+    if( tparams.scale != params.scale || tparams.shift != params.shift
+        || tparams.L != params.L || tparams.D != params.D
+        || tparams.d != params.d || tparams.p != params.p
+        || tparams.wl != params.wl || tparams.horiz != params.horiz
+        || tparams.endshape != params.endshape || tparams.bcap != params.bcap
+        || tparams.wsides != params.wsides || tparams.bsides != params.bsides
+        || tparams.rsides != params.rsides )
+        return false;
+
+    // the body and wire materials are part of the template
+    if( !sameMaterial( tparams.colors[12], params.colors[12] )
+        || !sameMaterial( tparams.colors[13], params.colors[13] ) )
+        return false;
+
+    return true;
+}
+
+
+// split the leads and body text at the band materials; marks holds
+// the offsets of the start of each band and the body following the last band
+void RESISTOR::makeTemplate( const std::string& text,
+                             const std::vector< std::streampos >& marks )
+{
+    tband.clear();
+    tbody.clear();
+    ttail.clear();
+
+    size_t nm = marks.size();
+
+    if( text.empty() || nm != tnbands + 1 )
+    {
+        tnbands = 0;
+        return;
+    }
+
+    tbody = text.substr( 0, (size_t)(std::streamoff) marks[0] );
+    ttail = text.substr( (size_t)(std::streamoff) marks[nm - 1] );
+
+    // each band's geometry follows the Appearance node written by SetupShape()
+    static const std::string geom( "geometry IndexedFaceSet {\n" );
+    size_t i;
+
+    for( i = 0; i < nm - 1; ++i )
+    {
+        std::string band = text.substr( (size_t)(std::streamoff) marks[i],
+                                        (size_t)( marks[i + 1] - marks[i] ) );
+        size_t pos = band.find( geom );
+
+        if( pos == std::string::npos )
+        {
+            tnbands = 0;
+            tband.clear();
+            tbody.clear();
+            ttail.clear();
+            return;
+        }
+
+        tband.push_back( band.substr( pos + geom.size() ) );
+    }
+
+    return;
+}
+
+
+// write the leads and body from the template with the current band colors
+int RESISTOR::writeTemplate( std::ofstream& fp, const std::string& bands )
+{
+    int i;
+    int idx;
+    int acc = 0;
+    bool used[14];
+
+    for( i = 0; i < 14; ++i )
+        used[i] = false;
+
+    used[12] = true;    // body color is already used
+
+    fp << tbody;
+
+    for( i = 0; i < (int)tband.size(); ++i )
+    {
+        idx = getColorIdx( i, bands );
+        acc += SetupShape( params.colors[idx], used[idx], fp, 2 );
+        fp << tband[i];
+        used[idx] = true;
+    }
+
+    fp << ttail;
+
+    if( acc || !fp.good() )
+    {
+        ERRBLURB;
+        cerr << "error writing to file\n";
+        return -1;
+    }
+
+    return 0;
+}
+
+
 int RESISTOR::validateBands( const std::string& bands )
 {
     int i;
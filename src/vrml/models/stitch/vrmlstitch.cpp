@@ -22,7 +22,20 @@
  *  \brief This program takes a list of VRML parts and transforms and produces
  *  an assembly compatible with the KiCAD 3D Viewer.
  *
- *  Usage: vrmlstitch <input_file>
+ *  Usage: vrmlstitch [-j N] [-m MB] [-c | -i] [-s] [-v] <input_file> [<input_file> ...]
+ *
+ *  -j N        =   transform and format the parts using N threads; the
+ *                  output is identical to that of a single thread
+ *  -m MB       =   memory limit for the cache of parsed parts (default 256)
+ *  -c          =   read the parts as VRML meshes and write the assembly with
+ *                  a single Shape per material; the whole assembly is held in
+ *                  memory and -j and -m have no effect
+ *  -i          =   write each distinct part once and place every occurrence
+ *                  via a Transform which USEs it; for viewers which support
+ *                  nested transforms. -j has no effect
+ *  -s          =   write the bounding box and the vertex, facet and shape
+ *                  counts of the assembly and of each part to <file>.json
+ *  -v          =   report part counts, cache use and peak memory use
  *
  *  Input format:
  *  #           =   comment
@@ -40,6 +53,9 @@
  *
  *  The input file may contain multiple .begin .. .end blocks, 1 for each
  *  component in the assembly.
+ *
+ *  When several input files are given each one produces its own assembly;
+ *  every distinct part file is read and parsed only once per run.
  */
 
 /*
@@ -64,16 +80,26 @@
  *          independently.
  *
  *      + Since the KiCAD 3D viewer does not handle actual transformations,
- *          identical parts must all be repeated. If the KiCAD viewer handled
- *          transformations sensibly we could save an awful lot of space by
- *          taking advantage of the DEF feature.
+ *          identical parts must all be repeated. For other viewers the -i
+ *          option takes advantage of the DEF feature instead: a part is
+ *          written once within a DEF'd Group and each occurrence is a
+ *          Transform whose only child is a USE of that Group. TRANSFORM
+ *          scales, rotates and then translates a point, which is the
+ *          order in which a VRML Transform applies its parameters.
  *
- *      + Every line is inspected for the "coord Coordinate {" phrase
- *          and all subsequent numbers are transformed until the end of the
- *          Coordinate { block. Within the block streams need to be parsed by
- *          each character; non-numeric characters are simply passed on while
- *          numeric characters are interpreted, put into triplets, and transformed
- *          before writing out.
+ *      + Each part file is mapped into memory and scanned for the
+ *          "Coordinate" keyword; the text between Coordinate { blocks is
+ *          kept as whole spans (less any comment lines). Within a block
+ *          numeric characters are interpreted directly from the mapped
+ *          bytes and put into triplets while all other characters are
+ *          simply passed on. The parsed part is cached and each instance
+ *          is written out by transforming the cached triplets.
+ *
+ *      + Memory use does not grow with the number of parts in an assembly:
+ *          part blocks are read from the input file as they are processed,
+ *          the output is written in fixed-size chunks (or with -j, from at
+ *          most 4N pending part buffers), and the least recently used parts
+ *          are evicted from the cache when it exceeds its limit.
  *
  */
 
@@ -83,10 +109,26 @@
 #include <sstream>
 #include <iomanip>
 #include <cctype>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <vdefs.h>
 #include <transform.h>
 #include <vcom.h>
+#include <vrmlmesh.h>
 
 using namespace std;
 using namespace KC3D;
@@ -95,7 +137,13 @@ using namespace KC3D;
 void printUsage( void )
 {
     cerr << "\n***\n";
-    cerr << "Usage: vrmlstitch <input_file>\n";
+    cerr << "Usage: vrmlstitch [-j N] [-m MB] [-c | -i] [-s] [-v] <input_file> [<input_file> ...]\n";
+    cerr << "\t-j N: use N threads to process the parts\n";
+    cerr << "\t-m MB: memory limit of the part cache (default: 256)\n";
+    cerr << "\t-c: merge the shapes of the assembly by material\n";
+    cerr << "\t-i: write each part once and place instances via Transform nodes\n";
+    cerr << "\t-s: write assembly statistics to <file>.json\n";
+    cerr << "\t-v: report statistics and peak memory use\n";
     cerr << "Input file consists of an output file specification and\n";
     cerr << "optional global transformation parameters followed by\n";
     cerr << "multiple blocks of part information with the form:\n";
@@ -116,6 +164,7 @@ void printUsage( void )
     cerr << "The output file basename is specified by a 'file:' parameter\n";
     cerr << "which precedes the part information, for example:\n";
     cerr << "\tfile: some_output_file\n";
+    cerr << "Multiple input files may be given; each produces its own output file.\n";
     cerr << "***\n\n";
 }
 
@@ -124,31 +173,209 @@ struct INFO
 {
     std::string name;
     TRANSFORM   tx;
+    ROTATION    rot;    // the parameters of 'tx' for instanced output
+    double      t[3];
+    double      s[3];
     int ln;             // line number
 
     INFO()
     {
         ln = 0;
+
+        for( int i = 0; i < 3; ++i )
+        {
+            t[i] = 0.0;
+            s[i] = 1.0;
+        }
+    }
+};
+
+// read-only view of an entire file; the file is memory mapped
+// where supported and otherwise read into a buffer
+class MAPFILE
+{
+private:
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    std::vector<char> buf;
+#else
+    void* map;
+#endif
+
+public:
+    MAPFILE()
+    {
+        data = NULL;
+        size = 0;
+#ifndef _WIN32
+        map = NULL;
+#endif
+    }
+
+    ~MAPFILE()
+    {
+        Close();
+    }
+
+    bool Open( const std::string& aFileName );
+    void Close( void );
+
+    const char* Data( void ) const
+    {
+        return data;
+    }
+
+    size_t Size( void ) const
+    {
+        return size;
+    }
+};
+
+// A part file held in memory: the text with the coordinate triplets
+// removed, the offset within the text at which each triplet is to be
+// inserted, and the untransformed triplets.
+struct PARTDATA
+{
+    std::string text;
+    std::vector<size_t> ofs;
+    std::vector<double> xyz;
+    int nShapes;            // number of Shape nodes
+    long nFaces;            // number of facets in all coordIndex blocks
+};
+
+// bounding box and feature counts of a part instance or an assembly
+struct STATS
+{
+    double min[3];
+    double max[3];
+    long nVertices;
+    long nFaces;
+    long nShapes;
+
+    STATS()
+    {
+        Reset();
+    }
+
+    void Reset( void )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            min[i] = 1e300;
+            max[i] = -1e300;
+        }
+
+        nVertices = 0;
+        nFaces = 0;
+        nShapes = 0;
+    }
+
+    void Add( double x, double y, double z )
+    {
+        if( x < min[0] ) min[0] = x;
+        if( x > max[0] ) max[0] = x;
+        if( y < min[1] ) min[1] = y;
+        if( y > max[1] ) max[1] = y;
+        if( z < min[2] ) min[2] = z;
+        if( z > max[2] ) max[2] = z;
+    }
+
+    void Merge( const STATS& aStats )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            if( aStats.min[i] < min[i] )
+                min[i] = aStats.min[i];
+
+            if( aStats.max[i] > max[i] )
+                max[i] = aStats.max[i];
+        }
+
+        nVertices += aStats.nVertices;
+        nFaces += aStats.nFaces;
+        nShapes += aStats.nShapes;
+    }
+};
+
+// JSON statistics sidecar of an assembly; the entry of each part is
+// written as soon as the part is processed
+struct STATSLOG
+{
+    std::ofstream file;
+    STATS total;
+    int nParts;
+};
+
+// an entry in the part cache
+struct CACHEENTRY
+{
+    PARTDATA* data;
+    int refs;               // pending uses; referenced parts are never evicted
+    bool loading;           // true while a thread is reading the part
+    unsigned long used;     // time of last use; the oldest parts are evicted first
+
+    CACHEENTRY()
+    {
+        data = NULL;
+        refs = 0;
+        loading = false;
+        used = 0;
+    }
+};
+
+// parsed part files, keyed by file name; when the memory held by the
+// parts exceeds 'limit' bytes the least recently used are evicted
+struct PARTCACHE
+{
+    std::map< std::string, CACHEENTRY > parts;
+    size_t bytes;           // memory held by the cached parts
+    size_t limit;
+    unsigned long clock;
+    int loads;              // number of part files read
+
+    PARTCACHE()
+    {
+        bytes = 0;
+        limit = 256 * 1024 * 1024;
+        clock = 0;
+        loads = 0;
+    }
+
+    ~PARTCACHE()
+    {
+        std::map< std::string, CACHEENTRY >::iterator sp = parts.begin();
+
+        while( sp != parts.end() )
+        {
+            delete sp->second.data;
+            ++sp;
+        }
     }
 };
 
-struct OFS
+// command line options
+struct OPTIONS
 {
-    int ofs;
-    int nest;
-    double x;
-    double y;
-    double z;
-    OFS()
-    {
-        ofs = 0;
-        nest    = 0;
-        x   = 0.0;
-        y   = 0.0;
-        z   = 0.0;
+    int nThreads;           // number of threads used to process the parts
+    bool verbose;           // report statistics for each assembly
+    bool coalesce;          // merge the shapes of the assembly by material
+    bool instance;          // write each part once and USE it for each occurrence
+    bool stats;             // write a JSON statistics sidecar
+
+    OPTIONS()
+    {
+        nThreads = 1;
+        verbose = false;
+        coalesce = false;
+        instance = false;
+        stats = false;
     }
 };
 
+// process a single stitch input file
+int stitch( const char* aFileName, PARTCACHE& cache, const OPTIONS& opts );
+
 // read the output filename and global transform parameters
 int getGlobs( std::ifstream& file, INFO& glob );
 
@@ -165,7 +392,58 @@ int getXYZ( const std::string& val, double* x, double* y, double* z );
 int readInfo( std::ifstream& file, INFO& glob, INFO& info );
 
 // process the input file
-int process( std::ofstream& ofile, INFO& glob, INFO& part );
+int process( std::ofstream& ofile, INFO& glob, INFO& part, PARTCACHE& cache,
+        STATSLOG* log );
+
+// retrieve a part from the cache, reading the file if necessary;
+// the part must be returned via releasePart()
+PARTDATA* acquirePart( const std::string& aFileName, PARTCACHE& cache );
+
+// release a part retrieved via acquirePart() and trim the cache
+void releasePart( const std::string& aFileName, PARTCACHE& cache );
+
+// evict unused parts until the cache is within its limit
+void trimCache( PARTCACHE& cache );
+
+// append the transformed part to the output text; if 'ofile' is not NULL
+// the text is written out whenever it reaches a fixed size and if 'stats'
+// is not NULL the transformed vertices are added to it
+void formatPart( std::string& out, INFO& glob, INFO& part, const PARTDATA& data,
+        std::ofstream* ofile, STATS* stats );
+
+// compute the statistics of a transformed part without formatting it
+void partStats( INFO& glob, INFO& part, const PARTDATA& data, STATS& stats );
+
+// process all parts of an assembly using a pool of threads
+int processAll( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int nThreads, int& nParts, STATSLOG* log );
+
+// read all parts as meshes and write the assembly with one Shape per material
+int processMesh( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int& nParts, STATSLOG* log );
+
+// write each distinct part once and USE it for every occurrence
+int processInstances( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int& nParts, STATSLOG* log );
+
+// open the statistics sidecar of an assembly
+int openStats( STATSLOG& log, const std::string& aFileName, const std::string& aAssembly );
+
+// add the statistics of a part to the sidecar
+void logPart( STATSLOG* log, INFO& part, const STATS& stats );
+
+// write the assembly statistics and close the sidecar
+int closeStats( STATSLOG& log );
+
+// open a Transform node equivalent to the transform of 'info';
+// returns false if the transform is an identity
+bool openTransform( std::string& out, INFO& info, int aTabDepth );
+
+// close a Transform node opened by openTransform()
+void closeTransform( std::string& out, int aTabDepth );
+
+// read and parse a part file
+int loadPart( const std::string& aFileName, PARTDATA& data );
 
 // search for the next ".begin" line
 int nextPart( std::ifstream& file, INFO& glob );
@@ -173,9 +451,13 @@ int nextPart( std::ifstream& file, INFO& glob );
 // create the part name from the filename
 const std::string& getPartName( const std::string& name );
 
-// parse the input line and write data to the output file
-int parsePart( std::ofstream& ofile, INFO& glob,
-        const std::string& line, INFO& part, OFS& ofs );
+// copy a span of text, dropping any comment lines
+void copyText( std::string& text, const char* buf, const char* sp, const char* ep );
+
+// parse a Coordinate block; 'sp' points to the "Coordinate" keyword and
+// on return 'np' points to the first character after the block
+int readCoords( PARTDATA& data, const std::string& name, const char* buf,
+        const char* sp, const char* ep, const char** np );
 
 
 int main( int argc, const char** argv )
@@ -186,17 +468,134 @@ int main( int argc, const char** argv )
         return 0;
     }
 
+    PARTCACHE cache;
+    OPTIONS opts;
+    int ret = 0;
+    int i = 1;
+
+    // options
+    while( i < argc && argv[i][0] == '-' )
+    {
+        if( !strncmp( argv[i], "-j", 2 ) )
+        {
+            const char* val = argv[i][2] ? &argv[i][2] : NULL;
+
+            if( !val && i + 1 < argc )
+                val = argv[++i];
+
+            opts.nThreads = val ? atoi( val ) : 0;
+
+            if( opts.nThreads < 1 || opts.nThreads > 256 )
+            {
+                ERRBLURB;
+                cerr << "invalid number of threads; valid range is 1 .. 256\n";
+                return -1;
+            }
+
+            ++i;
+            continue;
+        }
+
+        if( !strncmp( argv[i], "-m", 2 ) )
+        {
+            const char* val = argv[i][2] ? &argv[i][2] : NULL;
+
+            if( !val && i + 1 < argc )
+                val = argv[++i];
+
+            int mb = val ? atoi( val ) : 0;
+
+            if( mb < 1 || mb > 65536 )
+            {
+                ERRBLURB;
+                cerr << "invalid memory limit; valid range is 1 .. 65536 MB\n";
+                return -1;
+            }
+
+            cache.limit = (size_t) mb * 1024 * 1024;
+            ++i;
+            continue;
+        }
+
+        if( !strcmp( argv[i], "-c" ) )
+        {
+            opts.coalesce = true;
+            ++i;
+            continue;
+        }
+
+        if( !strcmp( argv[i], "-i" ) )
+        {
+            opts.instance = true;
+            ++i;
+            continue;
+        }
+
+        if( !strcmp( argv[i], "-s" ) )
+        {
+            opts.stats = true;
+            ++i;
+            continue;
+        }
+
+        if( !strcmp( argv[i], "-v" ) )
+        {
+            opts.verbose = true;
+            ++i;
+            continue;
+        }
+
+        ERRBLURB;
+        cerr << "unknown option '" << argv[i] << "'\n";
+        printUsage();
+        return -1;
+    }
+
+    if( i >= argc )
+    {
+        printUsage();
+        return 0;
+    }
+
+    if( opts.coalesce && opts.instance )
+    {
+        ERRBLURB;
+        cerr << "options -c and -i are mutually exclusive\n";
+        return -1;
+    }
+
+#ifdef _WIN32
+    if( opts.nThreads > 1 )
+    {
+        cerr << "threads are not supported on this platform; using a single thread\n";
+        opts.nThreads = 1;
+    }
+#endif
+
+    for( ; i < argc; ++i )
+    {
+        if( stitch( argv[i], cache, opts ) )
+            ret = -1;
+    }
+
+    return ret;
+}    // int main()
+
+
+// process a single stitch input file
+int stitch( const char* aFileName, PARTCACHE& cache, const OPTIONS& opts )
+{
     ifstream ifile;
     ofstream    ofile;
     INFO    glob;
     INFO    part;
 
-    ifile.open( argv[1] );
+    ifile.open( aFileName );
 
     if( !ifile.is_open() )
     {
         ERRBLURB;
-        cerr << "could not open file: '" << argv[1] << "'\n";
+        cerr << "could not open file: '" << aFileName << "'\n";
         return -1;
     }
 
@@ -220,33 +619,95 @@ int main( int argc, const char** argv )
     cerr << "partname: " << partname << "\n";
     SetupXForm( partname, ofile, 0 );
 
-    // loop:
-    // read VRML part information
-    // process VRML file
-    // search for next VRML part block
-    while( ( ifile.good() ) && ( !ifile.eof() ) )
+    int nParts = 0;
+    int nLoads = cache.loads;
+    STATSLOG slog;
+    STATSLOG* log = NULL;
+
+    if( opts.stats )
     {
-        if( readInfo( ifile, glob, part ) )
+        if( openStats( slog, glob.name + ".json", ofname ) )
         {
             ofile.close();
             return -1;
         }
 
-        if( process( ofile, glob, part ) )
+        log = &slog;
+    }
+
+    if( opts.coalesce )
+    {
+        if( processMesh( ifile, ofile, glob, cache, nParts, log ) )
+        {
+            ofile.close();
+            return -1;
+        }
+    }
+    else if( opts.instance )
+    {
+        if( processInstances( ifile, ofile, glob, cache, nParts, log ) )
+        {
+            ofile.close();
+            return -1;
+        }
+    }
+    else if( opts.nThreads > 1 )
+    {
+        if( processAll( ifile, ofile, glob, cache, opts.nThreads, nParts, log ) )
         {
             ofile.close();
             return -1;
         }
+    }
+    else
+    {
+        // loop:
+        // read VRML part information
+        // process VRML file
+        // search for next VRML part block
+        while( ( ifile.good() ) && ( !ifile.eof() ) )
+        {
+            if( readInfo( ifile, glob, part ) )
+            {
+                ofile.close();
+                return -1;
+            }
 
-        if( nextPart( ifile, glob ) )
-            break;
+            if( process( ofile, glob, part, cache, log ) )
+            {
+                ofile.close();
+                return -1;
+            }
+
+            ++nParts;
+
+            if( nextPart( ifile, glob ) )
+                break;
+        }
     }
 
     CloseXForm( ofile, 0 );
     ofile.close();
 
+    if( log && closeStats( *log ) )
+        return -1;
+
+    if( opts.verbose )
+    {
+        cerr << ofname << ": " << nParts << " parts, " << cache.loads - nLoads;
+        cerr << " part files read; cache: " << cache.parts.size() << " parts, ";
+        cerr << cache.bytes / 1024 << " KB";
+#ifndef _WIN32
+        struct rusage ru;
+
+        if( !getrusage( RUSAGE_SELF, &ru ) )
+            cerr << "; peak RSS: " << ru.ru_maxrss << " KB";
+#endif
+        cerr << "\n";
+    }
+
     return 0;
-}    // int main()
+}    // int stitch()
 
 
 int getGlobs( std::ifstream& file, INFO& glob )
@@ -358,6 +819,9 @@ int getGlobs( std::ifstream& file, INFO& glob )
                 }
 
                 gtr.Set( tx, ty, tz );
+                glob.t[0] = tx;
+                glob.t[1] = ty;
+                glob.t[2] = tz;
                 continue;
             }
 
@@ -381,6 +845,9 @@ int getGlobs( std::ifstream& file, INFO& glob )
                 }
 
                 gsc.Set( tx, ty, tz );
+                glob.s[0] = tx;
+                glob.s[1] = ty;
+                glob.s[2] = tz;
                 continue;
             }
 
@@ -414,6 +881,7 @@ int getGlobs( std::ifstream& file, INFO& glob )
     glob.tx.SetTranslation( gtr );
     glob.tx.SetRotation( grot );
     glob.tx.SetScale( gsc );
+    glob.rot = grot;
 
     return 0;
 }    // int getGlobs()
@@ -565,6 +1033,12 @@ int readInfo( std::ifstream& file, INFO& glob, INFO& info )
     info.name.clear();
     info.tx.Set( ltr, lrot, lsc );
 
+    for( int i = 0; i < 3; ++i )
+    {
+        info.t[i] = 0.0;
+        info.s[i] = 1.0;
+    }
+
     while( ( file.good() ) && ( !file.eof() ) )
     {
         line.clear();
@@ -652,6 +1126,9 @@ int readInfo( std::ifstream& file, INFO& glob, INFO& info )
                 }
 
                 ltr.Set( tx, ty, tz );
+                info.t[0] = tx;
+                info.t[1] = ty;
+                info.t[2] = tz;
                 continue;
             }
 
@@ -675,6 +1152,9 @@ int readInfo( std::ifstream& file, INFO& glob, INFO& info )
                 }
 
                 lsc.Set( tx, ty, tz );
+                info.s[0] = tx;
+                info.s[1] = ty;
+                info.s[2] = tz;
                 continue;
             }
 
@@ -708,6 +1188,7 @@ int readInfo( std::ifstream& file, INFO& glob, INFO& info )
     info.tx.SetTranslation( ltr );
     info.tx.SetRotation( lrot );
     info.tx.SetScale( lsc );
+    info.rot = lrot;
 
     return 0;
 }    // int readInfo()
@@ -782,419 +1263,1287 @@ const std::string& getPartName( const std::string& name )
 }    // const std::string& getPartName()
 
 
-// process the input file
-int process( std::ofstream& ofile, INFO& glob, INFO& part )
+bool MAPFILE::Open( const std::string& aFileName )
 {
-    string line;
-    ifstream file;
+    Close();
 
-    file.open( part.name.c_str() );
+#ifdef _WIN32
+    std::ifstream file( aFileName.c_str(), std::ios::in | std::ios::binary );
 
     if( !file.is_open() )
-    {
-        ERRBLURB;
-        cerr << "could not open part file: '" << part.name << "'\n";
-        return -1;
-    }
+        return false;
 
-    OFS ofs;
+    file.seekg( 0, std::ios::end );
+    std::streamoff len = file.tellg();
+    file.seekg( 0, std::ios::beg );
 
-    part.ln = 0;
+    if( len < 0 )
+        return false;
 
-    while( ( file.good() ) && ( !file.eof() ) )
+    buf.resize( (size_t) len );
+
+    if( len > 0 && !file.read( &buf[0], len ) )
     {
-        line.clear();
-        getline( file, line );
-        ++part.ln;
+        buf.clear();
+        return false;
+    }
 
-        if( line.empty() )
-        {
-            ofile << "\n";
-            continue;
-        }
+    size = buf.size();
+    data = size ? &buf[0] : "";
+#else
+    int fd = open( aFileName.c_str(), O_RDONLY );
 
-        if( line.c_str()[0] == '#' )
-            continue;                           // skip all comments
+    if( fd < 0 )
+        return false;
 
-        if( parsePart( ofile, glob, line, part, ofs ) )
-            return -1;
-    }
+    struct stat sb;
 
-    if( !ofile.good() )
+    if( fstat( fd, &sb ) < 0 )
     {
-        ERRBLURB;
-        cerr << "problems writing output file\n";
-        return -1;
+        close( fd );
+        return false;
     }
 
-    return 0;
-}    // int process()
+    size = sb.st_size;
+
+    if( size == 0 )
+    {
+        close( fd );
+        data = "";
+        return true;
+    }
 
+    map = mmap( NULL, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
 
-// parse the input line and write data to the output file
-int parsePart( std::ofstream& ofile, INFO& glob,
-        const std::string& line, INFO& part, OFS& fs )
-{
-    if( !fs.ofs )
+    if( map == MAP_FAILED )
     {
-        if( line.find( "Coordinate" ) == string::npos )
-        {
-            ofile << line << "\n";
+        map = NULL;
+        size = 0;
+        return false;
+    }
 
-            if( !ofile.good() )
-            {
-                ERRBLURB;
-                cerr << "problems writing to output file\n";
-                return -1;
-            }
+    madvise( map, size, MADV_SEQUENTIAL );
+    data = (const char*) map;
+#endif
 
-            return 0;
-        }
+    return true;
+}
 
-        fs.ofs = 1;
-    }
 
-    string::const_iterator start = line.begin();
-    string::const_iterator end = line.end();
-    string out;
-    char oc, lc;
+void MAPFILE::Close( void )
+{
+#ifdef _WIN32
+    buf.clear();
+#else
+    if( map )
+        munmap( map, size );
 
-    /*
-     *  Parser states
-     *      0: no special processing; we may write out entire lines
-     *      1: check each character and classify as one of
-     *          {, space, alpha, digit, decimal point
-     *      2: building up triplet0; accept only digits and dots
-     *          until a space is encountered
-     *      3: expect spaces until dot or digit for triplet 1
-     *      4: building up triplet1
-     *      5: expect spaces until dot or digit for triplet 2
-     *      6. building up triplet2
-     */
+    map = NULL;
+#endif
 
-    lc = 0;
+    data = NULL;
+    size = 0;
+}
 
-    while( start != end )
+
+// return the line number of the character at 'pos'
+static int lineNumber( const char* buf, const char* pos )
+{
+    int ln = 1;
+
+    while( buf < pos )
     {
-        oc = *start++;
+        if( *buf++ == '\n' )
+            ++ln;
+    }
 
-        switch( fs.ofs )
-        {
-        case 0:
-            ERRBLURB;
-            cerr << "BUG: unexpected code branch\n";
-            break;
+    return ln;
+}
 
-        case 1:
 
-            /*
-             *  1: check each character and classify as one of
-             *      {, space, alpha, digit, decimal point
-             */
-            if( oc == '{' )
-                ++fs.nest;
+static inline bool isNumChar( char c )
+{
+    return isdigit( c ) || c == '.' || c == '+' || c == '-';
+}
 
-            if( oc == '}' )
-            {
-                --fs.nest;
 
-                if( fs.nest < 0 )
-                {
-                    ERRBLURB;
-                    cerr << "BUG: OFS.nest < 0 at line " << part.ln << "\n";
-                    cerr << "\tinput file: " << part.name << "\n";
-                    return -1;
-                }
+static inline bool isExpChar( char c )
+{
+    return isNumChar( c ) || c == 'e' || c == 'E';
+}
 
-                if( !fs.nest )
-                {
-                    out += oc;
 
-                    while( start != end )
-                        out += *start++;
+// skip to the start of the next line
+static inline const char* nextLine( const char* sp, const char* ep )
+{
+    const char* cp = (const char*) memchr( sp, '\n', ep - sp );
 
-                    ofile << out << "\n";
+    return cp ? cp + 1 : ep;
+}
 
-                    if( !ofile.good() )
-                    {
-                        ERRBLURB;
-                        cerr << "problems writing to output file\n";
-                        return -1;
-                    }
 
-                    fs.ofs = 0;
-                    return 0;
-                }
-            }
+// skip whitespace and comment lines
+static const char* skipSpace( const char* buf, const char* sp, const char* ep )
+{
+    while( sp < ep )
+    {
+        if( *sp == '#' && ( sp == buf || sp[-1] == '\n' ) )
+        {
+            sp = nextLine( sp, ep );
+            continue;
+        }
 
-            if( ( isdigit( oc ) ) || (oc == '.') || (oc == '+') || (oc == '-') )
-            {
-                if( !isalpha( lc ) )
-                {
-                    ofile << out;
+        if( !isspace( *sp ) )
+            break;
 
-                    if( !ofile.good() )
-                    {
-                        ERRBLURB;
-                        cerr << "problems writing output file\n";
-                        return -1;
-                    }
+        ++sp;
+    }
 
-                    out.clear();
-                    fs.ofs = 2;    // start of the first triplet
-                }
-            }
+    return sp;
+}
+
+
+// convert a number starting at 'sp'; on return 'np' points to the first
+// character which is not part of the number
+static bool readNumber( const char* sp, const char* ep, const char** np, double& val )
+{
+    char tmp[64];
+    const char* cp = sp;
+
+    while( cp < ep && isExpChar( *cp ) )
+        ++cp;
+
+    size_t len = cp - sp;
+
+    if( len == 0 || len >= sizeof( tmp ) )
+        return false;
+
+    memcpy( tmp, sp, len );
+    tmp[len] = 0;
+
+    char* tp;
+    val = strtod( tmp, &tp );
 
-            // let all other characters filter through
-            out += oc;
-            lc  = oc;
+    if( tp == tmp )
+        return false;
+
+    *np = cp;
+    return true;
+}
+
+
+// count the Shape nodes of a part and the facets of its coordIndex blocks;
+// the text of a part contains no comments
+static void countFeatures( PARTDATA& data )
+{
+    const char* buf = data.text.c_str();
+    const char* cp = buf;
+
+    data.nShapes = 0;
+    data.nFaces = 0;
+
+    while( *cp )
+    {
+        if( cp > buf && ( isalnum( cp[-1] ) || cp[-1] == '_' ) )
+        {
+            ++cp;
+            continue;
+        }
+
+        if( !strncmp( cp, "Shape", 5 ) && !isalnum( cp[5] ) && cp[5] != '_' )
+        {
+            ++data.nShapes;
+            cp += 5;
+            continue;
+        }
+
+        if( strncmp( cp, "coordIndex", 10 ) )
+        {
+            ++cp;
             continue;
+        }
+
+        cp = strchr( cp, '[' );
+
+        if( !cp )
             break;
 
-        case 2:
+        // a facet is terminated by -1 or by the end of the list
+        bool open = false;
 
-            /*
-             *  2: building up triplet0; accept only digits and dots
-             *      until a space is encountered
-             */
-            if( isspace( oc ) )
+        while( *cp && *cp != ']' )
+        {
+            if( *cp != '-' && !isdigit( *cp ) )
             {
-                istringstream os;
-                os.str( out );
-                os >> fs.x;
-                out.clear();
-                fs.ofs = 3;     // eat spaces in anticipation of triplet1
-                lc = ' ';
+                ++cp;
                 continue;
             }
 
-            if( ( !isdigit( oc ) ) && (oc != '.') && (oc != '+') && (oc != '-')
-                && (oc != 'e') && (oc != 'E') )
+            char* np;
+            long v = strtol( cp, &np, 10 );
+
+            if( np == cp )
             {
-                ERRBLURB;
-                cerr << "problems parsing triplet0 for transformation at line " << part.ln << "\n";
-                cerr << "\tinput file: " << part.name << "\n";
-                return -1;
+                ++cp;
+                continue;
             }
 
-            out += oc;
-            lc  = oc;
-            break;
+            cp = np;
+
+            if( v >= 0 )
+            {
+                open = true;
+            }
+            else if( open )
+            {
+                ++data.nFaces;
+                open = false;
+            }
+        }
+
+        if( open )
+            ++data.nFaces;
+    }
+}
+
+
+// locate the next "Coordinate" keyword which is not within a comment line
+static const char* findCoord( const char* buf, const char* sp, const char* ep )
+{
+    static const char key[] = "Coordinate";
+    const size_t klen = sizeof( key ) - 1;
+
+    while( (size_t)( ep - sp ) >= klen )
+    {
+        const char* cp = (const char*) memchr( sp, 'C', ep - sp - klen + 1 );
+
+        if( !cp )
+            return ep;
+
+        if( memcmp( cp, key, klen ) )
+        {
+            sp = cp + 1;
+            continue;
+        }
+
+        // find the start of the line and reject comments
+        const char* lp = cp;
+
+        while( lp > buf && lp[-1] != '\n' )
+            --lp;
+
+        if( *lp == '#' )
+        {
+            sp = nextLine( cp, ep );
+            continue;
+        }
+
+        return cp;
+    }
+
+    return ep;
+}
+
+
+// process the input file
+int process( std::ofstream& ofile, INFO& glob, INFO& part, PARTCACHE& cache,
+        STATSLOG* log )
+{
+    PARTDATA* data = acquirePart( part.name, cache );
+
+    if( !data )
+        return -1;
+
+    std::string out;
+    STATS stats;
+    formatPart( out, glob, part, *data, &ofile, log ? &stats : NULL );
+    ofile.write( out.data(), out.size() );
+    releasePart( part.name, cache );
+    logPart( log, part, stats );
+
+    if( !ofile.good() )
+    {
+        ERRBLURB;
+        cerr << "problems writing output file\n";
+        return -1;
+    }
+
+    return 0;
+}    // int process()
+
+
+// approximate memory held by a parsed part
+static size_t partSize( const PARTDATA& data )
+{
+    return sizeof( PARTDATA ) + data.text.capacity()
+           + data.ofs.capacity() * sizeof( size_t )
+           + data.xyz.capacity() * sizeof( double );
+}
+
+
+// retrieve a part from the cache, reading the file if necessary
+PARTDATA* acquirePart( const std::string& aFileName, PARTCACHE& cache )
+{
+    std::map< std::string, CACHEENTRY >::iterator ip = cache.parts.find( aFileName );
+
+    if( ip != cache.parts.end() )
+    {
+        ++ip->second.refs;
+        ip->second.used = ++cache.clock;
+        return ip->second.data;
+    }
+
+    PARTDATA* data = new (nothrow) PARTDATA;
+
+    if( !data )
+    {
+        ERRBLURB;
+        cerr << "could not allocate memory for part data\n";
+        return NULL;
+    }
+
+    ++cache.loads;
+
+    if( loadPart( aFileName, *data ) )
+    {
+        delete data;
+        return NULL;
+    }
 
-        case 3:
+    CACHEENTRY& entry = cache.parts[aFileName];
+    entry.data = data;
+    entry.refs = 1;
+    entry.used = ++cache.clock;
+    cache.bytes += partSize( *data );
 
-            /*  3: expect spaces until dot or digit for triplet 1 */
-            if( isspace( oc ) )
+    return data;
+}    // PARTDATA* acquirePart()
+
+
+// release a part retrieved via acquirePart() and trim the cache
+void releasePart( const std::string& aFileName, PARTCACHE& cache )
+{
+    std::map< std::string, CACHEENTRY >::iterator ip = cache.parts.find( aFileName );
+
+    if( ip == cache.parts.end() )
+        return;
+
+    --ip->second.refs;
+    trimCache( cache );
+}    // void releasePart()
+
+
+// evict unused parts until the cache is within its limit
+void trimCache( PARTCACHE& cache )
+{
+    while( cache.bytes > cache.limit )
+    {
+        std::map< std::string, CACHEENTRY >::iterator sp = cache.parts.begin();
+        std::map< std::string, CACHEENTRY >::iterator ep = cache.parts.end();
+        std::map< std::string, CACHEENTRY >::iterator op = ep;
+
+        for( ; sp != ep; ++sp )
+        {
+            if( sp->second.refs > 0 || sp->second.loading )
                 continue;
 
-            if( ( isdigit( oc ) ) || (oc == '.') || (oc == '+') || (oc == '-') )
+            if( op == ep || sp->second.used < op->second.used )
+                op = sp;
+        }
+
+        // all remaining parts are in use
+        if( op == ep )
+            return;
+
+        cache.bytes -= partSize( *op->second.data );
+        delete op->second.data;
+        cache.parts.erase( op );
+    }
+}    // void trimCache()
+
+
+// size of the chunks in which a part is written out
+#define OUTCHUNK ( 64 * 1024 )
+
+// append the transformed part to the output text
+void formatPart( std::string& out, INFO& glob, INFO& part, const PARTDATA& data,
+        std::ofstream* ofile, STATS* stats )
+{
+    const char* tp = data.text.data();
+    size_t np = data.ofs.size();
+    size_t last = 0;
+    double x, y, z;
+    char tmp[128];
+
+    if( ofile )
+        out.reserve( OUTCHUNK + sizeof( tmp ) );
+    else
+        out.reserve( out.size() + data.text.size() + np * 24 );
+
+    for( size_t i = 0; i < np; ++i )
+    {
+        out.append( tp + last, data.ofs[i] - last );
+        last = data.ofs[i];
+
+        x = data.xyz[3 * i];
+        y = data.xyz[3 * i + 1];
+        z = data.xyz[3 * i + 2];
+
+        part.tx.Transform( &x, &y, &z, 1 );
+        glob.tx.Transform( &x, &y, &z, 1 );
+
+        if( (x < 1e-9) && (x > -1e-9) )
+            x = 0.0;
+
+        if( (y < 1e-9) && (y > -1e-9) )
+            y = 0.0;
+
+        if( (z < 1e-9) && (z > -1e-9) )
+            z = 0.0;
+
+        int len = snprintf( tmp, sizeof( tmp ), "%.8g %.8g %.8g", x, y, z );
+        out.append( tmp, len );
+
+        if( stats )
+            stats->Add( x, y, z );
+
+        if( ofile && out.size() >= OUTCHUNK )
+        {
+            ofile->write( out.data(), out.size() );
+            out.clear();
+        }
+    }
+
+    out.append( tp + last, data.text.size() - last );
+
+    if( stats )
+    {
+        stats->nVertices += np;
+        stats->nFaces += data.nFaces;
+        stats->nShapes += data.nShapes;
+    }
+}    // void formatPart()
+
+
+// compute the statistics of a transformed part without formatting it
+void partStats( INFO& glob, INFO& part, const PARTDATA& data, STATS& stats )
+{
+    size_t np = data.ofs.size();
+    double x, y, z;
+
+    for( size_t i = 0; i < np; ++i )
+    {
+        x = data.xyz[3 * i];
+        y = data.xyz[3 * i + 1];
+        z = data.xyz[3 * i + 2];
+
+        part.tx.Transform( &x, &y, &z, 1 );
+        glob.tx.Transform( &x, &y, &z, 1 );
+        stats.Add( x, y, z );
+    }
+
+    stats.nVertices += np;
+    stats.nFaces += data.nFaces;
+    stats.nShapes += data.nShapes;
+}    // void partStats()
+
+
+#ifndef _WIN32
+
+// A slot holds one part between the time its information is read from the
+// input file and the time its output is written.
+struct STITCHSLOT
+{
+    INFO info;
+    std::string out;
+    STATS stats;
+    int state;              // 0: free, 1: queued, 2: working, 3: done, 4: failed
+};
+
+// State shared by the threads of processAll(). The main thread reads part
+// blocks into a ring of slots and writes the output of the slots in input
+// order; the number of slots bounds the memory used by pending output.
+struct STITCHJOB
+{
+    INFO* glob;
+    PARTCACHE* cache;
+    bool stats;             // collect statistics of each part
+    std::vector<STITCHSLOT> slots;
+    size_t head;            // sequence number of the next part to be written
+    size_t tail;            // sequence number of the next part to be read
+    size_t next;            // sequence number of the next part to be formatted
+    bool finished;          // no more parts will be queued
+    pthread_mutex_t lock;
+    pthread_cond_t work;    // signalled when a part is queued or the job is finished
+    pthread_cond_t ready;   // signalled when a part is formatted or loaded
+};
+
+
+// retrieve a part from the cache while holding the job lock; the lock is
+// released while a part file is being read
+static PARTDATA* acquireShared( STITCHJOB* job, const std::string& aFileName )
+{
+    PARTCACHE& cache = *job->cache;
+    std::map< std::string, CACHEENTRY >::iterator ip = cache.parts.find( aFileName );
+
+    while( ip != cache.parts.end() && ip->second.loading )
+    {
+        pthread_cond_wait( &job->ready, &job->lock );
+        ip = cache.parts.find( aFileName );
+    }
+
+    if( ip != cache.parts.end() )
+    {
+        ++ip->second.refs;
+        ip->second.used = ++cache.clock;
+        return ip->second.data;
+    }
+
+    // another thread waiting for this part will find the loading entry
+    CACHEENTRY& entry = cache.parts[aFileName];
+    entry.loading = true;
+    entry.refs = 1;
+    ++cache.loads;
+    pthread_mutex_unlock( &job->lock );
+
+    PARTDATA* data = new (nothrow) PARTDATA;
+
+    if( data && loadPart( aFileName, *data ) )
+    {
+        delete data;
+        data = NULL;
+    }
+
+    pthread_mutex_lock( &job->lock );
+    ip = cache.parts.find( aFileName );
+
+    if( data )
+    {
+        ip->second.data = data;
+        ip->second.loading = false;
+        ip->second.used = ++cache.clock;
+        cache.bytes += partSize( *data );
+    }
+    else
+    {
+        cache.parts.erase( ip );
+    }
+
+    pthread_cond_broadcast( &job->ready );
+
+    return data;
+}
+
+
+static void* stitchWorker( void* arg )
+{
+    STITCHJOB* job = (STITCHJOB*) arg;
+    size_t nslots = job->slots.size();
+    std::string out;
+    STATS stats;
+    size_t i;
+
+    pthread_mutex_lock( &job->lock );
+
+    while( true )
+    {
+        while( job->next == job->tail && !job->finished )
+            pthread_cond_wait( &job->work, &job->lock );
+
+        if( job->next == job->tail )
+            break;
+
+        i = job->next++ % nslots;
+        STITCHSLOT& slot = job->slots[i];
+        slot.state = 2;
+
+        PARTDATA* data = acquireShared( job, slot.info.name );
+
+        if( !data )
+        {
+            slot.state = 4;
+            pthread_cond_broadcast( &job->ready );
+            continue;
+        }
+
+        pthread_mutex_unlock( &job->lock );
+
+        out.clear();
+        stats.Reset();
+        formatPart( out, *job->glob, slot.info, *data, NULL, job->stats ? &stats : NULL );
+
+        pthread_mutex_lock( &job->lock );
+        slot.out.swap( out );
+        slot.stats = stats;
+        slot.state = 3;
+        releasePart( slot.info.name, *job->cache );
+        pthread_cond_broadcast( &job->ready );
+    }
+
+    pthread_mutex_unlock( &job->lock );
+
+    return NULL;
+}
+
+
+// process all parts of an assembly using a pool of threads; each part is
+// formatted into its own buffer and the buffers are written in input order
+int processAll( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int nThreads, int& nParts, STATSLOG* log )
+{
+    STITCHJOB job;
+    INFO part;
+    bool eof = false;
+    int ret = 0;
+
+    job.glob = &glob;
+    job.cache = &cache;
+    job.stats = log != NULL;
+    job.slots.resize( 4 * nThreads );
+    job.head = 0;
+    job.tail = 0;
+    job.next = 0;
+    job.finished = false;
+    pthread_mutex_init( &job.lock, NULL );
+    pthread_cond_init( &job.work, NULL );
+    pthread_cond_init( &job.ready, NULL );
+
+    for( size_t i = 0; i < job.slots.size(); ++i )
+        job.slots[i].state = 0;
+
+    std::vector<pthread_t> tid( nThreads );
+    int nt = 0;
+
+    for( ; nt < nThreads; ++nt )
+    {
+        if( pthread_create( &tid[nt], NULL, stitchWorker, &job ) )
+            break;
+    }
+
+    if( nt == 0 )
+    {
+        ERRBLURB;
+        cerr << "could not create any threads\n";
+        ret = -1;
+        eof = true;
+    }
+
+    while( true )
+    {
+        // queue parts until all slots are occupied
+        while( !eof && job.tail - job.head < job.slots.size() )
+        {
+            if( readInfo( ifile, glob, part ) )
             {
-                out += oc;
-                lc  = oc;
-                fs.ofs = 4;
-                continue;
+                ret = -1;
+                eof = true;
+                break;
             }
 
-            ERRBLURB;
-            cerr << "unexpected character at line " << part.ln << "\n";
-            cerr << "\tinput file: " << part.name << "\n";
-            return -1;
+            pthread_mutex_lock( &job.lock );
+            STITCHSLOT& slot = job.slots[job.tail % job.slots.size()];
+            slot.info = part;
+            slot.state = 1;
+            ++job.tail;
+            pthread_cond_signal( &job.work );
+            pthread_mutex_unlock( &job.lock );
+
+            if( nextPart( ifile, glob ) )
+                eof = true;
+        }
+
+        if( job.head == job.tail )
             break;
 
-        case 4:
+        // write out the oldest part
+        pthread_mutex_lock( &job.lock );
+        STITCHSLOT& slot = job.slots[job.head % job.slots.size()];
+
+        while( slot.state < 3 )
+            pthread_cond_wait( &job.ready, &job.lock );
+
+        pthread_mutex_unlock( &job.lock );
+
+        if( slot.state == 4 )
+            ret = -1;
 
-            /*
-             *  4: building up triplet1; accept only digits and dots
-             *      until a space is encountered
-             */
-            if( isspace( oc ) )
+        if( !ret )
+        {
+            ofile.write( slot.out.data(), slot.out.size() );
+            logPart( log, slot.info, slot.stats );
+            ++nParts;
+
+            if( !ofile.good() )
             {
-                istringstream os;
-                os.str( out );
-                os >> fs.y;
-                out.clear();
-                fs.ofs = 5;     // eat spaces in anticipation of triplet2
-                lc = ' ';
-                continue;
+                ERRBLURB;
+                cerr << "problems writing output file\n";
+                ret = -1;
             }
+        }
+
+        // on failure stop reading and drain the queued parts
+        if( ret )
+            eof = true;
+
+        std::string().swap( slot.out );
+
+        pthread_mutex_lock( &job.lock );
+        slot.state = 0;
+        ++job.head;
+        pthread_mutex_unlock( &job.lock );
+    }
+
+    pthread_mutex_lock( &job.lock );
+    job.finished = true;
+    pthread_cond_broadcast( &job.work );
+    pthread_mutex_unlock( &job.lock );
+
+    for( int j = 0; j < nt; ++j )
+        pthread_join( tid[j], NULL );
+
+    pthread_mutex_destroy( &job.lock );
+    pthread_cond_destroy( &job.work );
+    pthread_cond_destroy( &job.ready );
+
+    return ret;
+}    // int processAll()
+
+#else
+
+// threads are not supported; process the parts in sequence
+int processAll( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int nThreads, int& nParts, STATSLOG* log )
+{
+    INFO part;
+
+    while( ( ifile.good() ) && ( !ifile.eof() ) )
+    {
+        if( readInfo( ifile, glob, part ) )
+            return -1;
+
+        if( process( ofile, glob, part, cache, log ) )
+            return -1;
+
+        ++nParts;
+
+        if( nextPart( ifile, glob ) )
+            break;
+    }
+
+    return 0;
+}    // int processAll()
+
+#endif  // _WIN32
+
 
-            if( ( !isdigit( oc ) ) && (oc != '.') && (oc != '+') && (oc != '-')
-                && (oc != 'e') && (oc != 'E') )
+// read all parts as meshes and write the assembly with one Shape per material
+int processMesh( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int& nParts, STATSLOG* log )
+{
+    // each part file is read once
+    std::map< std::string, VRMLMESH* > meshes;
+    VRMLMESH assembly;
+    INFO part;
+    int ret = 0;
+
+    while( ( ifile.good() ) && ( !ifile.eof() ) )
+    {
+        if( readInfo( ifile, glob, part ) )
+        {
+            ret = -1;
+            break;
+        }
+
+        VRMLMESH*& mp = meshes[part.name];
+
+        if( !mp )
+        {
+            mp = new (nothrow) VRMLMESH;
+            ++cache.loads;
+
+            if( !mp )
             {
                 ERRBLURB;
-                cerr << "problems parsing triplet1 for transformation at line " << part.ln << "\n";
-                cerr << "\tinput file: " << part.name << "\n";
-                return -1;
+                cerr << "could not allocate memory for part mesh\n";
+                ret = -1;
+                break;
+            }
+
+            if( mp->Read( part.name ) )
+            {
+                ret = -1;
+                break;
             }
+        }
+
+        int first = assembly.GetNShapes();
+        assembly.Append( *mp );
+        assembly.Transform( part.tx, first );
+        assembly.Transform( glob.tx, first );
+        ++nParts;
+
+        if( log )
+        {
+            STATS stats;
+
+            for( int j = first; j < assembly.GetNShapes(); ++j )
+            {
+                VRMLSHAPE* sp = assembly.GetShape( j );
+
+                for( size_t k = 0; k < sp->x.size(); ++k )
+                    stats.Add( sp->x[k], sp->y[k], sp->z[k] );
 
-            out += oc;
-            lc  = oc;
+                stats.nVertices += sp->x.size();
+                stats.nFaces += std::count( sp->index.begin(), sp->index.end(), -1 );
+                ++stats.nShapes;
+            }
+
+            logPart( log, part, stats );
+        }
+
+        if( nextPart( ifile, glob ) )
             break;
+    }
 
-        case 5:
+    std::map< std::string, VRMLMESH* >::iterator sp = meshes.begin();
+
+    while( sp != meshes.end() )
+    {
+        delete sp->second;
+        ++sp;
+    }
+
+    if( ret )
+        return -1;
+
+    assembly.Coalesce();
+
+    return assembly.Write( ofile, 2 );
+}    // int processMesh()
 
-            /*  5: expect spaces until dot or digit for triplet 2 */
-            if( isspace( oc ) )
-                continue;
 
-            if( ( isdigit( oc ) ) || (oc == '.') || (oc == '+') || (oc == '-') )
+// write each distinct part once and USE it for every occurrence
+int processInstances( std::ifstream& ifile, std::ofstream& ofile, INFO& glob,
+        PARTCACHE& cache, int& nParts, STATSLOG* log )
+{
+    // DEF names of the parts written so far, keyed by file name
+    std::map< std::string, std::string > defs;
+    INFO ident;
+    INFO part;
+    std::string out;
+
+    // the global transform encloses all parts
+    int depth = 2;
+    bool hasGlob = openTransform( out, glob, depth );
+
+    if( hasGlob )
+        depth += 2;
+
+    while( ( ifile.good() ) && ( !ifile.eof() ) )
+    {
+        if( readInfo( ifile, glob, part ) )
+            return -1;
+
+        int pdepth = depth;
+
+        if( openTransform( out, part, depth ) )
+            pdepth += 2;
+
+        string fmt( pdepth * 4, ' ' );
+        std::map< std::string, std::string >::iterator di = defs.find( part.name );
+
+        PARTDATA* data = NULL;
+
+        if( log || di == defs.end() )
+        {
+            data = acquirePart( part.name, cache );
+
+            if( !data )
+                return -1;
+
+            if( log )
             {
-                out += oc;
-                lc  = oc;
-                fs.ofs = 6;
-                continue;
+                STATS stats;
+                partStats( glob, part, *data, stats );
+                logPart( log, part, stats );
             }
+        }
 
+        if( di != defs.end() )
+        {
+            out += fmt + "USE " + di->second + "\n";
+        }
+        else
+        {
+            ostringstream ostr;
+            ostr << "PART" << defs.size() << "_" << getPartName( part.name ).substr( 5 );
+            defs[part.name] = ostr.str();
+
+            out += fmt + "DEF " + ostr.str() + " Group {\n";
+            out += fmt + "    children [\n";
+            formatPart( out, ident, ident, *data, &ofile, NULL );
+            out += fmt + "    ]\n";
+            out += fmt + "}\n";
+        }
+
+        if( data )
+            releasePart( part.name, cache );
+
+        if( pdepth > depth )
+            closeTransform( out, depth );
+
+        ofile.write( out.data(), out.size() );
+        out.clear();
+        ++nParts;
+
+        if( !ofile.good() )
+        {
             ERRBLURB;
-            cerr << "unexpected character at line " << part.ln << "\n";
-            cerr << "\tinput file: " << part.name << "\n";
+            cerr << "problems writing output file\n";
             return -1;
+        }
+
+        if( nextPart( ifile, glob ) )
             break;
+    }
 
-        case 6:
+    if( hasGlob )
+    {
+        closeTransform( out, depth - 2 );
+        ofile.write( out.data(), out.size() );
+    }
 
-            /* 6: building up triplet2 */
-            if( ( !isdigit( oc ) ) && (oc != '.') && (oc != '+') && (oc != '-')
-                && (oc != 'e') && (oc != 'E') )
-            {
-                istringstream os;
-                os.str( out );
-                os >> fs.z;
-                out.clear();
-                // write out the transformed triplet
-                part.tx.Transform( &fs.x, &fs.y, &fs.z, 1 );
-                glob.tx.Transform( &fs.x, &fs.y, &fs.z, 1 );
+    return ofile.good() ? 0 : -1;
+}    // int processInstances()
 
-                if( (fs.x < 1e-9) && (fs.x > -1e-9) )
-                    fs.x = 0.0;
 
-                if( (fs.y < 1e-9) && (fs.y > -1e-9) )
-                    fs.y = 0.0;
+// open a Transform node equivalent to the transform of 'info'
+bool openTransform( std::string& out, INFO& info, int aTabDepth )
+{
+    bool hasT = info.t[0] != 0.0 || info.t[1] != 0.0 || info.t[2] != 0.0;
+    bool hasS = info.s[0] != 1.0 || info.s[1] != 1.0 || info.s[2] != 1.0;
+    bool hasR = !info.rot.IsUnity();
 
-                if( (fs.z < 1e-9) && (fs.z > -1e-9) )
-                    fs.z = 0.0;
+    if( !hasT && !hasS && !hasR )
+        return false;
 
-                ofile << setprecision( 8 ) << fs.x << " " << fs.y << " " << fs.z;
+    string fmt( aTabDepth * 4, ' ' );
+    char tmp[128];
 
-                if( !ofile.good() )
-                {
-                    ERRBLURB;
-                    cerr << "problems writing output file\n";
-                    return -1;
-                }
+    out += fmt + "Transform {\n";
 
-                out += oc;
-                fs.ofs = 1;
-                lc = 0;
+    if( hasT )
+    {
+        snprintf( tmp, sizeof( tmp ), "    translation %.8g %.8g %.8g\n",
+                  info.t[0], info.t[1], info.t[2] );
+        out += fmt + tmp;
+    }
 
-                if( oc == '}' )
-                {
-                    --fs.nest;
+    if( hasR )
+    {
+        // the rotation as normalized by ROTATION
+        QUAT r = info.rot.Get();
+        snprintf( tmp, sizeof( tmp ), "    rotation %.8g %.8g %.8g %.8g\n",
+                  r.x, r.y, r.z, r.w );
+        out += fmt + tmp;
+    }
 
-                    if( !fs.nest )
-                    {
-                        while( start != end )
-                            out += *start++;
+    if( hasS )
+    {
+        snprintf( tmp, sizeof( tmp ), "    scale %.8g %.8g %.8g\n",
+                  info.s[0], info.s[1], info.s[2] );
+        out += fmt + tmp;
+    }
 
-                        ofile << out << "\n";
-                        fs.ofs = 0;
+    out += fmt + "    children [\n";
 
-                        if( !ofile.good() )
-                        {
-                            ERRBLURB;
-                            cerr << "problems writing output file\n";
-                            return -1;
-                        }
+    return true;
+}    // bool openTransform()
 
-                        return 0;
-                    }
-                }
 
-                continue;
-            }
+// close a Transform node opened by openTransform()
+void closeTransform( std::string& out, int aTabDepth )
+{
+    string fmt( aTabDepth * 4, ' ' );
+
+    out += fmt + "    ]\n";
+    out += fmt + "}\n";
+}    // void closeTransform()
 
-            out += oc;
-            lc  = oc;
-            break;
-        }
-    }    // while (start != end)
 
-    switch( fs.ofs )
+// write a string as a JSON string literal
+static void writeJSONString( std::ofstream& file, const std::string& aString )
+{
+    file << '"';
+
+    for( size_t i = 0; i < aString.size(); ++i )
     {
-    case 2:
+        unsigned char c = aString[i];
 
-        do
+        if( c == '"' || c == '\\' )
         {
-            istringstream os;
-            os.str( out );
-            os >> fs.x;
-            out.clear();
-            fs.ofs = 3;     // eat spaces in anticipation of triplet1
-        } while( 0 );
+            file << '\\' << c;
+        }
+        else if( c < 0x20 )
+        {
+            char tmp[8];
+            snprintf( tmp, sizeof( tmp ), "\\u%04x", c );
+            file << tmp;
+        }
+        else
+        {
+            file << c;
+        }
+    }
 
-        break;
+    file << '"';
+}
 
-    case 4:
 
-        do
-        {
-            istringstream os;
-            os.str( out );
-            os >> fs.y;
-            out.clear();
-            fs.ofs = 5;     // eat spaces in anticipation of triplet1
-        } while( 0 );
+// write the bounding box and the counts of a STATS object as JSON members
+static void writeJSONStats( std::ofstream& file, const STATS& stats, const char* indent )
+{
+    file << indent << "\"vertices\": " << stats.nVertices << ",\n";
+    file << indent << "\"faces\": " << stats.nFaces << ",\n";
+    file << indent << "\"shapes\": " << stats.nShapes << ",\n";
+
+    if( stats.nVertices == 0 )
+    {
+        file << indent << "\"min\": null,\n";
+        file << indent << "\"max\": null\n";
+        return;
+    }
+
+    char tmp[128];
+
+    snprintf( tmp, sizeof( tmp ), "\"min\": [ %.8g, %.8g, %.8g ],\n",
+              stats.min[0], stats.min[1], stats.min[2] );
+    file << indent << tmp;
+    snprintf( tmp, sizeof( tmp ), "\"max\": [ %.8g, %.8g, %.8g ]\n",
+              stats.max[0], stats.max[1], stats.max[2] );
+    file << indent << tmp;
+}
 
-        break;
 
-    case 6:
+// open the statistics sidecar of an assembly
+int openStats( STATSLOG& log, const std::string& aFileName, const std::string& aAssembly )
+{
+    log.file.open( aFileName.c_str() );
+
+    if( !log.file.is_open() )
+    {
+        ERRBLURB;
+        cerr << "could not open statistics file: '" << aFileName << "'\n";
+        return -1;
+    }
+
+    log.total.Reset();
+    log.nParts = 0;
+
+    log.file << "{\n    \"assembly\": ";
+    writeJSONString( log.file, aAssembly );
+    log.file << ",\n    \"parts\": [";
+
+    return log.file.good() ? 0 : -1;
+}    // int openStats()
+
+
+// add the statistics of a part to the sidecar
+void logPart( STATSLOG* log, INFO& part, const STATS& stats )
+{
+    if( !log )
+        return;
+
+    log->file << ( log->nParts ? ",\n" : "\n" ) << "        {\n";
+    log->file << "            \"name\": ";
+    writeJSONString( log->file, part.name );
+    log->file << ",\n";
+    writeJSONStats( log->file, stats, "            " );
+    log->file << "        }";
+
+    log->total.Merge( stats );
+    ++log->nParts;
+}    // void logPart()
+
+
+// write the assembly statistics and close the sidecar
+int closeStats( STATSLOG& log )
+{
+    log.file << ( log.nParts ? "\n    ],\n" : "],\n" );
+    log.file << "    \"count\": " << log.nParts << ",\n";
+    writeJSONStats( log.file, log.total, "    " );
+    log.file << "}\n";
+
+    if( !log.file.good() )
+    {
+        ERRBLURB;
+        cerr << "problems writing statistics file\n";
+        log.file.close();
+        return -1;
+    }
+
+    log.file.close();
+
+    return 0;
+}    // int closeStats()
+
+
+// read and parse a part file
+int loadPart( const std::string& aFileName, PARTDATA& data )
+{
+    MAPFILE file;
+
+    if( !file.Open( aFileName ) )
+    {
+        ERRBLURB;
+        cerr << "could not open part file: '" << aFileName << "'\n";
+        return -1;
+    }
+
+    const char* buf = file.Data();
+    const char* sp = buf;
+    const char* ep = buf + file.Size();
+    const char* cp;
+
+    data.text.clear();
+    data.ofs.clear();
+    data.xyz.clear();
+    data.text.reserve( file.Size() / 2 );
+
+    while( sp < ep )
+    {
+        cp = findCoord( buf, sp, ep );
+        copyText( data.text, buf, sp, cp );
 
-        do
+        if( cp == ep )
+            break;
+
+        if( readCoords( data, aFileName, buf, cp, ep, &sp ) )
+            return -1;
+    }
+
+    // terminate the final line or, if it is already terminated,
+    // add a blank line to separate the parts
+    data.text += "\n";
+    countFeatures( data );
+
+    return 0;
+}    // int loadPart()
+
+
+// copy a span of text, dropping any comment lines
+void copyText( std::string& text, const char* buf, const char* sp, const char* ep )
+{
+    const char* cp;
+
+    while( sp < ep )
+    {
+        if( *sp == '#' && ( sp == buf || sp[-1] == '\n' ) )
         {
-            istringstream os;
-            os.str( out );
-            os >> fs.z;
-            fs.ofs = 1;
-            part.tx.Transform( &fs.x, &fs.y, &fs.z, 1 );
-            glob.tx.Transform( &fs.x, &fs.y, &fs.z, 1 );
+            sp = nextLine( sp, ep );
+            continue;
+        }
 
-            if( (fs.x < 1e-9) && (fs.x > -1e-9) )
-                fs.x = 0.0;
+        // copy up to the start of the next comment line
+        cp = sp;
 
-            if( (fs.y < 1e-9) && (fs.y > -1e-9) )
-                fs.y = 0.0;
+        while( cp < ep )
+        {
+            cp = nextLine( cp, ep );
 
-            if( (fs.z < 1e-9) && (fs.z > -1e-9) )
-                fs.z = 0.0;
+            if( cp < ep && *cp == '#' )
+                break;
+        }
 
-            ofile << setprecision( 8 ) << fs.x << " " << fs.y << " " << fs.z;
+        text.append( sp, cp - sp );
+        sp = cp;
+    }
+}    // void copyText()
 
-            if( !ofile.good() )
-            {
-                ERRBLURB;
-                cerr << "problems writing output file\n";
-                return -1;
-            }
-        } while( 0 );
 
-        break;
+// parse a Coordinate block
+int readCoords( PARTDATA& data, const std::string& name, const char* buf,
+        const char* sp, const char* ep, const char** np )
+{
+    const char* cp = sp;    // start of the pending text
+    int nest = 0;
+    double v[3];
 
-    default:
+    while( sp < ep )
+    {
+        if( *sp == '#' && ( sp == buf || sp[-1] == '\n' ) )
+        {
+            data.text.append( cp, sp - cp );
+            sp = cp = nextLine( sp, ep );
+            continue;
+        }
 
-        if( !out.empty() )
+        if( *sp == '{' )
+        {
+            ++nest;
+        }
+        else if( *sp == '}' )
         {
-            ofile << out << "\n";
+            if( --nest == 0 )
+            {
+                ++sp;
+                break;
+            }
+        }
+        else if( isNumChar( *sp ) && ( sp == buf || !isalpha( sp[-1] ) ) )
+        {
+            data.text.append( cp, sp - cp );
 
-            if( !ofile.good() )
+            // X and Y must be followed by whitespace; Z may be terminated by anything
+            for( int i = 0; i < 3; ++i )
             {
-                ERRBLURB;
-                cerr << "problems writing output file\n";
-                return -1;
+                if( i > 0 )
+                {
+                    sp = skipSpace( buf, sp, ep );
+
+                    if( sp == ep || !isNumChar( *sp ) )
+                    {
+                        ERRBLURB;
+                        cerr << "unexpected character at line " << lineNumber( buf, sp ) << "\n";
+                        cerr << "\tinput file: " << name << "\n";
+                        return -1;
+                    }
+                }
+
+                if( !readNumber( sp, ep, &sp, v[i] )
+                    || ( i < 2 && sp < ep && !isspace( *sp ) ) )
+                {
+                    ERRBLURB;
+                    cerr << "problems parsing triplet" << i << " for transformation at line ";
+                    cerr << lineNumber( buf, sp ) << "\n";
+                    cerr << "\tinput file: " << name << "\n";
+                    return -1;
+                }
             }
+
+            data.ofs.push_back( data.text.size() );
+            data.xyz.push_back( v[0] );
+            data.xyz.push_back( v[1] );
+            data.xyz.push_back( v[2] );
+
+            cp = sp;
+            continue;
         }
 
-        break;
+        ++sp;
     }
 
+    if( nest != 0 )
+    {
+        ERRBLURB;
+        cerr << "unterminated Coordinate block\n";
+        cerr << "\tinput file: " << name << "\n";
+        return -1;
+    }
+
+    data.text.append( cp, sp - cp );
+    *np = sp;
+
     return 0;
-}    // int parsePart()
+}    // int readCoords()
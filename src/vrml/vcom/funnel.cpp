@@ -419,6 +419,36 @@ int FUNNEL::Build( bool aRenderCap, TRANSFORM& aTransform, VRMLMAT& aFluteMat,
 }    // Build()
 
 
+int FUNNEL::Translate( const FUNNEL& aFunnel, double dX, double dY, double dZ )
+{
+    if( !aFunnel.valid )
+    {
+        ERRBLURB;
+        cerr << "invoked with a funnel which has not been calculated\n";
+        return -1;
+    }
+
+    // the polygons are only cloned on the first use
+    if( !valid || npoly != aFunnel.npoly )
+    {
+        *this = aFunnel;
+
+        if( !valid )
+            return -1;
+    }
+
+    int acc = 0;
+
+    for( int i = 0; i < npoly; ++i )
+        acc += poly[i]->Translate( *aFunnel.poly[i], dX, dY, dZ );
+
+    if( acc )
+        return -1;
+
+    return 0;
+}
+
+
 void FUNNEL::cleanup( void )
 {
     int i;
@@ -22,6 +22,7 @@
 #include <fstream>
 #include <iomanip>
 #include <new>
+#include <vector>
 
 #include <vdefs.h>
 #include <vcom.h>
@@ -46,6 +47,7 @@ HDRBASE::HDRBASE()
     x = y = z = NULL;
     nv = 0;
     valid = false;
+    hasSlices = false;
 
     setDefaults();
 }
@@ -56,6 +58,7 @@ HDRBASE::HDRBASE( double bevel )
     x = y = z = NULL;
     nv = 0;
     valid = false;
+    hasSlices = false;
 
     setDefaults();
     bev = bevel;
@@ -71,6 +74,7 @@ HDRBASE::HDRBASE( const HDRBASE& p )
     POLYGON::nv = 0;
 
     valid = p.valid;
+    hasSlices = false;
     ns  = p.ns;
 
     nv  = p.nv;
@@ -94,6 +98,7 @@ HDRBASE::HDRBASE( const HDRBASE& p )
     hdy = p.hdy;
     hassh = p.hassh;
     male = p.male;
+    nhidden = p.nhidden;
 
     if( !valid )
         return;
@@ -199,6 +204,7 @@ HDRBASE& HDRBASE::operator=( const HDRBASE& p )
     POLYGON::z  = NULL;
     POLYGON::nv = 0;
     valid = p.valid;
+    hasSlices = false;
 
     nv  = p.nv;
     x   = NULL;
@@ -221,6 +227,7 @@ HDRBASE& HDRBASE::operator=( const HDRBASE& p )
     hdy = p.hdy;
     hassh = p.hassh;
     male = p.male;
+    nhidden = p.nhidden;
 
     if( !valid )
         return *this;
@@ -305,6 +312,7 @@ void HDRBASE::setDefaults( void )
     male = true;
     pbev = -1.0;
     fbev = -1.0;
+    nhidden = 0;
 }
 
 
@@ -335,6 +343,7 @@ int HDRBASE::SetParams( double aXPitch, double aYPitch, double aBevel, double aH
     POLYGON::y  = NULL;
     POLYGON::z  = NULL;
     POLYGON::nv = 0;
+    hasSlices = false;
 
     // note: bevel parameter can only be checked on invoking Calc
     HDRBASE::bev = aBevel;
@@ -465,6 +474,96 @@ int HDRBASE::SetParams( double aXPitch, double aYPitch, double aBevel, double aH
 }    // SetParams()
 
 
+int HDRBASE::SetColumns( int aNCols )
+{
+    if( !valid )
+    {
+        ERRBLURB;
+        cerr << "invoked without prior invocation of SetParams()\n";
+        return -1;
+    }
+
+    if( aNCols < 1 )
+    {
+        ERRBLURB;
+        cerr << "invalid number of columns (< 1)\n";
+        return -1;
+    }
+
+    HDRBASE::xpins = aNCols;
+
+    return 0;
+}
+
+
+// calculate the hole frames at X = 0 for each kind of row
+int HDRBASE::calcSlices( void )
+{
+    TRANSFORM t0, t1;
+    double z0 = 0.0;
+
+    if( sh > 1e-9 )
+        z0 = sh;
+
+    t0.SetTranslation( 0, 0, z0 );
+    t1.SetTranslation( 0, 0, height );
+
+    double pd[2];   // frame depth for each kind of row
+    double ho[2];   // hole offset (Y axis only)
+    int nk = 1;     // kinds of row
+    ho[0] = 0.0;
+    ho[1] = 0.0;
+
+    if( bev <= 0.0 )
+    {
+        pd[0] = ypitch;
+    }
+    else if( ypins == 1 )
+    {
+        pd[0] = ypitch - 2.0 * bev;
+    }
+    else if( ypins == 2 )
+    {
+        // front and back rows have the holes offset from the bevels
+        nk = 2;
+        pd[0] = ypitch - bev;
+        pd[1] = pd[0];
+        ho[0] = -bev / 2.0;
+        ho[1] = -ho[0];
+    }
+    else
+    {
+        // front and back rows are narrower than the middle rows
+        nk = 2;
+        pd[0] = ypitch - bev;
+        pd[1] = ypitch;
+    }
+
+    int val = 0;
+
+    for( int i = 0; i < nk; ++i )
+    {
+        val += sbot[i].Calc( xpitch, pd[i], hd0, hdy, t0, squarebot, 0, ho[i], ns, pbev );
+
+        if( male )
+            val += stop[i].Calc( xpitch, pd[i], hd0, hdy, t1, squarebot, 0, ho[i], ns, pbev );
+        else
+            val += stop[i].Calc( xpitch, pd[i], hd1, hd1, t1, squaretop, 0, ho[i], ns, fbev );
+    }
+
+    if( val )
+    {
+        ERRBLURB;
+        cerr << "problems calculating the hole frames\n";
+        hasSlices = false;
+        return -1;
+    }
+
+    hasSlices = true;
+    return 0;
+}
+
+
 int HDRBASE::calc( void )
 {
     if( valid )
@@ -704,6 +803,9 @@ int HDRBASE::paint( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
     int val = 0;
     int i, j, k;
 
+    if( !hasSlices && calcSlices() )
+        return -1;
+
     // if beveled, seal the top and bottom polygons
     if( bev > 0.0 )
     {
@@ -771,40 +873,19 @@ int HDRBASE::paint( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
     }    // if (bev > 0.0)
 
     // frames on the holes are a uniform size
-    HOLE bh, th;
-    TRANSFORM t0, t1;
-    double z0 = 0.0;
-
-    if( sh > 1e-9 )
-        z0 = sh;
-
-    double ox, oy;    // offset for locating the hole
+    std::vector<double> ox, oy;     // offsets for locating the holes
 
     for( i = 0; i < ypins; ++i )
     {
-        oy = ( (1 - ypins) / 2.0 + i ) * ypitch;
-
         for( j = 0; j < xpins; ++j )
         {
-            ox = ( (1 - xpins) / 2.0 + j ) * xpitch;
-            t0.SetTranslation( ox, oy, z0 );
-            t1.SetTranslation( ox, oy, height );
-            bh.Calc( xpitch, ypitch, hd0, hdy, t0, squarebot, 0, 0, ns, pbev );
-
-            if( male )
-            {
-                th.Calc( xpitch, ypitch, hd0, hdy, t1, squarebot, 0, 0, ns, pbev );
-            }
-            else
-            {
-                th.Calc( xpitch, ypitch, hd1, hd1, t1, squaretop, 0, 0, ns, fbev );
-            }
-
-            val += bh.Build( false, t, color, true, fp, tabs );
-            val += th.Build( true, t, color, true, fp, tabs );
+            ox.push_back( ( (1 - xpins) / 2.0 + j ) * xpitch );
+            oy.push_back( ( (1 - ypins) / 2.0 + i ) * ypitch );
         }
     }
 
+    val += buildHoles( 0, ox, oy, t, color, true, fp, tabs );
+
     if( val )
     {
         ERRBLURB;
@@ -936,9 +1017,11 @@ int HDRBASE::stitch( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
             tsv[2][i] = sv[2][i];
         }
 
+        // note: the upper face of the shoulder is coplanar with the
+        // bottom of the case and can never be seen, so it is not rendered
         val += POLYGON::Stitch( true, pol, t, color, true, fp, tabs );
-        POLYGON::Paint( false, t, color, true, fp, tabs );
-        pol.Paint( true, t, color, true, fp, tabs );
+        val += POLYGON::Paint( false, t, color, true, fp, tabs );
+        ++nhidden;
         t0.SetRotation( M_PI, 0, 0, 1 );
         t0.Transform( tsv[0], tsv[1], tsv[2], 8 );
         val += POLYGON::Stitch( true, pol, t, color, true, fp, tabs );
@@ -965,40 +1048,15 @@ int HDRBASE::makeHoles1( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
         std::ofstream& fp, int tabs )
 {
     // frames on the holes are a uniform size
-    HOLE bh, th;
-    TRANSFORM t0, t1;
-    int i;
-    int val = 0;
-    double z0 = 0.0;
-
-    if( sh > 1e-9 )
-        z0 = sh;
-
-    double ox;  // offset for locating the hole
-    bool reuse = reuse_color;
+    std::vector<double> ox, oy;     // offsets for locating the holes
 
-    for( i = 0; i < xpins; ++i )
+    for( int i = 0; i < xpins; ++i )
     {
-        ox = ( (1 - xpins) / 2.0 + i ) * xpitch;
-        t0.SetTranslation( ox, 0, z0 );
-        t1.SetTranslation( ox, 0, height );
-        bh.Calc( xpitch, ypitch - 2.0 * bev, hd0, hdy, t0, squarebot, 0, 0, ns, pbev );
-
-        if( male )
-        {
-            th.Calc( xpitch, ypitch - 2.0 * bev, hd0, hdy, t1, squarebot, 0, 0, ns, pbev );
-        }
-        else
-        {
-            th.Calc( xpitch, ypitch - 2.0 * bev, hd1, hd1, t1, squaretop, 0, 0, ns, fbev );
-        }
-
-        val += bh.Build( false, t, color, reuse, fp, tabs );
-        reuse = true;
-        val += th.Build( true, t, color, true, fp, tabs );
+        ox.push_back( ( (1 - xpins) / 2.0 + i ) * xpitch );
+        oy.push_back( 0.0 );
     }
 
-    if( val )
+    if( buildHoles( 0, ox, oy, t, color, reuse_color, fp, tabs ) )
     {
         ERRBLURB;
         cerr << "problems writing to output file\n";
@@ -1013,48 +1071,22 @@ int HDRBASE::makeHoles2( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
         std::ofstream& fp, int tabs )
 {
     // frames on the holes are a uniform size but have different hole offsets
-    HOLE bh, th;
-    TRANSFORM t0, t1;
+    std::vector<double> ox, oy;     // offsets for locating the holes
     int i, j;
     int val = 0;
-    double z0 = 0.0;
 
-    if( sh > 1e-9 )
-        z0 = sh;
+    for( i = 0; i < xpins; ++i )
+        ox.push_back( ( (1 - xpins) / 2.0 + i ) * xpitch );
 
-    double ox, oy;  // offsets for locating the hole
-    double ho;      // hole offset (Y axis only)
-    oy  = -ypitch / 2.0 + bev / 2.0;
-    ho  = -bev / 2.0;
-    j   = 0;
-    bool reuse = reuse_color;
+    oy.resize( xpins, -ypitch / 2.0 + bev / 2.0 );
 
-    while( j < 2 )
+    for( j = 0; j < 2; ++j )
     {
-        for( i = 0; i < xpins; ++i )
-        {
-            ox = ( (1 - xpins) / 2.0 + i ) * xpitch;
-            t0.SetTranslation( ox, oy, z0 );
-            t1.SetTranslation( ox, oy, height );
-            bh.Calc( xpitch, ypitch - bev, hd0, hdy, t0, squarebot, 0, ho, ns, pbev );
-
-            if( male )
-            {
-                th.Calc( xpitch, ypitch - bev, hd0, hdy, t1, squarebot, 0, ho, ns, pbev );
-            }
-            else
-            {
-                th.Calc( xpitch, ypitch - bev, hd1, hd1, t1, squaretop, 0, ho, ns, fbev );
-            }
+        val += buildHoles( j, ox, oy, t, color, reuse_color, fp, tabs );
+        reuse_color = true;
 
-            val += bh.Build( false, t, color, reuse, fp, tabs );
-            reuse = true;
-            val += th.Build( true, t, color, true, fp, tabs );
-        }
-
-        ho  = -ho;
-        oy  = -oy;
-        ++j;
+        for( i = 0; i < xpins; ++i )
+            oy[i] = -oy[i];
     }
 
     if( val )
@@ -1073,72 +1105,38 @@ int HDRBASE::makeHoles3( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
 {
     // frames on the holes are one size at front and back size but have different hole offsets
     // while holes in the middle are all the same
-    HOLE bh, th;
-    TRANSFORM t0, t1;
+    std::vector<double> ox, oy;     // offsets for locating the holes
     int i, j;
     int val = 0;
-    double z0 = 0.0;
-
-    if( sh > 1e-9 )
-        z0 = sh;
-
-    double ox, oy;    // offsets for locating the hole
-    oy  = (1 - ypins) * ypitch / 2.0 + bev / 2.0;
-    j   = 0;
-    bool reuse = reuse_color;
+    double ty = (1 - ypins) * ypitch / 2.0 + bev / 2.0;
 
-    while( j < 2 )
+    for( j = 0; j < 2; ++j )
     {
         for( i = 0; i < xpins; ++i )
         {
-            ox = ( (1 - xpins) / 2.0 + i ) * xpitch;
-            t0.SetTranslation( ox, oy, z0 );
-            t1.SetTranslation( ox, oy, height );
-            bh.Calc( xpitch, ypitch - bev, hd0, hdy, t0, squarebot, 0, 0, ns, pbev );
-
-            if( male )
-            {
-                th.Calc( xpitch, ypitch - bev, hd0, hdy, t1, squarebot, 0, 0, ns, pbev );
-            }
-            else
-            {
-                th.Calc( xpitch, ypitch - bev, hd1, hd1, t1, squaretop, 0, 0, ns, fbev );
-            }
-
-            val += bh.Build( false, t, color, reuse, fp, tabs );
-            reuse = true;
-            val += th.Build( true, t, color, true, fp, tabs );
+            ox.push_back( ( (1 - xpins) / 2.0 + i ) * xpitch );
+            oy.push_back( ty );
         }
 
-        oy = -oy;
-        ++j;
+        ty = -ty;
     }
 
+    val += buildHoles( 0, ox, oy, t, color, reuse_color, fp, tabs );
+
+    ox.clear();
+    oy.clear();
+
     for( i = 1; i < ypins - 1; ++i )
     {
-        oy = ( (1 - ypins) / 2.0 + i ) * ypitch;
-
         for( j = 0; j < xpins; ++j )
         {
-            ox = ( (1 - xpins) / 2.0 + j ) * xpitch;
-            t0.SetTranslation( ox, oy, z0 );
-            t1.SetTranslation( ox, oy, height );
-            bh.Calc( xpitch, ypitch, hd0, hdy, t0, squarebot, 0, 0, ns, pbev );
-
-            if( male )
-            {
-                th.Calc( xpitch, ypitch, hd0, hdy, t1, squarebot, 0, 0, ns, pbev );
-            }
-            else
-            {
-                th.Calc( xpitch, ypitch, hd1, hd1, t1, squaretop, 0, 0, ns, fbev );
-            }
-
-            val += bh.Build( false, t, color, true, fp, tabs );
-            val += th.Build( true, t, color, true, fp, tabs );
+            ox.push_back( ( (1 - xpins) / 2.0 + j ) * xpitch );
+            oy.push_back( ( (1 - ypins) / 2.0 + i ) * ypitch );
         }
     }
 
+    val += buildHoles( 1, ox, oy, t, color, true, fp, tabs );
+
     if( val )
     {
         ERRBLURB;
@@ -1150,6 +1148,25 @@ int HDRBASE::makeHoles3( TRANSFORM& t, VRMLMAT& color, bool reuse_color,
 }
 
 
+int HDRBASE::buildHoles( int kind, const std::vector<double>& ox, const std::vector<double>& oy,
+        TRANSFORM& t, VRMLMAT& color, bool reuse_color, std::ofstream& fp, int tabs )
+{
+    int n = (int) ox.size();
+
+    if( n == 0 )
+        return 0;
+
+    int val = 0;
+    val += sbot[kind].BuildArray( false, &ox[0], &oy[0], n, t, color, reuse_color, fp, tabs );
+    val += stop[kind].BuildArray( true, &ox[0], &oy[0], n, t, color, true, fp, tabs );
+
+    if( val )
+        return -1;
+
+    return 0;
+}
+
+
 // Write the header shape to an output file
 int HDRBASE::Build( KC3D::TRANSFORM& aTransform, KC3D::VRMLMAT& aMaterial, bool reuseMaterial,
                     std::ofstream& aVRMLFile, int aTabDepth )
@@ -1162,6 +1179,7 @@ int HDRBASE::Build( KC3D::TRANSFORM& aTransform, KC3D::VRMLMAT& aMaterial, bool
     }
 
     int val = 0;
+    nhidden = 0;
     val += calc();
     val += stitch( aTransform, aMaterial, reuseMaterial, aVRMLFile, aTabDepth );
     val += paint( aTransform, aMaterial, true, aVRMLFile, aTabDepth );
@@ -1179,7 +1197,7 @@ int HDRBASE::Build( KC3D::TRANSFORM& aTransform, KC3D::VRMLMAT& aMaterial, bool
 
 /* Inherited (overridden) Paint */
 int HDRBASE::Paint( bool ccw, TRANSFORM& t, VRMLMAT& color, bool reuse_color,
-        std::ofstream& fp, int tabs )
+        std::ostream& fp, int tabs )
 {
     ERRBLURB;
     cerr << "BUG: unexpected code execution branch\n";
@@ -1198,7 +1216,7 @@ int HDRBASE::Calc( double, double, KC3D::TRANSFORM& )
 
 /* Inherited (overridden) Stitch */
 int HDRBASE::Stitch( bool ccw, POLYGON& p2, TRANSFORM& t,
-        VRMLMAT& color, bool reuse_color, std::ofstream& fp, int tabs )
+        VRMLMAT& color, bool reuse_color, std::ostream& fp, int tabs )
 {
     ERRBLURB;
     cerr << "BUG: unexpected code execution branch\n";
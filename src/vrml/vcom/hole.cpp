@@ -195,6 +195,62 @@ int HOLE::Calc( double aPanelWidth, double aPanelDepth, double aHoleWidth, doubl
 }
 
 
+int HOLE::Translate( const HOLE& aHole, double dX, double dY, double dZ )
+{
+    if( !aHole.valid )
+    {
+        ERRBLURB;
+        cerr << "invoked with a hole which has not been calculated\n";
+        return -1;
+    }
+
+    // the inner polygon is only cloned when its shape changes
+    if( !valid || square != aHole.square || bev != aHole.bev
+        || hole->GetNVertices() != aHole.hole->GetNVertices() )
+    {
+        if( hole )
+            delete hole;
+
+        valid = false;
+        hole = aHole.hole->Clone();
+
+        if( !hole )
+        {
+            ERRBLURB;
+            cerr << "could not allocate memory for hole\n";
+            return -1;
+        }
+    }
+
+    square = aHole.square;
+    w1  = aHole.w1;
+    w2  = aHole.w2;
+    d1  = aHole.d1;
+    d2  = aHole.d2;
+    bev = aHole.bev;
+    ow  = aHole.ow;
+    od  = aHole.od;
+    np  = aHole.np;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        v[0][i] = aHole.v[0][i] + dX;
+        v[1][i] = aHole.v[1][i] + dY;
+        v[2][i] = aHole.v[2][i] + dZ;
+    }
+
+    if( hole->Translate( *aHole.hole, dX, dY, dZ ) )
+    {
+        delete hole;
+        hole = NULL;
+        return -1;
+    }
+
+    valid = true;
+    return 0;
+}
+
+
 int HOLE::Build( bool isTopView, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool reuseMaterial,
                std::ofstream& aVRMLFile, int aTabDepth )
 {
@@ -274,30 +330,115 @@ int HOLE::Build( bool isTopView, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool
 
     // enumerate facets
     acc += SetupCoordIndex( aVRMLFile, aTabDepth + 1 );
+    acc += writeFrame( isTopView, 0, aVRMLFile, aTabDepth + 2, true );
+    acc += CloseCoordIndex( aVRMLFile, aTabDepth + 1 );
+    acc += CloseShape( aVRMLFile, aTabDepth );
 
-    if( square )
+    if( acc )
     {
-        if( bev > 0.0 )
-            acc += writeRFacetsB( isTopView, aVRMLFile, aTabDepth + 2 );
-        else
-            acc += writeRFacets( isTopView, aVRMLFile, aTabDepth + 2 );
+        ERRBLURB;
+        cerr << "problems writing data\n";
+        return -1;
     }
-    else
+
+    return 0;
+}
+
+
+int HOLE::BuildArray( bool isTopView, const double* aXOffset, const double* aYOffset,
+                      int aNOffset, TRANSFORM& aTransform, VRMLMAT& aMaterial,
+                      bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth )
+{
+    if( !valid )
     {
-        acc += writeFacets( isTopView, 0, 1, 4 + np * 3 / 4, 3 + np, 4, aVRMLFile, aTabDepth + 2 );
-        acc += writeFacets( isTopView, 1, 2, 4, 3 + np / 4, 4 + np / 4, aVRMLFile, aTabDepth + 2 );
-        acc += writeFacets( isTopView, 2, 3, 4 + np / 4, 3 + np / 2, 4 + np / 2, aVRMLFile, aTabDepth + 2 );
-        acc += writeFacets( isTopView,
-                3,
-                0,
-                4 + np / 2,
-                3 + np * 3 / 4,
-                4 + np * 3 / 4,
-                aVRMLFile,
-                aTabDepth + 2,
-                true );
+        ERRBLURB;
+        cerr << "invoked with no prior successful call to Calc()\n";
+        return -1;
     }
 
+    if( aNOffset < 1 || !aXOffset || !aYOffset )
+    {
+        ERRBLURB;
+        cerr << "invalid offset list\n";
+        return -1;
+    }
+
+    double* lx, * ly, * lz;
+    int np  = hole->GetVertices( &lx, &ly, &lz );
+    int np2 = np + 4;
+    int nt  = np2 * aNOffset;
+
+    double* tx, * ty, * tz;
+
+    tx = new (nothrow) double[nt];
+
+    if( !tx )
+    {
+        ERRBLURB;
+        cerr << "cannot allocate memory for vertices\n";
+        return -1;
+    }
+
+    ty = new (nothrow) double[nt];
+
+    if( !ty )
+    {
+        ERRBLURB;
+        cerr << "cannot allocate memory for vertices\n";
+        delete [] tx;
+        return -1;
+    }
+
+    tz = new (nothrow) double[nt];
+
+    if( !tz )
+    {
+        ERRBLURB;
+        cerr << "cannot allocate memory for vertices\n";
+        delete [] tx;
+        delete [] ty;
+        return -1;
+    }
+
+    int i, j, idx;
+
+    // each copy holds the 4 frame vertices followed by the hole
+    for( j = 0, idx = 0; j < aNOffset; ++j )
+    {
+        for( i = 0; i < 4; ++i, ++idx )
+        {
+            tx[idx] = v[0][i] + aXOffset[j];
+            ty[idx] = v[1][i] + aYOffset[j];
+            tz[idx] = v[2][i];
+        }
+
+        for( i = 0; i < np; ++i, ++idx )
+        {
+            tx[idx] = lx[i] + aXOffset[j];
+            ty[idx] = ly[i] + aYOffset[j];
+            tz[idx] = lz[i];
+        }
+    }
+
+    aTransform.Transform( tx, ty, tz, nt );
+
+    int acc = 0;
+
+    // set up VRML Shape
+    acc += SetupShape( aMaterial, reuseMaterial, aVRMLFile, aTabDepth );
+
+    // enumerate vertices
+    acc += WriteCoord( tx, ty, tz, nt, aVRMLFile, aTabDepth + 1 );
+    delete [] tx;
+    delete [] ty;
+    delete [] tz;
+
+    // enumerate facets
+    acc += SetupCoordIndex( aVRMLFile, aTabDepth + 1 );
+
+    for( j = 0; j < aNOffset; ++j )
+        acc += writeFrame( isTopView, j * np2, aVRMLFile, aTabDepth + 2, j == aNOffset - 1 );
+
     acc += CloseCoordIndex( aVRMLFile, aTabDepth + 1 );
     acc += CloseShape( aVRMLFile, aTabDepth );
 
@@ -312,6 +453,40 @@ int HOLE::Build( bool isTopView, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool
 }
 
 
+int HOLE::writeFrame( bool top, int base, std::ofstream& fp, int tabs, bool term )
+{
+    int acc = 0;
+
+    if( square )
+    {
+        if( bev > 0.0 )
+            acc += writeRFacetsB( top, fp, tabs, base );
+        else
+            acc += writeRFacets( top, fp, tabs, base );
+
+        return acc;
+    }
+
+    int np = hole->GetNVertices();
+    int b = base;
+
+    acc += writeFacets( top, b, b + 1, b + 4 + np * 3 / 4, b + 3 + np, b + 4, fp, tabs );
+    acc += writeFacets( top, b + 1, b + 2, b + 4, b + 3 + np / 4, b + 4 + np / 4, fp, tabs );
+    acc += writeFacets( top, b + 2, b + 3, b + 4 + np / 4, b + 3 + np / 2, b + 4 + np / 2, fp, tabs );
+    acc += writeFacets( top,
+            b + 3,
+            b,
+            b + 4 + np / 2,
+            b + 3 + np * 3 / 4,
+            b + 4 + np * 3 / 4,
+            fp,
+            tabs,
+            term );
+
+    return acc;
+}
+
+
 int HOLE::writeFacets( bool top, int v0, int v1, int h0, int h1, int lp,
         std::ofstream& fp, int tabs, bool term )
 {
@@ -369,19 +544,49 @@ int HOLE::writeFacets( bool top, int v0, int v1, int h0, int h1, int lp,
 }
 
 
-int HOLE::writeRFacets( bool top, std::ofstream& fp, int tabs )
+// facet lists for the rectangular holes; vertices 0..3 are the
+// frame and the remaining vertices are the hole
+static const int rFacetsTop[] = { 0, 1, 5, 4, -1, 1, 2, 6, 5, -1, 2, 3, 7, 6, -1, 3, 0, 4, 7, -1 };
+static const int rFacetsBot[] = { 1, 0, 4, 5, -1, 2, 1, 5, 6, -1, 3, 2, 6, 7, -1, 0, 3, 7, 4, -1 };
+static const int rbFacetsTop[] = { 0, 5, 4, -1, 0, 1, 6, 5, -1, 1, 7, 6, -1, 1, 2, 8, 7, -1,
+                                   2, 9, 8, -1, 2, 3, 10, 9, -1, 3, 11, 10, -1, 3, 0, 4, 11, -1 };
+static const int rbFacetsBot[] = { 0, 4, 5, -1, 1, 0, 5, 6, -1, 1, 6, 7, -1, 2, 1, 7, 8, -1,
+                                   2, 8, 9, -1, 3, 2, 9, 10, -1, 3, 10, 11, -1, 0, 3, 11, 4, -1 };
+
+
+// write a list of facets with the vertex indices offset by 'base'
+static void writeList( const int* list, int nl, int base, std::ofstream& fp )
+{
+    for( int i = 0; i < nl; ++i )
+    {
+        if( i )
+            fp << ",";
+
+        if( list[i] < 0 )
+            fp << "-1";
+        else
+            fp << list[i] + base;
+    }
+
+    return;
+}
+
+
+int HOLE::writeRFacets( bool top, std::ofstream& fp, int tabs, int base )
 {
     string fmt( tabs * 4, ' ' );
 
+    fp << fmt;
+
     if( top )
     {
-        fp << fmt;
-        fp << "0,1,5,4,-1,1,2,6,5,-1,2,3,7,6,-1,3,0,4,7,-1,\n";
+        writeList( rFacetsTop, 20, base, fp );
+        fp << ",\n";
     }
     else
     {
-        fp << fmt;
-        fp << "1,0,4,5,-1,2,1,5,6,-1,3,2,6,7,-1,0,3,7,4,-1\n";
+        writeList( rFacetsBot, 20, base, fp );
+        fp << "\n";
     }
 
     if( !fp.good() )
@@ -391,22 +596,18 @@ int HOLE::writeRFacets( bool top, std::ofstream& fp, int tabs )
 }
 
 
-int HOLE::writeRFacetsB( bool top, std::ofstream& fp, int tabs )
+int HOLE::writeRFacetsB( bool top, std::ofstream& fp, int tabs, int base )
 {
     string fmt( tabs * 4, ' ' );
 
+    fp << fmt;
+
     if( top )
-    {
-        fp << fmt;
-        fp << "0,5,4,-1,0,1,6,5,-1,1,7,6,-1,1,2,8,7,-1,";
-        fp << "2,9,8,-1,2,3,10,9,-1, 3,11,10,-1,3,0,4,11,-1\n";
-    }
+        writeList( rbFacetsTop, 36, base, fp );
     else
-    {
-        fp << fmt;
-        fp << "0,4,5,-1,1,0,5,6,-1,1,6,7,-1,2,1,7,8,-1,";
-        fp << "2,8,9,-1,3,2,9,10,-1, 3,10,11,-1,0,3,11,4,-1\n";
-    }
+        writeList( rbFacetsBot, 36, base, fp );
+
+    fp << "\n";
 
     if( !fp.good() )
         return -1;
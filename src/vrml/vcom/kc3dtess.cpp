@@ -24,18 +24,16 @@
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <map>
+#include <pthread.h>
 #include <kc3dtess.h>
 #include <polygon.h>
 #include <transform.h>
 #include <vcom.h>
 
-#ifndef CALLBACK
-#define CALLBACK
-#endif
-
-#define GLCALLBACK(x) (( void (CALLBACK*)() )&(x))
-
 using namespace std;
 using namespace KC3D;
 
@@ -77,118 +75,834 @@ static void FormatSinglet( double x, int precision, std::string& strx )
 }
 
 
-static void CALLBACK vrml_tess_begin( GLenum cmd, void* user_data )
+/*
+ * Ear clipping triangulator
+ *
+ * A solid contour (CCW) and its holes (CW) are placed in a single
+ * circular list; each hole is joined to the list by a pair of
+ * coincident bridge edges so that the result is one weakly simple
+ * polygon which is then reduced one ear at a time. The nodes are held
+ * in a vector and linked by index so that no per-vertex allocation is
+ * required and the procedure holds no state outside of the caller's
+ * stack. The bridging and fallback steps follow the well known
+ * 'earcut' scheme.
+ */
+struct TESS_NODE
+{
+    int     id;     // vertex index
+    double  x;
+    double  y;
+    int     prev;   // index of the previous node in the list
+    int     next;   // index of the next node in the list
+    int     z;      // z-order curve value
+    int     prevZ;  // index of the previous node in z-order (-1 if none)
+    int     nextZ;  // index of the next node in z-order (-1 if none)
+};
+
+
+// lists with fewer vertices than this are clipped without a z-order index
+#define TESS_HASH_MIN ( 80 )
+
+// parameters of the z-order index; invSize is 0 if there is no index
+struct TESS_HASH
+{
+    double minX;
+    double minY;
+    double invSize;
+};
+
+
+// signed area of a triangle; negative if p, q, r turn to the left (CCW)
+static inline double tArea( const TESS_NODE& p, const TESS_NODE& q, const TESS_NODE& r )
 {
-    TESSELATOR* lp = (TESSELATOR*) user_data;
+    return ( q.y - p.y ) * ( r.x - q.x ) - ( q.x - p.x ) * ( r.y - q.y );
+}
 
-    lp->glStart( cmd );
+
+static inline bool tEquals( const TESS_NODE& p, const TESS_NODE& q )
+{
+    return p.x == q.x && p.y == q.y;
 }
 
 
-static void CALLBACK vrml_tess_end( void* user_data )
+static inline int tSign( double val )
 {
-    TESSELATOR* lp = (TESSELATOR*) user_data;
+    return ( val > 0.0 ) ? 1 : ( ( val < 0.0 ) ? -1 : 0 );
+}
+
 
-    lp->glEnd();
+// true if point (px, py) lies within (or on the edge of) triangle a, b, c
+static inline bool tPointInTriangle( double ax, double ay, double bx, double by,
+                                     double cx, double cy, double px, double py )
+{
+    return ( cx - px ) * ( ay - py ) >= ( ax - px ) * ( cy - py )
+           && ( ax - px ) * ( by - py ) >= ( bx - px ) * ( ay - py )
+           && ( bx - px ) * ( cy - py ) >= ( cx - px ) * ( by - py );
 }
 
 
-static void CALLBACK vrml_tess_vertex( void* vertex_data, void* user_data )
+// append a node after node 'aLast' (or start a new list if aLast < 0)
+static int tInsertNode( std::vector<TESS_NODE>& n, int aID, double aX, double aY, int aLast )
 {
-    TESSELATOR* lp = (TESSELATOR*) user_data;
+    TESS_NODE node;
+    node.id = aID;
+    node.x  = aX;
+    node.y  = aY;
+    node.z  = 0;
+    node.prevZ = -1;
+    node.nextZ = -1;
+
+    int i = n.size();
 
-    lp->glPushVertex( (VERTEX_3D*) vertex_data );
+    if( aLast < 0 )
+    {
+        node.prev = i;
+        node.next = i;
+    }
+    else
+    {
+        node.prev = aLast;
+        node.next = n[aLast].next;
+        n[n[aLast].next].prev = i;
+        n[aLast].next = i;
+    }
+
+    n.push_back( node );
+    return i;
 }
 
 
-static void CALLBACK vrml_tess_err( GLenum errorID, void* user_data )
+// unlink a node; the node retains its own links so that
+// a traversal may continue from it
+static inline void tRemoveNode( std::vector<TESS_NODE>& n, int p )
 {
-    TESSELATOR* lp = (TESSELATOR*) user_data;
+    n[n[p].next].prev = n[p].prev;
+    n[n[p].prev].next = n[p].next;
 
-    lp->Fault = true;
-    lp->SetGLError( errorID );
+    if( n[p].prevZ >= 0 )
+        n[n[p].prevZ].nextZ = n[p].nextZ;
+
+    if( n[p].nextZ >= 0 )
+        n[n[p].nextZ].prevZ = n[p].prevZ;
 }
 
 
-static void CALLBACK vrml_tess_combine( GLdouble coords[3], VERTEX_3D* vertex_data[4],
-                                        GLfloat weight[4], void** outData, void* user_data )
+// z-order of a point; coordinates are mapped to a 15-bit integer range
+static int tZOrder( double aX, double aY, const TESS_HASH& aHash )
 {
-    TESSELATOR* lp = (TESSELATOR*) user_data;
-    *outData = lp->AddExtraVertex( coords[0], coords[1] );
+    unsigned int x = (unsigned int) ( ( aX - aHash.minX ) * aHash.invSize );
+    unsigned int y = (unsigned int) ( ( aY - aHash.minY ) * aHash.invSize );
+
+    x = ( x | ( x << 8 ) ) & 0x00FF00FF;
+    x = ( x | ( x << 4 ) ) & 0x0F0F0F0F;
+    x = ( x | ( x << 2 ) ) & 0x33333333;
+    x = ( x | ( x << 1 ) ) & 0x55555555;
 
-    return;
+    y = ( y | ( y << 8 ) ) & 0x00FF00FF;
+    y = ( y | ( y << 4 ) ) & 0x0F0F0F0F;
+    y = ( y | ( y << 2 ) ) & 0x33333333;
+    y = ( y | ( y << 1 ) ) & 0x55555555;
+
+    return (int) ( x | ( y << 1 ) );
 }
 
 
-TESSELATOR::TESSELATOR()
+// sort the z-order links of a list (merge sort); returns the first node
+static int tSortLinked( std::vector<TESS_NODE>& n, int aList )
 {
-    // arc parameters suitable to mm measurements
-    maxArcSeg = 48;
-    minSegLength = 0.1;
-    maxSegLength = 0.5;
+    int numMerges;
+    int inSize = 1;
 
-    fix = false;
-    Fault = false;
-    idx = 0;
-    ord = 0;
-    glcmd   = 0;
+    do
+    {
+        int p = aList;
+        int e;
+        int tail = -1;
 
-    tess = gluNewTess();
+        aList = -1;
+        numMerges = 0;
 
-    if( !tess )
-        return;
+        while( p >= 0 )
+        {
+            ++numMerges;
 
-    // set up the tesselator callbacks
-    gluTessCallback( tess, GLU_TESS_BEGIN_DATA, GLCALLBACK( vrml_tess_begin ) );
+            int q = p;
+            int pSize = 0;
+
+            for( int i = 0; i < inSize; ++i )
+            {
+                ++pSize;
+                q = n[q].nextZ;
 
-    gluTessCallback( tess, GLU_TESS_VERTEX_DATA, GLCALLBACK( vrml_tess_vertex ) );
+                if( q < 0 )
+                    break;
+            }
 
-    gluTessCallback( tess, GLU_TESS_END_DATA, GLCALLBACK( vrml_tess_end ) );
+            int qSize = inSize;
 
-    gluTessCallback( tess, GLU_TESS_ERROR_DATA, GLCALLBACK( vrml_tess_err ) );
+            while( pSize > 0 || ( qSize > 0 && q >= 0 ) )
+            {
+                if( pSize != 0 && ( qSize == 0 || q < 0 || n[p].z <= n[q].z ) )
+                {
+                    e = p;
+                    p = n[p].nextZ;
+                    --pSize;
+                }
+                else
+                {
+                    e = q;
+                    q = n[q].nextZ;
+                    --qSize;
+                }
+
+                if( tail >= 0 )
+                    n[tail].nextZ = e;
+                else
+                    aList = e;
+
+                n[e].prevZ = tail;
+                tail = e;
+            }
 
-    gluTessCallback( tess, GLU_TESS_COMBINE_DATA, GLCALLBACK( vrml_tess_combine ) );
+            p = q;
+        }
 
-    gluTessProperty( tess, GLU_TESS_WINDING_RULE, GLU_TESS_WINDING_POSITIVE );
+        n[tail].nextZ = -1;
+        inSize *= 2;
+    } while( numMerges > 1 );
 
-    gluTessNormal( tess, 0, 0, 1 );
+    return aList;
 }
 
 
-TESSELATOR::~TESSELATOR()
+// link the nodes of a list in z-order
+static void tIndexCurve( std::vector<TESS_NODE>& n, int aStart, const TESS_HASH& aHash )
 {
-    Clear();
+    int p = aStart;
+
+    do
+    {
+        if( n[p].z == 0 )
+            n[p].z = tZOrder( n[p].x, n[p].y, aHash );
+
+        n[p].prevZ = n[p].prev;
+        n[p].nextZ = n[p].next;
+        p = n[p].next;
+    } while( p != aStart );
+
+    n[n[p].prevZ].nextZ = -1;
+    n[p].prevZ = -1;
+
+    tSortLinked( n, p );
+}
+
+
+// remove repeated and collinear points between aStart and aEnd
+static int tFilterPoints( std::vector<TESS_NODE>& n, int aStart, int aEnd )
+{
+    if( aStart < 0 )
+        return aStart;
+
+    if( aEnd < 0 )
+        aEnd = aStart;
+
+    int p = aStart;
+    bool again;
+
+    do
+    {
+        again = false;
+
+        if( tEquals( n[p], n[n[p].next] ) || tArea( n[n[p].prev], n[p], n[n[p].next] ) == 0.0 )
+        {
+            tRemoveNode( n, p );
+            p = aEnd = n[p].prev;
+
+            if( p == n[p].next )
+                break;
+
+            again = true;
+        }
+        else
+        {
+            p = n[p].next;
+        }
+    } while( again || p != aEnd );
+
+    return aEnd;
+}
+
+
+// true if the diagonal a-b lies within the polygon in the vicinity of 'a'
+static bool tLocallyInside( const std::vector<TESS_NODE>& n, int a, int b )
+{
+    const TESS_NODE& na = n[a];
+
+    if( tArea( n[na.prev], na, n[na.next] ) < 0.0 )
+        return tArea( na, n[b], n[na.next] ) >= 0.0 && tArea( na, n[na.prev], n[b] ) >= 0.0;
+
+    return tArea( na, n[b], n[na.prev] ) < 0.0 || tArea( na, n[na.next], n[b] ) < 0.0;
+}
+
+
+static inline bool tOnSegment( const TESS_NODE& p, const TESS_NODE& q, const TESS_NODE& r )
+{
+    return q.x <= std::max( p.x, r.x ) && q.x >= std::min( p.x, r.x )
+           && q.y <= std::max( p.y, r.y ) && q.y >= std::min( p.y, r.y );
+}
+
+
+// true if segments p1-q1 and p2-q2 intersect
+static bool tIntersects( const TESS_NODE& p1, const TESS_NODE& q1,
+                         const TESS_NODE& p2, const TESS_NODE& q2 )
+{
+    int o1 = tSign( tArea( p1, q1, p2 ) );
+    int o2 = tSign( tArea( p1, q1, q2 ) );
+    int o3 = tSign( tArea( p2, q2, p1 ) );
+    int o4 = tSign( tArea( p2, q2, q1 ) );
+
+    if( o1 != o2 && o3 != o4 )
+        return true;
+
+    if( o1 == 0 && tOnSegment( p1, p2, q1 ) )
+        return true;
+
+    if( o2 == 0 && tOnSegment( p1, q2, q1 ) )
+        return true;
+
+    if( o3 == 0 && tOnSegment( p2, p1, q2 ) )
+        return true;
+
+    if( o4 == 0 && tOnSegment( p2, q1, q2 ) )
+        return true;
+
+    return false;
+}
+
+
+// true if the diagonal a-b crosses any edge of the polygon
+static bool tIntersectsPolygon( const std::vector<TESS_NODE>& n, int a, int b )
+{
+    int p = a;
+
+    do
+    {
+        if( n[p].id != n[a].id && n[n[p].next].id != n[a].id
+            && n[p].id != n[b].id && n[n[p].next].id != n[b].id
+            && tIntersects( n[p], n[n[p].next], n[a], n[b] ) )
+            return true;
+
+        p = n[p].next;
+    } while( p != a );
+
+    return false;
+}
+
+
+// true if the middle of the diagonal a-b lies within the polygon
+static bool tMiddleInside( const std::vector<TESS_NODE>& n, int a, int b )
+{
+    int p = a;
+    bool inside = false;
+    double px = ( n[a].x + n[b].x ) / 2.0;
+    double py = ( n[a].y + n[b].y ) / 2.0;
+
+    do
+    {
+        const TESS_NODE& np = n[p];
+        const TESS_NODE& nn = n[np.next];
+
+        if( ( ( np.y > py ) != ( nn.y > py ) ) && nn.y != np.y
+            && ( px < ( nn.x - np.x ) * ( py - np.y ) / ( nn.y - np.y ) + np.x ) )
+            inside = !inside;
+
+        p = np.next;
+    } while( p != a );
+
+    return inside;
+}
+
+
+// true if a diagonal may be drawn between a and b
+static bool tIsValidDiagonal( const std::vector<TESS_NODE>& n, int a, int b )
+{
+    const TESS_NODE& na = n[a];
+    const TESS_NODE& nb = n[b];
+
+    if( n[na.next].id == nb.id || n[na.prev].id == nb.id || tIntersectsPolygon( n, a, b ) )
+        return false;
+
+    if( tLocallyInside( n, a, b ) && tLocallyInside( n, b, a ) && tMiddleInside( n, a, b )
+        && ( tArea( n[na.prev], na, n[nb.prev] ) != 0.0 || tArea( na, n[nb.prev], nb ) != 0.0 ) )
+        return true;
+
+    return tEquals( na, nb ) && tArea( n[na.prev], na, n[na.next] ) > 0.0
+           && tArea( n[nb.prev], nb, n[nb.next] ) > 0.0;
+}
+
+
+// join nodes a and b by a pair of edges, splitting the list in two;
+// returns the copy of b in the second list
+static int tSplitPolygon( std::vector<TESS_NODE>& n, int a, int b )
+{
+    int a2 = n.size();
+    int b2 = a2 + 1;
+    TESS_NODE ca = n[a];
+    TESS_NODE cb = n[b];
+    int an = ca.next;
+    int bp = cb.prev;
+
+    ca.z = 0;
+    ca.prevZ = -1;
+    ca.nextZ = -1;
+    cb.z = 0;
+    cb.prevZ = -1;
+    cb.nextZ = -1;
+
+    n.push_back( ca );
+    n.push_back( cb );
+
+    n[a].next = b;
+    n[b].prev = a;
+
+    n[a2].next = an;
+    n[an].prev = a2;
+
+    n[b2].next = a2;
+    n[a2].prev = b2;
+
+    n[bp].next = b2;
+    n[b2].prev = bp;
 
-    if( tess )
+    return b2;
+}
+
+
+// true if the node is a convex vertex with no other vertex inside its triangle
+static bool tIsEar( const std::vector<TESS_NODE>& n, int ear )
+{
+    const TESS_NODE& a = n[n[ear].prev];
+    const TESS_NODE& b = n[ear];
+    const TESS_NODE& c = n[n[ear].next];
+
+    if( tArea( a, b, c ) >= 0.0 )
+        return false;   // reflex
+
+    double x0 = std::min( a.x, std::min( b.x, c.x ) );
+    double y0 = std::min( a.y, std::min( b.y, c.y ) );
+    double x1 = std::max( a.x, std::max( b.x, c.x ) );
+    double y1 = std::max( a.y, std::max( b.y, c.y ) );
+
+    int p = c.next;
+
+    while( p != b.prev )
     {
-        gluDeleteTess( tess );
-        tess = NULL;
+        const TESS_NODE& np = n[p];
+
+        if( np.x >= x0 && np.x <= x1 && np.y >= y0 && np.y <= y1
+            && !( np.x == a.x && np.y == a.y )
+            && tPointInTriangle( a.x, a.y, b.x, b.y, c.x, c.y, np.x, np.y )
+            && tArea( n[np.prev], np, n[np.next] ) >= 0.0 )
+            return false;
+
+        p = np.next;
     }
+
+    return true;
 }
 
 
-// clear all data
-void TESSELATOR::Clear( void )
+// true if node p blocks the ear a, b, c
+static inline bool tBlocksEar( const std::vector<TESS_NODE>& n, int p, int a, int c,
+                               double x0, double y0, double x1, double y1 )
 {
-    int i;
+    const TESS_NODE& np = n[p];
+    const TESS_NODE& na = n[a];
+    const TESS_NODE& nb = n[na.next];
+    const TESS_NODE& nc = n[c];
+
+    return p != a && p != c
+           && np.x >= x0 && np.x <= x1 && np.y >= y0 && np.y <= y1
+           && !( np.x == na.x && np.y == na.y )
+           && tPointInTriangle( na.x, na.y, nb.x, nb.y, nc.x, nc.y, np.x, np.y )
+           && tArea( n[np.prev], np, n[np.next] ) >= 0.0;
+}
 
-    fix = false;
-    idx = 0;
 
-    for( i = contours.size(); i > 0; --i )
+// ear test which only examines the nodes within the z-order range of the ear
+static bool tIsEarHashed( const std::vector<TESS_NODE>& n, int ear, const TESS_HASH& aHash )
+{
+    int ia = n[ear].prev;
+    int ic = n[ear].next;
+    const TESS_NODE& a = n[ia];
+    const TESS_NODE& b = n[ear];
+    const TESS_NODE& c = n[ic];
+
+    if( tArea( a, b, c ) >= 0.0 )
+        return false;   // reflex
+
+    double x0 = std::min( a.x, std::min( b.x, c.x ) );
+    double y0 = std::min( a.y, std::min( b.y, c.y ) );
+    double x1 = std::max( a.x, std::max( b.x, c.x ) );
+    double y1 = std::max( a.y, std::max( b.y, c.y ) );
+
+    int minZ = tZOrder( x0, y0, aHash );
+    int maxZ = tZOrder( x1, y1, aHash );
+
+    int p = b.prevZ;
+    int q = b.nextZ;
+
+    // look for points inside the triangle in both directions
+    while( p >= 0 && n[p].z >= minZ && q >= 0 && n[q].z <= maxZ )
     {
-        delete contours.back();
-        contours.pop_back();
+        if( tBlocksEar( n, p, ia, ic, x0, y0, x1, y1 ) )
+            return false;
+
+        p = n[p].prevZ;
+
+        if( tBlocksEar( n, q, ia, ic, x0, y0, x1, y1 ) )
+            return false;
+
+        q = n[q].nextZ;
     }
 
-    areas.clear();
+    while( p >= 0 && n[p].z >= minZ )
+    {
+        if( tBlocksEar( n, p, ia, ic, x0, y0, x1, y1 ) )
+            return false;
+
+        p = n[p].prevZ;
+    }
+
+    while( q >= 0 && n[q].z <= maxZ )
+    {
+        if( tBlocksEar( n, q, ia, ic, x0, y0, x1, y1 ) )
+            return false;
+
+        q = n[q].nextZ;
+    }
+
+    return true;
+}
+
+
+static void tEarcut( std::vector<TESS_NODE>& n, int ear, std::vector<int>& tris,
+                     const TESS_HASH& aHash, int pass );
+
+
+// clip pairs of edges which cross each other locally
+static int tCureLocalIntersections( std::vector<TESS_NODE>& n, int aStart, std::vector<int>& tris )
+{
+    int p = aStart;
+
+    do
+    {
+        int a = n[p].prev;
+        int b = n[n[p].next].next;
+
+        if( !tEquals( n[a], n[b] ) && tIntersects( n[a], n[p], n[n[p].next], n[b] )
+            && tLocallyInside( n, a, b ) && tLocallyInside( n, b, a ) )
+        {
+            tris.push_back( n[a].id );
+            tris.push_back( n[p].id );
+            tris.push_back( n[b].id );
+
+            tRemoveNode( n, n[p].next );
+            tRemoveNode( n, p );
+
+            p = aStart = b;
+        }
+
+        p = n[p].next;
+    } while( p != aStart );
+
+    return tFilterPoints( n, p, -1 );
+}
+
+
+// split the polygon along a valid diagonal and clip each half
+static void tSplitEarcut( std::vector<TESS_NODE>& n, int aStart, std::vector<int>& tris,
+                          const TESS_HASH& aHash )
+{
+    int a = aStart;
+
+    do
+    {
+        int b = n[n[a].next].next;
+
+        while( b != n[a].prev )
+        {
+            if( n[a].id != n[b].id && tIsValidDiagonal( n, a, b ) )
+            {
+                int c = tSplitPolygon( n, a, b );
+
+                a = tFilterPoints( n, a, n[a].next );
+                c = tFilterPoints( n, c, n[c].next );
+
+                tEarcut( n, a, tris, aHash, 0 );
+                tEarcut( n, c, tris, aHash, 0 );
+                return;
+            }
+
+            b = n[b].next;
+        }
+
+        a = n[a].next;
+    } while( a != aStart );
+}
+
+
+// clip ears from the list; when no ear can be found the list is
+// cleaned up and progressively more tolerant strategies are applied
+static void tEarcut( std::vector<TESS_NODE>& n, int ear, std::vector<int>& tris,
+                     const TESS_HASH& aHash, int pass )
+{
+    if( ear < 0 )
+        return;
+
+    if( pass == 0 && aHash.invSize > 0.0 )
+        tIndexCurve( n, ear, aHash );
+
+    int stop = ear;
+
+    while( n[ear].prev != n[ear].next )
+    {
+        int prev = n[ear].prev;
+        int next = n[ear].next;
+
+        if( aHash.invSize > 0.0 ? tIsEarHashed( n, ear, aHash ) : tIsEar( n, ear ) )
+        {
+            tris.push_back( n[prev].id );
+            tris.push_back( n[ear].id );
+            tris.push_back( n[next].id );
+
+            tRemoveNode( n, ear );
+
+            // skipping the next vertex leads to fewer sliver triangles
+            ear = n[next].next;
+            stop = ear;
+            continue;
+        }
+
+        ear = next;
+
+        if( ear == stop )
+        {
+            if( pass == 0 )
+            {
+                tEarcut( n, tFilterPoints( n, ear, -1 ), tris, aHash, 1 );
+            }
+            else if( pass == 1 )
+            {
+                ear = tCureLocalIntersections( n, tFilterPoints( n, ear, -1 ), tris );
+                tEarcut( n, ear, tris, aHash, 2 );
+            }
+            else
+            {
+                tSplitEarcut( n, ear, tris, aHash );
+            }
+
+            break;
+        }
+    }
+}
+
+
+// true if the sector at m contains the sector at p (both have coincident vertices)
+static inline bool tSectorContainsSector( const std::vector<TESS_NODE>& n, int m, int p )
+{
+    return tArea( n[n[m].prev], n[m], n[n[p].prev] ) < 0.0
+           && tArea( n[n[p].next], n[m], n[n[m].next] ) < 0.0;
+}
+
+
+// find a vertex on the outer list which may be joined to the hole
+// vertex 'aHole' without crossing any edges; returns -1 on failure
+static int tFindHoleBridge( const std::vector<TESS_NODE>& n, int aHole, int aOuter )
+{
+    int p = aOuter;
+    int m = -1;
+    double hx = n[aHole].x;
+    double hy = n[aHole].y;
+    double qx = -HUGE_VAL;
+
+    // find the segment which is hit first by a ray cast from the hole towards -X
+    do
+    {
+        const TESS_NODE& np = n[p];
+        const TESS_NODE& nn = n[np.next];
+
+        if( hy <= np.y && hy >= nn.y && nn.y != np.y )
+        {
+            double x = np.x + ( hy - np.y ) * ( nn.x - np.x ) / ( nn.y - np.y );
+
+            if( x <= hx && x > qx )
+            {
+                qx = x;
+                m = ( np.x < nn.x ) ? p : np.next;
+
+                // the hole touches the outer segment
+                if( x == hx )
+                    return m;
+            }
+        }
+
+        p = np.next;
+    } while( p != aOuter );
+
+    if( m < 0 )
+        return -1;
+
+    // the endpoint 'm' is visible unless other vertices lie within the triangle
+    // formed by the hole vertex, the ray intersection and 'm'; in that case pick
+    // the vertex which forms the minimum angle with the ray
+    int stop = m;
+    double mx = n[m].x;
+    double my = n[m].y;
+    double tanMin = HUGE_VAL;
+    double tanCur;
+
+    p = m;
+
+    do
+    {
+        const TESS_NODE& np = n[p];
 
-    for( i = vertices.size(); i > 0; --i )
+        if( hx >= np.x && np.x >= mx && hx != np.x
+            && tPointInTriangle( hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, np.x, np.y ) )
+        {
+            tanCur = fabs( hy - np.y ) / ( hx - np.x );
+
+            if( tLocallyInside( n, p, aHole )
+                && ( tanCur < tanMin || ( tanCur == tanMin
+                        && ( np.x > n[m].x || ( np.x == n[m].x && tSectorContainsSector( n, m, p ) ) ) ) ) )
+            {
+                m = p;
+                tanMin = tanCur;
+            }
+        }
+
+        p = np.next;
+    } while( p != stop );
+
+    return m;
+}
+
+
+struct TESS_HOLE
+{
+    int     node;   // leftmost node of the hole
+    double  x;
+    double  y;
+
+    bool operator<( const TESS_HOLE& aHole ) const
+    {
+        if( x != aHole.x )
+            return x < aHole.x;
+
+        if( y != aHole.y )
+            return y < aHole.y;
+
+        return node < aHole.node;
+    }
+};
+
+
+// Process-wide cache of tesselation results. Entries are keyed by a
+// fingerprint of the quantized contours; the key itself is retained so
+// that hash collisions are detected. The cache is the only state shared
+// by TESSELATOR objects and all access to it is serialized by tessCacheLock.
+#define TESS_CACHE_MAX ( 256 )      // the cache is flushed when this size is reached
+#define TESS_CACHE_RES ( 1e6 )      // quantization of coordinates (1e-6 units)
+
+struct TESS_CACHE_ENTRY
+{
+    std::vector<double> key;        // quantized contour data
+    std::vector<int> triplets;
+    std::vector<int> oindex;
+    std::vector<int> ostart;
+    std::vector<int> ordmap;
+};
+
+typedef std::multimap< size_t, TESS_CACHE_ENTRY > TESS_CACHE;
+
+static bool tessCacheEnabled = false;
+static TESS_CACHE tessCache;
+static pthread_mutex_t tessCacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+// holds tessCacheLock for the lifetime of the object
+class TESS_CACHE_LOCK
+{
+public:
+    TESS_CACHE_LOCK()
+    {
+        pthread_mutex_lock( &tessCacheLock );
+    }
+
+    ~TESS_CACHE_LOCK()
+    {
+        pthread_mutex_unlock( &tessCacheLock );
+    }
+};
+
+
+static bool tCacheEnabled( void )
+{
+    TESS_CACHE_LOCK lock;
+    return tessCacheEnabled;
+}
+
+
+// FNV-1a hash of the fingerprint data
+static size_t tHashKey( const std::vector<double>& aKey )
+{
+    size_t h = (size_t) 2166136261UL;
+    const unsigned char* bp = (const unsigned char*) &aKey[0];
+    const unsigned char* ep = bp + aKey.size() * sizeof( double );
+
+    while( bp != ep )
     {
-        delete vertices.back();
-        vertices.pop_back();
+        h ^= *bp++;
+        h *= (size_t) 16777619UL;
     }
 
+    return h;
+}
+
+
+TESSELATOR::TESSELATOR()
+{
+    // arc parameters suitable to mm measurements
+    maxArcSeg = 48;
+    minSegLength = 0.1;
+    maxSegLength = 0.5;
+
+    fix = false;
+    Fault = false;
+    idx = 0;
+    ord = 0;
+    idxout = 0;
+}
+
+
+TESSELATOR::~TESSELATOR()
+{
+    Clear();
+}
+
+
+// clear all data
+void TESSELATOR::Clear( void )
+{
+    fix = false;
+    idx = 0;
+
+    vertices.clear();
+    cindex.clear();
+    cstart.clear();
+    csize.clear();
+    areas.clear();
+
     clearTmp();
 }
 
@@ -199,38 +913,125 @@ void TESSELATOR::clearTmp( void )
     unsigned int i;
 
     Fault   = false;
-    eidx    = 0;
     ord = 0;
-    glcmd = 0;
 
     triplets.clear();
+    oindex.clear();
+    ostart.clear();
+    ordmap.clear();
 
-    for( i = outline.size(); i > 0; --i )
+    // go through the vertex list and reset ephemeral parameters
+    for( i = 0; i < vertices.size(); ++i )
     {
-        delete outline.back();
-        outline.pop_back();
+        vertices[i].o = -1;
     }
+}
 
-    ordmap.clear();
 
-    for( i = extra_verts.size(); i > 0; --i )
+// enable or disable the process-wide tesselation cache
+void TESSELATOR::EnableCache( bool aEnable )
+{
+    TESS_CACHE_LOCK lock;
+
+    tessCacheEnabled = aEnable;
+
+    if( !aEnable )
+        tessCache.clear();
+}
+
+
+// discard all results held in the process-wide cache
+void TESSELATOR::ClearCache( void )
+{
+    TESS_CACHE_LOCK lock;
+
+    tessCache.clear();
+}
+
+
+// build the cache key; the key holds the contour structure and winding
+// followed by the quantized coordinates of all vertices in index order
+void TESSELATOR::makeFingerprint( std::vector<double>& aKey )
+{
+    size_t nc = csize.size();
+
+    aKey.clear();
+    aKey.reserve( 2 + 2 * nc + cindex.size() + 2 * vertices.size() );
+    aKey.push_back( vertices.size() );
+    aKey.push_back( nc );
+
+    for( size_t i = 0; i < nc; ++i )
     {
-        delete extra_verts.back();
-        extra_verts.pop_back();
+        aKey.push_back( csize[i] );
+        aKey.push_back( areas[i] > 0.0 ? 1.0 : 0.0 );
     }
 
-    // note: unlike outline and extra_verts,
-    // vlist is not responsible for memory management
-    vlist.clear();
+    aKey.insert( aKey.end(), cindex.begin(), cindex.end() );
 
-    // go through the vertex list and reset ephemeral parameters
-    for( i = 0; i < vertices.size(); ++i )
+    for( size_t i = 0; i < vertices.size(); ++i )
     {
-        vertices[i]->o = -1;
+        aKey.push_back( floor( vertices[i].x * TESS_CACHE_RES + 0.5 ) );
+        aKey.push_back( floor( vertices[i].y * TESS_CACHE_RES + 0.5 ) );
     }
 }
 
 
+// retrieve a previous result from the cache; returns true on success
+bool TESSELATOR::loadCached( const std::vector<double>& aKey, size_t aHash )
+{
+    TESS_CACHE_LOCK lock;
+
+    if( !tessCacheEnabled )
+        return false;
+
+    std::pair< TESS_CACHE::iterator, TESS_CACHE::iterator > range = tessCache.equal_range( aHash );
+
+    while( range.first != range.second )
+    {
+        TESS_CACHE_ENTRY& ce = range.first->second;
+
+        if( ce.key == aKey )
+        {
+            triplets = ce.triplets;
+            oindex = ce.oindex;
+            ostart = ce.ostart;
+            ordmap = ce.ordmap;
+            ord = ordmap.size();
+
+            for( int i = 0; i < ord; ++i )
+                vertices[ ordmap[i] ].o = i;
+
+            return true;
+        }
+
+        ++range.first;
+    }
+
+    return false;
+}
+
+
+// place the current result in the cache; aKey is consumed
+void TESSELATOR::storeCached( std::vector<double>& aKey, size_t aHash )
+{
+    TESS_CACHE_LOCK lock;
+
+    if( !tessCacheEnabled )
+        return;
+
+    if( tessCache.size() >= TESS_CACHE_MAX )
+        tessCache.clear();
+
+    TESS_CACHE::iterator ce = tessCache.insert( std::make_pair( aHash, TESS_CACHE_ENTRY() ) );
+
+    ce->second.key.swap( aKey );
+    ce->second.triplets = triplets;
+    ce->second.oindex = oindex;
+    ce->second.ostart = ostart;
+    ce->second.ordmap = ordmap;
+}
+
+
 // create a new contour to be populated; returns an index
 // into the contour list or -1 if there are problems
 int TESSELATOR::NewContour( void )
@@ -238,15 +1039,50 @@ int TESSELATOR::NewContour( void )
     if( fix )
         return -1;
 
-    std::list<int>* contour = new std::list<int>;
+    cstart.push_back( cindex.size() );
+    csize.push_back( 0 );
+    areas.push_back( 0.0 );
 
-    if( !contour )
-        return -1;
+    return csize.size() - 1;
+}
 
-    contours.push_back( contour );
-    areas.push_back( 0.0 );
 
-    return contours.size() - 1;
+// append a vertex to the vertex list and place its index at the end
+// of the given contour; the contour's partial area is updated
+void TESSELATOR::pushVertex( int aContourID, double aXpos, double aYpos )
+{
+    VERTEX_3D vertex;
+
+    vertex.x    = aXpos;
+    vertex.y    = aYpos;
+    vertex.i    = idx++;
+    vertex.o    = -1;
+
+    int  pos = cstart[aContourID] + csize[aContourID];
+
+    if( csize[aContourID] > 0 )
+    {
+        const VERTEX_3D& v2 = vertices[ cindex[pos - 1] ];
+        areas[aContourID] += ( aXpos - v2.x ) * ( aYpos + v2.y );
+    }
+
+    vertices.push_back( vertex );
+
+    // contours are normally filled one at a time so this is an append;
+    // otherwise the entries of all subsequent contours are shifted
+    if( pos == (int) cindex.size() )
+    {
+        cindex.push_back( vertex.i );
+    }
+    else
+    {
+        cindex.insert( cindex.begin() + pos, vertex.i );
+
+        for( size_t i = aContourID + 1; i < cstart.size(); ++i )
+            ++cstart[i];
+    }
+
+    ++csize[aContourID];
 }
 
 
@@ -261,35 +1097,13 @@ bool TESSELATOR::AddVertex( int aContourID, double aXpos, double aYpos )
         return false;
     }
 
-    if( aContourID < 0 || (unsigned int) aContourID >= contours.size() )
+    if( aContourID < 0 || (unsigned int) aContourID >= csize.size() )
     {
         error = "AddVertex(): aContour is not within a valid range";
         return false;
     }
 
-    VERTEX_3D* vertex = new VERTEX_3D;
-
-    if( !vertex )
-    {
-        error = "AddVertex(): a new vertex could not be allocated";
-        return false;
-    }
-
-    vertex->x   = aXpos;
-    vertex->y   = aYpos;
-    vertex->i   = idx++;
-    vertex->o   = -1;
-
-    VERTEX_3D* v2 = NULL;
-
-    if( contours[aContourID]->size() > 0 )
-        v2 = vertices[ contours[aContourID]->back() ];
-
-    vertices.push_back( vertex );
-    contours[aContourID]->push_back( vertex->i );
-
-    if( v2 )
-        areas[aContourID] += ( aXpos - v2->x ) * ( aYpos + v2->y );
+    pushVertex( aContourID, aXpos, aYpos );
 
     return true;
 }
@@ -320,31 +1134,148 @@ bool TESSELATOR::AddPolygon( const KC3D::POLYGON& aPolygon, bool aHoleFlag )
     if( poly < 0 )
         return false;
 
+    vertices.reserve( vertices.size() + nVerts );
+    cindex.reserve( cindex.size() + nVerts );
+
     for( int i = 0; i < nVerts; ++ i)
+        pushVertex( poly, px[i], py[i] );
+
+    EnsureWinding( poly, aHoleFlag );
+
+    return true;
+}
+
+
+// set the parameters used to discretize arcs and circles
+bool TESSELATOR::SetArcParams( int aMaxArcSeg, double aMinSegLength, double aMaxSegLength )
+{
+    if( aMaxArcSeg < 3 )
     {
-        VERTEX_3D* vertex = new VERTEX_3D;
+        error = "SetArcParams(): aMaxArcSeg must be >= 3";
+        return false;
+    }
 
-        if( !vertex )
-        {
-            error = "AddPolygon(): a new vertex could not be allocated";
-            return false;
-        }
+    if( aMinSegLength <= 0.0 || aMaxSegLength < aMinSegLength )
+    {
+        error = "SetArcParams(): invalid segment lengths (0 < aMinSegLength <= aMaxSegLength)";
+        return false;
+    }
+
+    maxArcSeg = aMaxArcSeg;
+    minSegLength = aMinSegLength;
+    maxSegLength = aMaxSegLength;
+
+    return true;
+}
+
+
+// determine the number of segments for an arc; small arcs are limited
+// by maxArcSeg and minSegLength while large arcs have segments no longer
+// than maxSegLength
+int TESSELATOR::arcSegments( double aRadius, double aSweepAngle )
+{
+    double sweep = fabs( aSweepAngle );
+    double len = aRadius * sweep;
+
+    int ns = (int) ceil( maxArcSeg * sweep / ( 2.0 * M_PI ) - 1e-9 );
+    int nl = (int) floor( len / minSegLength );
 
-        vertex->x   = px[i];
-        vertex->y   = py[i];
-        vertex->i   = idx++;
-        vertex->o   = -1;
+    if( nl < ns )
+        ns = nl;
 
-        VERTEX_3D* v2 = NULL;
+    nl = (int) ceil( len / maxSegLength - 1e-9 );
 
-        if( contours[poly]->size() > 0 )
-            v2 = vertices[ contours[poly]->back() ];
+    if( nl > ns )
+        ns = nl;
 
-        vertices.push_back( vertex );
-        contours[poly]->push_back( vertex->i );
+    // a full circle must remain a polygon
+    nl = (int) ceil( 3.0 * sweep / ( 2.0 * M_PI ) - 1e-9 );
 
-        if( v2 )
-            areas[poly] += ( px[i] - v2->x ) * ( py[i] + v2->y );
+    if( ns < nl )
+        ns = nl;
+
+    if( ns < 1 )
+        ns = 1;
+
+    return ns;
+}
+
+
+bool TESSELATOR::AddArc( int aContourID, double aXcenter, double aYcenter, double aRadius,
+                         double aStartAngle, double aSweepAngle )
+{
+    if( fix )
+    {
+        error = "AddArc(): no more vertices may be added (Tesselate was previously executed)";
+        return false;
+    }
+
+    if( aContourID < 0 || (unsigned int) aContourID >= csize.size() )
+    {
+        error = "AddArc(): aContour is not within a valid range";
+        return false;
+    }
+
+    if( aRadius < 1e-9 )
+    {
+        error = "AddArc(): invalid radius";
+        return false;
+    }
+
+    if( aSweepAngle > 2.0 * M_PI || aSweepAngle < -2.0 * M_PI )
+    {
+        error = "AddArc(): sweep angle exceeds a full circle";
+        return false;
+    }
+
+    int ns = arcSegments( aRadius, aSweepAngle );
+    double da = aSweepAngle / ns;
+    double ang;
+
+    vertices.reserve( vertices.size() + ns + 1 );
+    cindex.reserve( cindex.size() + ns + 1 );
+
+    for( int i = 0; i <= ns; ++i )
+    {
+        ang = aStartAngle + i * da;
+        pushVertex( aContourID, aXcenter + aRadius * cos( ang ), aYcenter + aRadius * sin( ang ) );
+    }
+
+    return true;
+}
+
+
+bool TESSELATOR::AddCircle( double aXcenter, double aYcenter, double aRadius, bool aHoleFlag )
+{
+    if( fix )
+    {
+        error = "AddCircle(): no more vertices may be added (Tesselate was previously executed)";
+        return false;
+    }
+
+    if( aRadius < 1e-9 )
+    {
+        error = "AddCircle(): invalid radius";
+        return false;
+    }
+
+    int poly = NewContour();
+
+    if( poly < 0 )
+        return false;
+
+    int ns = arcSegments( aRadius, 2.0 * M_PI );
+    double da = 2.0 * M_PI / ns;
+    double ang;
+
+    vertices.reserve( vertices.size() + ns );
+    cindex.reserve( cindex.size() + ns );
+
+    // the vertices are generated CCW; holes are reversed by EnsureWinding
+    for( int i = 0; i < ns; ++i )
+    {
+        ang = i * da;
+        pushVertex( poly, aXcenter + aRadius * cos( ang ), aYcenter + aRadius * sin( ang ) );
     }
 
     EnsureWinding( poly, aHoleFlag );
@@ -357,31 +1288,31 @@ bool TESSELATOR::AddPolygon( const KC3D::POLYGON& aPolygon, bool aHoleFlag )
 // set 'hole' to true to ensure a hole (clockwise winding)
 bool TESSELATOR::EnsureWinding( int aContourID, bool aHoleFlag )
 {
-    if( aContourID < 0 || (unsigned int) aContourID >= contours.size() )
+    if( aContourID < 0 || (unsigned int) aContourID >= csize.size() )
     {
         error = "EnsureWinding(): aContour is outside the valid range";
         return false;
     }
 
-    std::list<int>* cp = contours[aContourID];
-
-    if( cp->size() < 3 )
+    if( csize[aContourID] < 3 )
     {
         error = "EnsureWinding(): there are fewer than 3 vertices";
         return false;
     }
 
+    std::vector<int>::iterator sp = cindex.begin() + cstart[aContourID];
+    std::vector<int>::iterator ep = sp + csize[aContourID];
     double dir = areas[aContourID];
 
-    VERTEX_3D* vp0 = vertices[ cp->back() ];
-    VERTEX_3D* vp1 = vertices[ cp->front() ];
+    const VERTEX_3D& vp0 = vertices[ *( ep - 1 ) ];
+    const VERTEX_3D& vp1 = vertices[ *sp ];
 
-    dir += ( vp1->x - vp0->x ) * ( vp1->y + vp0->y );
+    dir += ( vp1.x - vp0.x ) * ( vp1.y + vp0.y );
 
     // if dir is positive, winding is CW
     if( ( aHoleFlag && dir < 0 ) || ( !aHoleFlag && dir > 0 ) )
     {
-        cp->reverse();
+        std::reverse( sp, ep );
         areas[aContourID] = -areas[aContourID];
     }
 
@@ -393,210 +1324,311 @@ bool TESSELATOR::EnsureWinding( int aContourID, bool aHoleFlag )
 // returns true if all was fine, false otherwise
 bool TESSELATOR::Tesselate( void )
 {
-    if( !tess )
+    Fault   = false;
+
+    if( csize.size() < 1 || vertices.size() < 3 )
     {
-        error = "Tesselate(): GLU tesselator was not initialized";
+        error = __FUNCTION__;
+        error.append( "(): not enough vertices" );
         return false;
     }
 
-    Fault   = false;
+    // finish the winding calculation on all vertices prior to setting 'fix'
+    if( !fix )
+    {
+        for( unsigned int i = 0; i < csize.size(); ++i )
+        {
+            if( csize[i] < 3 )
+                continue;
 
-    gluTessProperty( tess, GLU_TESS_WINDING_RULE, GLU_TESS_WINDING_POSITIVE );
+            const VERTEX_3D& vp0 = vertices[ cindex[cstart[i] + csize[i] - 1] ];
+            const VERTEX_3D& vp1 = vertices[ cindex[cstart[i]] ];
+            areas[i] += ( vp1.x - vp0.x ) * ( vp1.y + vp0.y );
+        }
+    }
+
+    // prevent the addition of any further contours and contour vertices
+    fix = true;
+
+    // clear temporary internals which may have been used in a previous run
+    clearTmp();
 
-    if( contours.size() < 1 || vertices.size() < 3 )
+    if( checkNContours( false ) == 0 )
     {
-        error = __FUNCTION__;
-        error.append( "(): not enough vertices" );
+        error = "tesselate(): no solid contours";
         return false;
     }
 
-    // finish the winding calculation on all vertices prior to setting 'fix'
-    if( !fix )
+    // a previously tesselated identical outline only needs to be transformed
+    std::vector<double> key;
+    size_t hash = 0;
+    bool useCache = tCacheEnabled();
+
+    if( useCache )
+    {
+        makeFingerprint( key );
+        hash = tHashKey( key );
+
+        if( loadCached( key, hash ) )
+            return true;
+    }
+
+    // assign each hole to the smallest solid which contains its first vertex
+    int nc = csize.size();
+    std::vector<int> owner( nc, -1 );
+    int i, j;
+
+    for( i = 0; i < nc; ++i )
     {
-        for( unsigned int i = 0; i < contours.size(); ++i )
+        if( csize[i] < 3 || areas[i] <= 0.0 )
+            continue;
+
+        const VERTEX_3D& hp = vertices[ cindex[cstart[i]] ];
+
+        for( j = 0; j < nc; ++j )
         {
-            if( contours[i]->size() < 3 )
+            if( csize[j] < 3 || areas[j] > 0.0 )
                 continue;
 
-            VERTEX_3D* vp0 = vertices[ contours[i]->back() ];
-            VERTEX_3D* vp1 = vertices[ contours[i]->front() ];
-            areas[i] += ( vp1->x - vp0->x ) * ( vp1->y + vp0->y );
-        }
-    }
+            if( owner[i] >= 0 && -areas[j] >= -areas[owner[i]] )
+                continue;
 
-    // prevent the addition of any further contours and contour vertices
-    fix = true;
+            // point in polygon test
+            bool inside = false;
+            const int* sp = &cindex[cstart[j]];
+            const int* ep = sp + csize[j];
+            const VERTEX_3D* p0 = &vertices[ *( ep - 1 ) ];
+            const VERTEX_3D* p1;
 
-    // clear temporary internals which may have been used in a previous run
-    clearTmp();
+            while( sp != ep )
+            {
+                p1 = &vertices[ *sp ];
 
-    // request an outline
-    gluTessProperty( tess, GLU_TESS_BOUNDARY_ONLY, GL_TRUE );
+                if( ( ( p1->y > hp.y ) != ( p0->y > hp.y ) )
+                    && ( hp.x < ( p0->x - p1->x ) * ( hp.y - p1->y ) / ( p0->y - p1->y ) + p1->x ) )
+                    inside = !inside;
 
-    eidx = idx;
+                p0 = p1;
+                ++sp;
+            }
 
-    if( checkNContours( false ) == 0 )
-    {
-        error = "tesselate(): no solid contours";
-        return false;
+            if( inside )
+                owner[i] = j;
+        }
     }
 
-    // open the polygon
-    gluTessBeginPolygon( tess, this );
+    std::vector<int> holes;
+
+    for( i = 0; i < nc; ++i )
+    {
+        if( csize[i] < 3 || areas[i] > 0.0 )
+            continue;
 
-    // add solid outlines
-    pushVertices( false );
+        holes.clear();
 
-    // close the polygon
-    gluTessEndPolygon( tess );
+        for( j = 0; j < nc; ++j )
+        {
+            if( owner[j] == i )
+                holes.push_back( j );
+        }
 
-    if( Fault )
-        return false;
+        if( !tesselateContour( i, holes ) )
+            return false;
+    }
 
-    // if there are no outlines we cannot proceed
-    if( outline.empty() )
+    // if there are no facets we cannot proceed
+    if( triplets.empty() )
     {
+        Fault = true;
         error = "tesselate(): no points in result";
         return false;
     }
 
-    // at this point we have a solid outline; add it to the tesselator
-    gluTessBeginPolygon( tess, this );
+    // a faulty result is not cached so that each caller sees the fault
+    if( useCache && !Fault )
+        storeCached( key, hash );
 
-    if( !pushOutline( ) )
-        return false;
+    return true;
+}
 
-    // add the holes contained by this object
-    pushVertices( true );
 
-    if( Fault )
-        return false;
+// copy a contour into the outline list; vertices are assigned an
+// output order as they are encountered
+int TESSELATOR::pushOutline( int aContourID )
+{
+    const int* sp = &cindex[cstart[aContourID]];
+    const int* ep = sp + csize[aContourID];
+    size_t start = oindex.size();
+    VERTEX_3D* vp;
+    VERTEX_3D* vl = NULL;
 
-    // erase the previous outline data and vertex order
-    // but preserve the extra vertices
-    while( !outline.empty() )
+    while( sp != ep )
     {
-        delete outline.back();
-        outline.pop_back();
-    }
+        vp = &vertices[ *sp ];
+        ++sp;
 
-    ordmap.clear();
-    ord = 0;
+        // skip repeated points
+        if( vl && vl->x == vp->x && vl->y == vp->y )
+            continue;
 
-    // go through the vertex lists and reset ephemeral parameters
-    for( unsigned int i = 0; i < vertices.size(); ++i )
-    {
-        vertices[i]->o = -1;
-    }
+        if( vp->o < 0 )
+        {
+            vp->o = ord++;
+            ordmap.push_back( vp->i );
+        }
 
-    for( unsigned int i = 0; i < extra_verts.size(); ++i )
-    {
-        extra_verts[i]->o = -1;
+        oindex.push_back( vp->o );
+        vl = vp;
     }
 
-    // close the polygon; this creates the outline points
-    // and the point ordering list 'ordmap'
-    gluTessEndPolygon( tess );
-
-    // repeat the last operation but request a tesselated surface
-    // rather than an outline; this creates the triangles list.
-    gluTessProperty( tess, GLU_TESS_BOUNDARY_ONLY, GL_FALSE );
+    // skip a closing point
+    vp = &vertices[ cindex[cstart[aContourID]] ];
 
-    gluTessBeginPolygon( tess, this );
+    if( oindex.size() - start > 1 && vl->x == vp->x && vl->y == vp->y )
+        oindex.pop_back();
 
-    if( !pushOutline() )
-        return false;
+    int nv = oindex.size() - start;
 
-    gluTessEndPolygon( tess );
+    if( nv < 3 )
+    {
+        oindex.resize( start );
+        return 0;
+    }
 
-    if( Fault )
-        return false;
+    ostart.push_back( start );
 
-    return true;
+    return nv;
 }
 
 
-bool TESSELATOR::pushOutline( void )
+// triangulate a solid contour and its holes
+bool TESSELATOR::tesselateContour( int aSolidID, const std::vector<int>& aHoleList )
 {
-    // traverse the outline list to push all used vertices
-    if( outline.size() < 1 )
+    int nv = pushOutline( aSolidID );
+
+    if( nv < 3 )
+        return true;
+
+    std::vector<TESS_NODE> nodes;
+    std::vector<TESS_HOLE> hlist;
+    const int* sp;
+    const int* ep;
+    int last;
+    const VERTEX_3D* vp;
+
+    // the solid contour, without repeated points
+    nodes.reserve( 2 * vertices.size() );
+    hlist.reserve( aHoleList.size() );
+    sp = &oindex[ostart.back()];
+    ep = sp + nv;
+    last = -1;
+
+    for( ; sp != ep; ++sp )
     {
-        error = "pushOutline() failed: no vertices to push";
-        return false;
+        vp = &vertices[ ordmap[*sp] ];
+        last = tInsertNode( nodes, vp->i, vp->x, vp->y, last );
     }
 
-    std::list<std::list<int>*>::const_iterator obeg = outline.begin();
-    std::list<std::list<int>*>::const_iterator oend = outline.end();
-
-    int nc = 0; // number of contours pushed
+    int outer = last;
 
-    int pi;
-    std::list<int>::const_iterator  begin;
-    std::list<int>::const_iterator  end;
-    GLdouble pt[3];
-    VERTEX_3D* vp;
+    // the z-order index is only worthwhile for larger outlines
+    TESS_HASH hash;
+    hash.minX = 0.0;
+    hash.minY = 0.0;
+    hash.invSize = 0.0;
 
-    while( obeg != oend )
+    if( (int) vertices.size() > TESS_HASH_MIN )
     {
-        if( (*obeg)->size() < 3 )
+        double maxX, maxY;
+        int p = outer;
+
+        hash.minX = maxX = nodes[p].x;
+        hash.minY = maxY = nodes[p].y;
+
+        do
         {
-            ++obeg;
+            hash.minX = std::min( hash.minX, nodes[p].x );
+            hash.minY = std::min( hash.minY, nodes[p].y );
+            maxX = std::max( maxX, nodes[p].x );
+            maxY = std::max( maxY, nodes[p].y );
+            p = nodes[p].next;
+        } while( p != outer );
+
+        hash.invSize = std::max( maxX - hash.minX, maxY - hash.minY );
+
+        if( hash.invSize != 0.0 )
+            hash.invSize = 32767.0 / hash.invSize;
+    }
+
+    // the holes; each is recorded via its leftmost vertex
+    for( size_t i = 0; i < aHoleList.size(); ++i )
+    {
+        nv = pushOutline( aHoleList[i] );
+
+        if( nv < 3 )
             continue;
-        }
 
-        gluTessBeginContour( tess );
+        sp = &oindex[ostart.back()];
+        ep = sp + nv;
+        last = -1;
 
-        begin = (*obeg)->begin();
-        end = (*obeg)->end();
+        TESS_HOLE hole;
+        hole.node = -1;
 
-        while( begin != end )
+        for( ; sp != ep; ++sp )
         {
-            pi = *begin;
+            vp = &vertices[ ordmap[*sp] ];
+            last = tInsertNode( nodes, vp->i, vp->x, vp->y, last );
 
-            if( pi < 0 || (unsigned int) pi > ordmap.size() )
+            if( hole.node < 0 || vp->x < hole.x || ( vp->x == hole.x && vp->y < hole.y ) )
             {
-                gluTessEndContour( tess );
-                error = "pushOutline():BUG: *outline.begin() is not a valid index to ordmap";
-                return false;
+                hole.node = last;
+                hole.x = vp->x;
+                hole.y = vp->y;
             }
+        }
 
-            // retrieve the actual index
-            pi = ordmap[pi];
+        hlist.push_back( hole );
+    }
 
-            vp = getVertexByIndex( pi );
+    // bridge the holes from left to right
+    std::sort( hlist.begin(), hlist.end() );
 
-            if( !vp )
-            {
-                gluTessEndContour( tess );
-                error = "pushOutline():: BUG: ordmap[n] is not a valid index to vertices[]";
-                return false;
-            }
+    for( size_t i = 0; i < hlist.size(); ++i )
+    {
+        int bridge = tFindHoleBridge( nodes, hlist[i].node, outer );
 
-            pt[0]   = vp->x;
-            pt[1]   = vp->y;
-            pt[2]   = 0.0;
-            gluTessVertex( tess, pt, vp );
-            ++begin;
+        // the hole is omitted from the result
+        if( bridge < 0 )
+        {
+            Fault = true;
+            error = "tesselate(): a hole could not be joined to its outline";
+            continue;
         }
 
-        gluTessEndContour( tess );
-        ++obeg;
-        ++nc;
-    }
+        int bridgeReverse = tSplitPolygon( nodes, bridge, hlist[i].node );
 
-    if( !nc )
-    {
-        error = "pushOutline():: no valid contours available";
-        return false;
+        tFilterPoints( nodes, bridgeReverse, nodes[bridgeReverse].next );
+        outer = tFilterPoints( nodes, bridge, nodes[bridge].next );
     }
 
+    std::vector<int> tris;
+    tris.reserve( 3 * nodes.size() );
+
+    tEarcut( nodes, outer, tris, hash, 0 );
+
+    triplets.reserve( triplets.size() + tris.size() );
+
+    for( size_t i = 0; i + 2 < tris.size(); i += 3 )
+        addTriplet( vertices[ tris[i] ], vertices[ tris[i + 1] ], vertices[ tris[i + 2] ] );
+
     return true;
 }
 
 
 // writes out the vertex list for a planar feature
 bool TESSELATOR::WriteVertices( std::ofstream& aOutFile, int aPrecision,
-                                KC3D::TRANSFORM& aTransform, int aTabDepth )
+                                KC3D::TRANSFORM& aTransform, int aTabDepth, double aZpos )
 {
     if( ordmap.size() < 3 )
     {
@@ -616,7 +1648,7 @@ bool TESSELATOR::WriteVertices( std::ofstream& aOutFile, int aPrecision,
     if( !vp )
         return false;
 
-    q0 = QUAT( 0, vp->x, vp->y, 0 );
+    q0 = QUAT( 0, vp->x, vp->y, aZpos );
     aTransform.Transform( q0 );
 
     std::string strx, stry, strz;
@@ -639,7 +1671,7 @@ bool TESSELATOR::WriteVertices( std::ofstream& aOutFile, int aPrecision,
         if( !vp )
             return false;
 
-        q0 = QUAT( 0, vp->x, vp->y, 0 );
+        q0 = QUAT( 0, vp->x, vp->y, aZpos );
         aTransform.Transform( q0 );
 
         FormatDoublet( q0.x, q0.y, aPrecision, strx, stry );
@@ -658,7 +1690,7 @@ bool TESSELATOR::WriteVertices( std::ofstream& aOutFile, int aPrecision,
 // writes out the index list;
 // 'top' indicates the vertex ordering and should be
 // true for a polygon visible from above the PCB
-bool TESSELATOR::WriteIndices( bool aTopFlag, std::ofstream& aOutFile, int aTabDepth )
+bool TESSELATOR::WriteIndices( bool aTopFlag, std::ofstream& aOutFile, int aTabDepth, int aOffset )
 {
     if( triplets.empty() )
     {
@@ -666,261 +1698,132 @@ bool TESSELATOR::WriteIndices( bool aTopFlag, std::ofstream& aOutFile, int aTabD
         return false;
     }
 
-    // go through the triplet list and write out the indices based on order
-    std::list<TRIPLET_3D>::const_iterator   tbeg    = triplets.begin();
-    std::list<TRIPLET_3D>::const_iterator   tend    = triplets.end();
+    // go through the triplet list and write out the indices based on order;
+    // each facet occupies 3 consecutive entries
+    const int* tbeg = &triplets[0];
+    const int* tend = tbeg + triplets.size();
+
+    // swap the first two indices to reverse the facet winding
+    int k1 = aTopFlag ? 0 : 1;
+    int k2 = aTopFlag ? 1 : 0;
 
     string fmt( (aTabDepth + 1) * 4, ' ' );
     aOutFile << fmt << "   ";
 
     int i = 1;
 
-    if( aTopFlag )
-        aOutFile << fmt << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
-    else
-        aOutFile << fmt << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
+    aOutFile << fmt << tbeg[k1] + aOffset << ", " << tbeg[k2] + aOffset << ", ";
+    aOutFile << tbeg[2] + aOffset  << ", -1";
 
-    ++tbeg;
+    tbeg += 3;
 
     while( tbeg != tend )
     {
         if( (i++ & 7) == 4 )
         {
             i = 1;
-
-            if( aTopFlag )
-            {
-                aOutFile << ",\n" << fmt << tbeg->i1 << ", " << tbeg->i2 << ", ";
-                aOutFile << tbeg->i3  << ", -1";
-            }
-            else
-            {
-                aOutFile << ",\n" << fmt << tbeg->i2 << ", " << tbeg->i1 << ", ";
-                aOutFile << tbeg->i3  << ", -1";
-            }
+            aOutFile << ",\n" << fmt << tbeg[k1] + aOffset << ", " << tbeg[k2] + aOffset << ", ";
+            aOutFile << tbeg[2] + aOffset  << ", -1";
         }
         else
         {
-            if( aTopFlag )
-                aOutFile << ", " << tbeg->i1 << ", " << tbeg->i2 << ", " << tbeg->i3  << ", -1";
-            else
-                aOutFile << ", " << tbeg->i2 << ", " << tbeg->i1 << ", " << tbeg->i3  << ", -1";
+            aOutFile << ", " << tbeg[k1] + aOffset << ", " << tbeg[k2] + aOffset << ", ";
+            aOutFile << tbeg[2] + aOffset  << ", -1";
         }
 
-        ++tbeg;
+        tbeg += 3;
     }
 
     return !aOutFile.fail();
 }
 
 
-// add a triangular facet (triplet) to the ouptut index list
-bool TESSELATOR::addTriplet( VERTEX_3D* p0, VERTEX_3D* p1, VERTEX_3D* p2 )
-{
-    double  dx0 = p1->x - p0->x;
-    double  dx1 = p2->x - p0->x;
-
-    double  dy0 = p1->y - p0->y;
-    double  dy1 = p2->y - p0->y;
-
-    // this number is chosen because we shall only write 9 decimal places
-    // at most on the VRML output
-    double err = 0.000000001;
-
-    // test if the triangles are degenerate (parallel sides)
-
-    if( dx0 < err && dx0 > -err && dx1 < err && dx1 > -err )
-        return false;
-
-    if( dy0 < err && dy0 > -err && dy1 < err && dy1 > -err )
-        return false;
-
-    double  sl0 = dy0 / dx0;
-    double  sl1 = dy1 / dx1;
-
-    double dsl = sl1 - sl0;
-
-    if( dsl < err && dsl > -err )
-        return false;
-
-    triplets.push_back( TRIPLET_3D( p0->o, p1->o, p2->o ) );
-
-    return true;
-}
-
-
-// add an extra vertex (to be called only by the COMBINE callback)
-VERTEX_3D* TESSELATOR::AddExtraVertex( double aXpos, double aYpos )
-{
-    VERTEX_3D* vertex = new VERTEX_3D;
-
-    if( !vertex )
-    {
-        error = "AddExtraVertex(): could not allocate a new vertex";
-        return NULL;
-    }
-
-    if( eidx == 0 )
-        eidx = idx;
-
-    vertex->x   = aXpos;
-    vertex->y   = aYpos;
-    vertex->i   = eidx++;
-    vertex->o   = -1;
-
-    extra_verts.push_back( vertex );
-
-    return vertex;
-}
-
-
-// start a GL command list
-void TESSELATOR::glStart( GLenum cmd )
-{
-    glcmd = cmd;
-
-    while( !vlist.empty() )
-        vlist.pop_back();
-}
-
-
-// process a vertex
-void TESSELATOR::glPushVertex( VERTEX_3D* vertex )
+// writes out the side walls of a slab; the vertices of the lower face
+// are numbered from 0 and those of the upper face from ordmap.size()
+bool TESSELATOR::writeWalls( bool aUpFlag, std::ofstream& aOutFile, int aTabDepth )
 {
-    if( vertex->o < 0 )
+    if( ostart.empty() )
     {
-        vertex->o = ord++;
-        ordmap.push_back( vertex->i );
+        error = "writeWalls(): no outline to write";
+        return false;
     }
 
-    vlist.push_back( vertex );
-}
+    string fmt( (aTabDepth + 1) * 4, ' ' );
+    aOutFile << fmt << "   ";
 
+    int nv = ordmap.size();
+    int nw = 0;     // number of walls written
+    size_t nl = ostart.size();
 
-// end a GL command list
-void TESSELATOR::glEnd( void )
-{
-    switch( glcmd )
+    for( size_t i = 0; i < nl; ++i )
     {
-        case GL_LINE_LOOP:
+        const int* sp = &oindex[ostart[i]];
+        const int* ep = &oindex[0] + ( i + 1 < nl ? ostart[i + 1] : oindex.size() );
+        const int* cp = sp;
+        int a, b;
+
+        // solids are CCW and holes are CW so the material always lies
+        // to the left of an edge; the wall faces the right-hand side
+        while( cp != ep )
         {
-            // add the loop to the list of outlines
-            std::list<int>* loop = new std::list<int>;
-
-            if( !loop )
-                break;
-
-            for( size_t i = 0; i < vlist.size(); ++i )
-                loop->push_back( vlist[i]->o );
+            a = *cp++;
+            b = ( cp == ep ) ? *sp : *cp;
 
-            outline.push_back( loop );
-        }
-        break;
-
-        case GL_TRIANGLE_FAN:
-            processFan();
-            break;
+            if( nw > 0 )
+            {
+                aOutFile << ",";
 
-        case GL_TRIANGLE_STRIP:
-            processStrip();
-            break;
+                if( !( nw % 4 ) )
+                    aOutFile << "\n" << fmt << "   ";
+            }
 
-        case GL_TRIANGLES:
-            processTri();
-            break;
+            if( aUpFlag )
+                aOutFile << " " << a << "," << b << "," << b + nv << "," << a + nv << ",-1";
+            else
+                aOutFile << " " << a << "," << a + nv << "," << b + nv << "," << b << ",-1";
 
-        default:
-            break;
+            ++nw;
+        }
     }
 
-    while( !vlist.empty() )
-        vlist.pop_back();
-
-    glcmd = 0;
-}
-
-
-// set the error message
-void TESSELATOR::SetGLError( GLenum errorID )
-{
-    error = "";
-    error = (const char*)gluGetString( errorID );
-
-    if( error.empty() )
-    {
-        std::ostringstream ostr;
-        ostr << "Unknown OpenGL error: " << errorID;
-        error = ostr.str();
-    }
+    return !aOutFile.fail();
 }
 
 
-// process a GL_TRIANGLE_FAN list
-void TESSELATOR::processFan( void )
+// add a triangular facet (triplet) to the ouptut index list
+bool TESSELATOR::addTriplet( const VERTEX_3D& p0, const VERTEX_3D& p1, const VERTEX_3D& p2 )
 {
-    if( vlist.size() < 3 )
-        return;
-
-    VERTEX_3D* p0 = vlist[0];
-
-    int i;
-    int end = vlist.size();
-
-    for( i = 2; i < end; ++i )
-    {
-        addTriplet( p0, vlist[i - 1], vlist[i] );
-    }
-}
+    double  dx0 = p1.x - p0.x;
+    double  dx1 = p2.x - p0.x;
 
+    double  dy0 = p1.y - p0.y;
+    double  dy1 = p2.y - p0.y;
 
-// process a GL_TRIANGLE_STRIP list
-void TESSELATOR::processStrip( void )
-{
-    // note: (source: http://www.opengl.org/wiki/Primitive)
-    // GL_TRIANGLE_STRIP​: Every group of 3 adjacent vertices forms a triangle.
-    // The face direction of the strip is determined by the winding of the
-    // first triangle. Each successive triangle will have its effective face
-    // order reverse, so the system compensates for that by testing it in the
-    // opposite way. A vertex stream of n length will generate n-2 triangles.
+    // this number is chosen because we shall only write 9 decimal places
+    // at most on the VRML output
+    double err = 0.000000001;
 
-    if( vlist.size() < 3 )
-        return;
+    // test if the triangles are degenerate (parallel sides)
 
-    int i;
-    int end = vlist.size();
-    bool flip = false;
+    if( dx0 < err && dx0 > -err && dx1 < err && dx1 > -err )
+        return false;
 
-    for( i = 2; i < end; ++i )
-    {
-        if( flip )
-        {
-            addTriplet( vlist[i - 1], vlist[i - 2], vlist[i] );
-            flip = false;
-        }
-        else
-        {
-            addTriplet( vlist[i - 2], vlist[i - 1], vlist[i] );
-            flip = true;
-        }
-    }
-}
+    if( dy0 < err && dy0 > -err && dy1 < err && dy1 > -err )
+        return false;
 
+    double  sl0 = dy0 / dx0;
+    double  sl1 = dy1 / dx1;
 
-// process a GL_TRIANGLES list
-void TESSELATOR::processTri( void )
-{
-    // notes:
-    // 1. each successive group of 3 vertices is a triangle
-    // 2. as per OpenGL specification, any incomplete triangles are to be ignored
+    double dsl = sl1 - sl0;
 
-    if( vlist.size() < 3 )
-        return;
+    if( dsl < err && dsl > -err )
+        return false;
 
-    int i;
-    int end = vlist.size();
+    triplets.push_back( p0.o );
+    triplets.push_back( p1.o );
+    triplets.push_back( p2.o );
 
-    for( i = 2; i < end; i += 3 )
-        addTriplet( vlist[i - 2], vlist[i - 1], vlist[i] );
+    return true;
 }
 
 
@@ -928,12 +1831,12 @@ int TESSELATOR::checkNContours( bool holes )
 {
     int nc = 0;     // number of contours
 
-    if( contours.empty() )
+    if( csize.empty() )
         return 0;
 
-    for( size_t i = 0; i < contours.size(); ++i )
+    for( size_t i = 0; i < csize.size(); ++i )
     {
-        if( contours[i]->size() < 3 )
+        if( csize[i] < 3 )
             continue;
 
         if( ( holes && areas[i] <= 0.0 ) || ( !holes && areas[i] > 0.0 ) )
@@ -946,64 +1849,15 @@ int TESSELATOR::checkNContours( bool holes )
 }
 
 
-// push the internally held vertices
-void TESSELATOR::pushVertices( bool holes )
-{
-    // push the internally held vertices
-    unsigned int i;
-
-    GLdouble pt[3];
-    VERTEX_3D* vp;
-
-    std::list<int>::const_iterator  begin;
-    std::list<int>::const_iterator  end;
-
-    for( i = 0; i < contours.size(); ++i )
-    {
-        if( contours[i]->size() < 3 )
-            continue;
-
-        if( ( holes && areas[i] <= 0.0 ) || ( !holes && areas[i] > 0.0 ) )
-            continue;
-
-        gluTessBeginContour( tess );
-
-        begin = contours[i]->begin();
-        end = contours[i]->end();
-
-        while( begin != end )
-        {
-            vp = vertices[ *begin ];
-            pt[0]   = vp->x;
-            pt[1]   = vp->y;
-            pt[2]   = 0.0;
-            gluTessVertex( tess, pt, vp );
-            ++begin;
-        }
-
-        gluTessEndContour( tess );
-    }
-
-    return;
-}
-
-
 VERTEX_3D* TESSELATOR::getVertexByIndex( int aPointIndex )
 {
-    if( aPointIndex < 0 || (unsigned int) aPointIndex >= ( idx + extra_verts.size() ) )
+    if( aPointIndex < 0 || aPointIndex >= idx )
     {
         error = "getVertexByIndex():BUG: invalid index";
         return NULL;
     }
 
-    if( aPointIndex < idx )
-    {
-        // vertex is in the vertices[] list
-        return vertices[ aPointIndex ];
-    }
-
-    // vertex is in the extra_verts[] list
-    return extra_verts[aPointIndex - idx];
+    return &vertices[ aPointIndex ];
 }
 
 
@@ -1017,7 +1871,13 @@ int TESSELATOR::GetSize( void )
 // return the vertex identified by index
 VERTEX_3D* TESSELATOR::GetVertexByIndex( int aPointIndex )
 {
-    int i0 = vertices[0]->i;
+    if( vertices.empty() )
+    {
+        error = "GetVertexByIndex(): invalid index";
+        return NULL;
+    }
+
+    int i0 = vertices[0].i;
 
     if( aPointIndex < i0 || aPointIndex >= ( i0 + (int) vertices.size() ) )
     {
@@ -1025,7 +1885,7 @@ VERTEX_3D* TESSELATOR::GetVertexByIndex( int aPointIndex )
         return NULL;
     }
 
-    return vertices[aPointIndex - i0];
+    return &vertices[aPointIndex - i0];
 }
 
 
@@ -1064,4 +1924,48 @@ bool TESSELATOR::WriteVRML( bool isCCW, TRANSFORM& aTransform, VRMLMAT& aMateria
     return aVRMLFile.good();
 }
 
+
+bool TESSELATOR::WriteSlab( double aThickness, TRANSFORM& aTransform, VRMLMAT& aMaterial,
+                            bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth )
+{
+    if( aThickness < 1e-9 && aThickness > -1e-9 )
+    {
+        error = "WriteSlab(): invalid thickness";
+        return false;
+    }
+
+    if( !fix && !Tesselate() )
+        return false;
+
+    // true if the second face lies above the first
+    bool up = aThickness > 0.0;
+
+    // set up VRML Shape
+    SetupShape( aMaterial, reuseMaterial, aVRMLFile, aTabDepth );
+
+    string fmt( (aTabDepth + 1) * 4, ' ' );
+
+    // enumerate vertices; the face at z = 0 followed by the face at z = aThickness
+    aVRMLFile << fmt << "coord Coordinate { point [\n";
+    WriteVertices( aVRMLFile, 5, aTransform, aTabDepth + 1 );
+    aVRMLFile << ",\n";
+    WriteVertices( aVRMLFile, 5, aTransform, aTabDepth + 1, aThickness );
+    aVRMLFile << "]\n";
+    aVRMLFile << fmt << "}\n";
+
+    // both faces share a single triangulation
+    SetupCoordIndex( aVRMLFile, aTabDepth + 1 );
+    WriteIndices( !up, aVRMLFile, aTabDepth );
+    aVRMLFile << ",\n";
+    WriteIndices( up, aVRMLFile, aTabDepth, ordmap.size() );
+    aVRMLFile << ",\n";
+    writeWalls( up, aVRMLFile, aTabDepth );
+    aVRMLFile << "\n";
+    CloseCoordIndex( aVRMLFile, aTabDepth + 1 );
+
+    CloseShape( aVRMLFile, aTabDepth );
+
+    return aVRMLFile.good();
+}
+
 }   // namespace KC3D
@@ -0,0 +1,215 @@
+/*
+ *      file: outpath.cpp
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <cerrno>
+#include <iostream>
+#include <fstream>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+#include <vdefs.h>
+#include <vcom.h>
+#include <outpath.h>
+
+
+using namespace std;
+using namespace KC3D;
+
+
+OUTPATH::OUTPATH()
+{
+    return;
+}
+
+
+OUTPATH::OUTPATH( const std::string& aPattern )
+{
+    SetPattern( aPattern );
+    return;
+}
+
+
+int OUTPATH::SetPattern( const std::string& aPattern )
+{
+    // every '{' must be closed before the next field starts
+    size_t pos = 0;
+
+    while( ( pos = aPattern.find( '{', pos ) ) != string::npos )
+    {
+        size_t close = aPattern.find_first_of( "{}", pos + 1 );
+
+        if( close == string::npos || aPattern[close] != '}' )
+        {
+            ERRBLURB;
+            cerr << "unterminated field in pattern '" << aPattern << "'\n";
+            return -1;
+        }
+
+        pos = close + 1;
+    }
+
+    pattern = aPattern;
+    return 0;
+}
+
+
+const std::string& OUTPATH::GetPattern( void ) const
+{
+    return pattern;
+}
+
+
+void OUTPATH::SetField( const std::string& aKey, const std::string& aValue )
+{
+    fields[aKey] = aValue;
+    return;
+}
+
+
+void OUTPATH::ClearFields( void )
+{
+    fields.clear();
+    return;
+}
+
+
+int OUTPATH::Expand( const std::string& aName, std::string& aPath ) const
+{
+    aPath.clear();
+
+    if( aName.empty() )
+    {
+        ERRBLURB;
+        cerr << "empty model name\n";
+        return -1;
+    }
+
+    if( pattern.empty() )
+    {
+        aPath = aName;
+        aPath.append( ".wrl" );
+        return 0;
+    }
+
+    size_t pos = 0;
+
+    while( pos < pattern.size() )
+    {
+        size_t open = pattern.find( '{', pos );
+
+        if( open == string::npos )
+        {
+            aPath.append( pattern, pos, string::npos );
+            break;
+        }
+
+        size_t close = pattern.find( '}', open );
+        aPath.append( pattern, pos, open - pos );
+        string key = pattern.substr( open + 1, close - open - 1 );
+        map<string, string>::const_iterator fp = fields.find( key );
+
+        if( fp != fields.end() )
+            aPath.append( fp->second );
+        else if( key == "name" )
+            aPath.append( aName );
+        else if( key == "series" )
+            aPath.append( aName.substr( 0, aName.find( '_' ) ) );
+        else
+        {
+            ERRBLURB;
+            cerr << "unknown field '{" << key << "}' in pattern\n";
+            aPath.clear();
+            return -1;
+        }
+
+        pos = close + 1;
+    }
+
+    return 0;
+}
+
+
+std::string OUTPATH::MakePath( const std::string& aName )
+{
+    string path;
+
+    if( Expand( aName, path ) || MakeDirs( path ) )
+        path.clear();
+
+    return path;
+}
+
+
+int OUTPATH::MakeDirs( const std::string& aPath )
+{
+    size_t sep = aPath.find_last_of( "/\\" );
+
+    if( sep == string::npos || sep == 0 )
+        return 0;
+
+    string dir = aPath.substr( 0, sep );
+
+    if( dirs.count( dir ) )
+        return 0;
+
+    sep = 0;
+
+    while( sep != string::npos )
+    {
+        sep = dir.find_first_of( "/\\", sep + 1 );
+        string part = dir.substr( 0, sep );
+
+#ifdef _WIN32
+        int rv = _mkdir( part.c_str() );
+#else
+        int rv = mkdir( part.c_str(), 0755 );
+#endif
+
+        if( rv && errno != EEXIST )
+        {
+            ERRBLURB;
+            cerr << "could not create directory '" << part << "'\n";
+            return -1;
+        }
+    }
+
+    dirs.insert( dir );
+    return 0;
+}
+
+
+int OUTPATH::Open( const std::string& aName, std::ofstream& aOutputStream )
+{
+    string path;
+
+    if( Expand( aName, path ) || MakeDirs( path ) )
+        return -1;
+
+    // the header records the file name without the directories
+    size_t sep = path.find_last_of( "/\\" );
+
+    if( sep == string::npos )
+        return SetupVRML( path, aOutputStream );
+
+    return SetupVRML( path.substr( sep + 1 ), path, aOutputStream );
+}
@@ -504,7 +504,7 @@ int PIN::Calc( const PPARAMS& aPinParam, TRANSFORM& aTransform )
 // Write out the pin shape information
 int PIN::Build( bool aRenderCap0, bool aRenderCap1, TRANSFORM& aFinalTransform,
                 VRMLMAT& aMaterial, bool reuseMaterial,
-                std::ofstream& aVRMLFile, int aTabDepth )
+                std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !valid )
     {
@@ -559,6 +559,36 @@ int PIN::Build( bool aRenderCap0, bool aRenderCap1, TRANSFORM& aFinalTransform,
 }
 
 
+int PIN::Translate( const PIN& aPin, double dX, double dY, double dZ )
+{
+    if( !aPin.valid )
+    {
+        ERRBLURB;
+        cerr << "invoked with a pin which has not been calculated\n";
+        return -1;
+    }
+
+    // the polygons are only cloned on the first use
+    if( !valid || nr != aPin.nr )
+    {
+        *this = aPin;
+
+        if( !valid )
+            return -1;
+    }
+
+    int acc = 0;
+
+    for( int i = 0; i < nr; ++i )
+        acc += poly[i]->Translate( *aPin.poly[i], dX, dY, dZ );
+
+    if( acc )
+        return -1;
+
+    return 0;
+}
+
+
 void PIN::SetShape( bool isSquare )
 {
     if( valid )
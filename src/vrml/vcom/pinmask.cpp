@@ -0,0 +1,262 @@
+/*
+ *      file: pinmask.cpp
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+#include <vdefs.h>
+#include <pinmask.h>
+
+#define WBITS ( (int) ( sizeof( unsigned long ) * CHAR_BIT ) )
+
+using namespace std;
+using namespace KC3D;
+
+
+PINMASK::PINMASK()
+{
+    npins = 0;
+    return;
+}
+
+
+PINMASK::PINMASK( int aNPins )
+{
+    npins = 0;
+    SetSize( aNPins );
+    return;
+}
+
+
+int PINMASK::SetSize( int aNPins )
+{
+    if( aNPins < 0 )
+    {
+        ERRBLURB;
+        cerr << "invalid number of pins (" << aNPins << ")\n";
+        return -1;
+    }
+
+    npins = aNPins;
+    bits.resize( ( npins + WBITS - 1 ) / WBITS );
+    SetAll( true );
+    return 0;
+}
+
+
+int PINMASK::GetSize( void ) const
+{
+    return npins;
+}
+
+
+void PINMASK::SetAll( bool isSet )
+{
+    size_t nw = bits.size();
+
+    for( size_t i = 0; i < nw; ++i )
+        bits[i] = isSet ? ~0UL : 0UL;
+
+    // bits beyond the last pin are always clear
+    if( isSet && ( npins % WBITS ) )
+        bits[nw - 1] = ( 1UL << ( npins % WBITS ) ) - 1;
+
+    return;
+}
+
+
+int PINMASK::Set( int aPin, bool isSet )
+{
+    if( aPin < 1 || aPin > npins )
+    {
+        ERRBLURB;
+        cerr << "pin (" << aPin << ") out of range; must be 1 .. " << npins << "\n";
+        return -1;
+    }
+
+    --aPin;
+
+    if( isSet )
+        bits[aPin / WBITS] |= 1UL << ( aPin % WBITS );
+    else
+        bits[aPin / WBITS] &= ~( 1UL << ( aPin % WBITS ) );
+
+    return 0;
+}
+
+
+bool PINMASK::Get( int aPin ) const
+{
+    if( aPin < 1 || aPin > npins )
+        return false;
+
+    --aPin;
+    return ( bits[aPin / WBITS] >> ( aPin % WBITS ) ) & 1UL;
+}
+
+
+int PINMASK::SetRange( int aFirst, int aLast, bool isSet )
+{
+    if( aFirst < 1 || aLast > npins || aLast < aFirst )
+    {
+        ERRBLURB;
+        cerr << "invalid range (" << aFirst << " .. " << aLast;
+        cerr << "); pins are 1 .. " << npins << "\n";
+        return -1;
+    }
+
+    for( int i = aFirst; i <= aLast; ++i )
+        Set( i, isSet );
+
+    return 0;
+}
+
+
+int PINMASK::SetEvery( int aFirst, int aStep, bool isSet )
+{
+    if( aFirst < 1 || aStep < 1 )
+    {
+        ERRBLURB;
+        cerr << "invalid first pin (" << aFirst << ") or step (" << aStep << ")\n";
+        return -1;
+    }
+
+    for( int i = aFirst; i <= npins; i += aStep )
+        Set( i, isSet );
+
+    return 0;
+}
+
+
+int PINMASK::SetList( const std::string& aList, bool isSet )
+{
+    // check the whole list before any pin is changed
+    const char* cp = aList.c_str();
+    std::vector<int> ranges;
+
+    while( *cp )
+    {
+        while( *cp == ' ' || *cp == ',' )
+            ++cp;
+
+        if( !*cp )
+            break;
+
+        char* ep;
+        long p0 = strtol( cp, &ep, 10 );
+        long p1 = p0;
+
+        if( ep != cp && *ep == '-' )
+        {
+            cp = ep + 1;
+            p1 = strtol( cp, &ep, 10 );
+        }
+
+        if( ep == cp || p0 < 1 || p1 < p0 || ( *ep && *ep != ',' && *ep != ' ' ) )
+        {
+            ERRBLURB;
+            cerr << "invalid pin list '" << aList << "'\n";
+            return -1;
+        }
+
+        ranges.push_back( (int) p0 );
+        ranges.push_back( (int) p1 );
+        cp = ep;
+    }
+
+    for( size_t i = 0; i < ranges.size(); i += 2 )
+    {
+        for( int j = ranges[i]; j <= ranges[i + 1] && j <= npins; ++j )
+            Set( j, isSet );
+    }
+
+    return 0;
+}
+
+
+int PINMASK::SetPattern( const std::string& aPattern )
+{
+    if( aPattern.empty() || aPattern.find_first_not_of( "01" ) != string::npos )
+    {
+        ERRBLURB;
+        cerr << "invalid pin pattern '" << aPattern << "'; must be a sequence of 0 and 1\n";
+        return -1;
+    }
+
+    size_t np = aPattern.size();
+
+    for( int i = 0; i < npins; ++i )
+        Set( i + 1, aPattern[i % np] == '1' );
+
+    return 0;
+}
+
+
+int PINMASK::Count( void ) const
+{
+    int n = 0;
+
+    for( size_t i = 0; i < bits.size(); ++i )
+    {
+        unsigned long w = bits[i];
+
+        while( w )
+        {
+            w &= w - 1;
+            ++n;
+        }
+    }
+
+    return n;
+}
+
+
+int PINMASK::Next( int aPin ) const
+{
+    if( aPin < 0 )
+        aPin = 0;
+
+    if( aPin >= npins )
+        return 0;
+
+    // bit aPin holds pin aPin + 1
+    int wi = aPin / WBITS;
+    unsigned long w = bits[wi] & ( ~0UL << ( aPin % WBITS ) );
+    int nw = (int) bits.size();
+
+    while( !w )
+    {
+        if( ++wi >= nw )
+            return 0;
+
+        w = bits[wi];
+    }
+
+    int b = 0;
+
+    while( !( w & 1UL ) )
+    {
+        w >>= 1;
+        ++b;
+    }
+
+    return wi * WBITS + b + 1;
+}
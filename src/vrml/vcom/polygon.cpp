@@ -74,7 +74,7 @@ void POLYGON::init( void )
 
 
 int POLYGON::Paint( bool isCCW, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool reuseMaterial,
-                   std::ofstream& aVRMLFile, int aTabDepth )
+                   std::ostream& aVRMLFile, int aTabDepth )
 {
     int i;
 
@@ -186,7 +186,7 @@ int POLYGON::Paint( bool isCCW, TRANSFORM& aTransform, VRMLMAT& aMaterial, bool
 
 
 int POLYGON::Stitch( bool isCCW, POLYGON& aPolygon, TRANSFORM& aTransform, VRMLMAT& aMaterial,
-                     bool reuseMaterial, std::ofstream& aVRMLFile, int aTabDepth )
+                     bool reuseMaterial, std::ostream& aVRMLFile, int aTabDepth )
 {
     int i, j, k;
 
@@ -336,6 +336,26 @@ int POLYGON::Xform( TRANSFORM& aTransform )
 }
 
 
+int POLYGON::Translate( const POLYGON& aPolygon, double dX, double dY, double dZ )
+{
+    if( !aPolygon.valid || !valid || aPolygon.nv != nv )
+    {
+        ERRBLURB;
+        cerr << "invoked without a valid polygon with a matching number of vertices\n";
+        return -1;
+    }
+
+    for( int i = 0; i < nv; ++i )
+    {
+        x[i] = aPolygon.x[i] + dX;
+        y[i] = aPolygon.y[i] + dY;
+        z[i] = aPolygon.z[i] + dZ;
+    }
+
+    return 0;
+}
+
+
 // Return value: number of points. Handles will point to arrays of doubles
 int POLYGON::GetVertices( double** px, double** py, double** pz ) const
 {
@@ -374,7 +394,7 @@ int POLYGON::Extrude( bool aRenderCap0,
                       TRANSFORM& aFinalTransform,
                       VRMLMAT& aMaterial,
                       bool reuseMaterial,
-                      std::ofstream& aVRMLFile,
+                      std::ostream& aVRMLFile,
                       int aTabDepth )
 {
     SIMPLEPOLY pp( *this );
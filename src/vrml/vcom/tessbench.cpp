@@ -0,0 +1,301 @@
+/*
+ *      file: tessbench.cpp
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+/**
+ *  \brief Benchmark for the TESSELATOR
+ *
+ *  Usage: tessbench [-r REPS] [-o FILE]
+ *
+ *  -r REPS     =   number of iterations of each case (default 1000)
+ *  -o FILE     =   write the VRML output to FILE (default /dev/null)
+ *
+ *  Each iteration sets up an outline, tesselates it and writes the
+ *  VRML face. The time and the number of heap allocations per iteration
+ *  are reported for each case:
+ *
+ *  + a 2x50 header top: a rectangle with 100 round holes of 16 sides
+ *  + a board outline of 400 vertices with 20 round holes of 24 sides
+ *  + a 2x10 header top: a rectangle with 20 round holes of 16 sides
+ *  + a concave comb of 82 vertices with no holes
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <new>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <sys/time.h>
+#include <vdefs.h>
+#include <kc3dtess.h>
+#include <circle.h>
+#include <transform.h>
+#include <vrmlmat.h>
+
+using namespace std;
+using namespace KC3D;
+
+// count every heap allocation made by the program
+static unsigned long nAllocs = 0;
+
+void* operator new( size_t aSize )
+{
+    ++nAllocs;
+    void* p = malloc( aSize ? aSize : 1 );
+
+    if( !p )
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void* operator new( size_t aSize, const std::nothrow_t& ) throw()
+{
+    ++nAllocs;
+    return malloc( aSize ? aSize : 1 );
+}
+
+void* operator new[]( size_t aSize )
+{
+    return operator new( aSize );
+}
+
+void* operator new[]( size_t aSize, const std::nothrow_t& aTag ) throw()
+{
+    return operator new( aSize, aTag );
+}
+
+void operator delete( void* aPtr ) throw()
+{
+    free( aPtr );
+}
+
+void operator delete( void* aPtr, const std::nothrow_t& ) throw()
+{
+    free( aPtr );
+}
+
+void operator delete[]( void* aPtr ) throw()
+{
+    free( aPtr );
+}
+
+void operator delete[]( void* aPtr, const std::nothrow_t& ) throw()
+{
+    free( aPtr );
+}
+
+
+static double getTime( void )
+{
+    struct timeval tv;
+
+    gettimeofday( &tv, NULL );
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+
+static void printUsage( void )
+{
+    cout << "Usage: tessbench [-r REPS] [-o FILE]\n";
+    cout << "    -r REPS : iterations of each case (default 1000)\n";
+    cout << "    -o FILE : file for the VRML output (default /dev/null)\n";
+}
+
+
+// a rectangular header top of nx by ny pins with round holes
+static void makeHeader( TESSELATOR& aTess, int nx, int ny )
+{
+    int k = aTess.NewContour();
+
+    aTess.AddVertex( k, 0, 0 );
+    aTess.AddVertex( k, nx * 2.54, 0 );
+    aTess.AddVertex( k, nx * 2.54, ny * 2.54 );
+    aTess.AddVertex( k, 0, ny * 2.54 );
+
+    for( int i = 0; i < nx; ++i )
+    {
+        for( int j = 0; j < ny; ++j )
+        {
+            CIRCLE hole( 16 );
+            TRANSFORM t;
+
+            t.SetTranslation( 1.27 + 2.54 * i, 1.27 + 2.54 * j, 0 );
+            hole.Calc( 1.0, 1.0, t );
+            aTess.AddPolygon( hole, true );
+        }
+    }
+}
+
+
+// a wavy board outline of 400 vertices with 20 round holes
+static void makeBoard( TESSELATOR& aTess )
+{
+    int k = aTess.NewContour();
+    int n = 400;
+
+    for( int i = 0; i < n; ++i )
+    {
+        double a = 2.0 * M_PI * i / n;
+        double r = 40.0 + 3.0 * sin( 7.0 * a );
+
+        aTess.AddVertex( k, r * cos( a ), r * sin( a ) );
+    }
+
+    for( int i = 0; i < 20; ++i )
+    {
+        CIRCLE hole( 24 );
+        TRANSFORM t;
+        double a = 2.0 * M_PI * i / 20.0;
+
+        t.SetTranslation( 25.0 * cos( a ), 25.0 * sin( a ), 0 );
+        hole.Calc( 3.0, 3.0, t );
+        aTess.AddPolygon( hole, true );
+    }
+}
+
+
+// a concave comb with 20 teeth
+static void makeComb( TESSELATOR& aTess )
+{
+    int k = aTess.NewContour();
+    int n = 20;
+
+    aTess.AddVertex( k, 0, 0 );
+
+    for( int i = 0; i < n; ++i )
+    {
+        aTess.AddVertex( k, i * 2.0, 5 );
+        aTess.AddVertex( k, i * 2.0 + 1.0, 5 );
+        aTess.AddVertex( k, i * 2.0 + 1.0, 1 );
+        aTess.AddVertex( k, i * 2.0 + 2.0, 1 );
+    }
+
+    aTess.AddVertex( k, n * 2.0, 0 );
+    aTess.EnsureWinding( k, false );
+}
+
+
+// run case aCase aReps times; returns 0 for success, -1 for failure
+static int runCase( int aCase, int aReps, const string& aOutFile )
+{
+    static const char* names[] =
+    {
+        "2x50 header, 100 holes",
+        "400-vertex outline, 20 holes",
+        "2x10 header, 20 holes",
+        "concave comb (1 contour)"
+    };
+
+    VRMLMAT mat;
+    mat.SetName( "TESSBENCH" );
+
+    unsigned long a0 = nAllocs;
+    double t0 = getTime();
+
+    for( int n = 0; n < aReps; ++n )
+    {
+        TESSELATOR tess;
+        TRANSFORM tx;
+
+        switch( aCase )
+        {
+        case 0:
+            makeHeader( tess, 50, 2 );
+            break;
+
+        case 1:
+            makeBoard( tess );
+            break;
+
+        case 2:
+            makeHeader( tess, 10, 2 );
+            break;
+
+        default:
+            makeComb( tess );
+            break;
+        }
+
+        ofstream fp( aOutFile.c_str() );
+
+        if( !tess.WriteVRML( true, tx, mat, false, fp, 0 ) )
+        {
+            ERRBLURB;
+            cerr << "case '" << names[aCase] << "' failed: " << tess.GetError() << "\n";
+            return -1;
+        }
+    }
+
+    double t1 = getTime();
+
+    printf( "  %-30s %8lu %10.3f\n", names[aCase], ( nAllocs - a0 ) / aReps,
+            ( t1 - t0 ) * 1000.0 / aReps );
+
+    return 0;
+}
+
+
+int main( int argc, const char** argv )
+{
+    string ofile( "/dev/null" );
+    int reps = 1000;
+    int i = 1;
+
+    while( i < argc )
+    {
+        const char* val = ( i + 1 < argc ) ? argv[i + 1] : NULL;
+
+        if( !strcmp( argv[i], "-r" ) && val )
+        {
+            reps = atoi( val );
+
+            if( reps < 1 )
+            {
+                ERRBLURB;
+                cerr << "invalid number of iterations; must be >= 1\n";
+                return -1;
+            }
+        }
+        else if( !strcmp( argv[i], "-o" ) && val )
+        {
+            ofile = val;
+        }
+        else
+        {
+            printUsage();
+            return -1;
+        }
+
+        i += 2;
+    }
+
+    printf( "  %-30s %8s %10s\n", "case", "allocs", "ms" );
+
+    for( i = 0; i < 4; ++i )
+    {
+        if( runCase( i, reps, ofile ) )
+            return -1;
+    }
+
+    return 0;
+}    // int main()
@@ -0,0 +1,325 @@
+/*
+ *      file: tessmt.cpp
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ */
+
+/**
+ *  \brief Stress test for concurrent use of the TESSELATOR
+ *
+ *  Usage: tessmt [-j N] [-n COUNT] [-d DIR]
+ *
+ *  -j N        =   number of threads (default 8)
+ *  -n COUNT    =   number of outlines tesselated by each thread (default 500)
+ *  -d DIR      =   directory for the temporary output files (default .)
+ *
+ *  Each of 64 header outlines (a rectangle with a grid of round holes)
+ *  is first tesselated by a single thread to obtain a reference result.
+ *  The threads then tesselate the outlines in an interleaved order and
+ *  every result is compared with the reference. The concurrent run is
+ *  made without and then with the process-wide result cache. The exit
+ *  code is 0 when all results match the serial ones.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <pthread.h>
+#include <vdefs.h>
+#include <kc3dtess.h>
+#include <circle.h>
+#include <transform.h>
+#include <vrmlmat.h>
+
+using namespace std;
+using namespace KC3D;
+
+#define NVARIANTS ( 64 )    // number of distinct outlines
+
+struct TESSJOB
+{
+    string  dir;            // directory for the temporary files
+    int     count;          // outlines per thread
+    int     nbad;           // number of results which differ from the serial run
+    int     nfail;          // number of outlines which could not be written
+    string  ref[NVARIANTS]; // serial results
+    pthread_mutex_t lock;
+};
+
+struct TESSARG
+{
+    TESSJOB* job;
+    int id;
+};
+
+
+static void printUsage( void )
+{
+    cout << "Usage: tessmt [-j N] [-n COUNT] [-d DIR]\n";
+    cout << "    -j N     : number of threads (default 8)\n";
+    cout << "    -n COUNT : outlines tesselated by each thread (default 500)\n";
+    cout << "    -d DIR   : directory for temporary files (default .)\n";
+}
+
+
+// add the outline of variant aVariant: a rectangle with up to
+// 14 x 3 round holes of between 8 and 12 sides
+static void makeOutline( TESSELATOR& aTess, int aVariant )
+{
+    int nx = 2 + aVariant % 13;
+    int ny = 1 + aVariant % 3;
+    int k = aTess.NewContour();
+
+    aTess.AddVertex( k, 0, 0 );
+    aTess.AddVertex( k, nx * 2.54, 0 );
+    aTess.AddVertex( k, nx * 2.54, ny * 2.54 );
+    aTess.AddVertex( k, 0, ny * 2.54 );
+
+    for( int i = 0; i < nx; ++i )
+    {
+        for( int j = 0; j < ny; ++j )
+        {
+            CIRCLE hole( 8 + aVariant % 5 );
+            TRANSFORM t;
+
+            t.SetTranslation( 1.27 + 2.54 * i, 1.27 + 2.54 * j, 0 );
+            hole.Calc( 1.0, 1.0, t );
+            aTess.AddPolygon( hole, true );
+        }
+    }
+}
+
+
+// tesselate variant aVariant and return the VRML text; odd variants
+// are written as slabs and even variants as a single face
+static bool tesselate( const string& aFileName, int aVariant, string& aResult )
+{
+    ofstream fp( aFileName.c_str() );
+
+    if( !fp.is_open() )
+        return false;
+
+    TESSELATOR tess;
+    TRANSFORM tx;
+    VRMLMAT mat;
+    bool ok;
+
+    mat.SetName( "TESSMT" );
+    makeOutline( tess, aVariant );
+    tx.SetTranslation( aVariant, 0, 0 );
+
+    if( aVariant & 1 )
+        ok = tess.WriteSlab( 1.0, tx, mat, false, fp, 0 );
+    else
+        ok = tess.WriteVRML( true, tx, mat, false, fp, 0 );
+
+    fp.close();
+
+    if( !ok )
+        return false;
+
+    ifstream ifile( aFileName.c_str() );
+    ostringstream text;
+
+    text << ifile.rdbuf();
+    aResult = text.str();
+    return true;
+}
+
+
+static void* tessWorker( void* aArg )
+{
+    TESSARG* arg = (TESSARG*) aArg;
+    TESSJOB* job = arg->job;
+    ostringstream fname;
+    string result;
+    int nbad = 0;
+    int nfail = 0;
+
+    fname << job->dir << "/tessmt_" << arg->id << ".wrl";
+
+    for( int n = 0; n < job->count; ++n )
+    {
+        int v = ( n * 7 + arg->id ) % NVARIANTS;
+
+        if( !tesselate( fname.str(), v, result ) )
+            ++nfail;
+        else if( result != job->ref[v] )
+            ++nbad;
+    }
+
+    remove( fname.str().c_str() );
+
+    pthread_mutex_lock( &job->lock );
+    job->nbad += nbad;
+    job->nfail += nfail;
+    pthread_mutex_unlock( &job->lock );
+
+    return NULL;
+}
+
+
+// run the job on aNThreads threads; returns the number of failures
+static int runThreads( TESSJOB& aJob, int aNThreads )
+{
+    pthread_t* th = new (nothrow) pthread_t[aNThreads];
+    TESSARG* args = new (nothrow) TESSARG[aNThreads];
+    int nt = 0;
+
+    if( !th || !args )
+    {
+        ERRBLURB;
+        cerr << "could not allocate memory for threads\n";
+        delete [] th;
+        delete [] args;
+        return -1;
+    }
+
+    aJob.nbad = 0;
+    aJob.nfail = 0;
+
+    for( int i = 0; i < aNThreads; ++i )
+    {
+        args[i].job = &aJob;
+        args[i].id = i;
+
+        if( pthread_create( &th[i], NULL, tessWorker, &args[i] ) )
+        {
+            ERRBLURB;
+            cerr << "could not create thread #" << i << "\n";
+            break;
+        }
+
+        ++nt;
+    }
+
+    for( int i = 0; i < nt; ++i )
+        pthread_join( th[i], NULL );
+
+    delete [] th;
+    delete [] args;
+
+    if( nt != aNThreads )
+        return -1;
+
+    return aJob.nbad + aJob.nfail;
+}
+
+
+int main( int argc, const char** argv )
+{
+    TESSJOB job;
+    int nThreads = 8;
+    int i = 1;
+
+    job.dir = ".";
+    job.count = 500;
+
+    while( i < argc )
+    {
+        const char* val = ( i + 1 < argc ) ? argv[i + 1] : NULL;
+
+        if( !strcmp( argv[i], "-j" ) && val )
+        {
+            nThreads = atoi( val );
+
+            if( nThreads < 1 || nThreads > 256 )
+            {
+                ERRBLURB;
+                cerr << "invalid number of threads; valid range is 1 .. 256\n";
+                return -1;
+            }
+        }
+        else if( !strcmp( argv[i], "-n" ) && val )
+        {
+            job.count = atoi( val );
+
+            if( job.count < 1 )
+            {
+                ERRBLURB;
+                cerr << "invalid count; must be >= 1\n";
+                return -1;
+            }
+        }
+        else if( !strcmp( argv[i], "-d" ) && val )
+        {
+            job.dir = val;
+        }
+        else
+        {
+            printUsage();
+            return -1;
+        }
+
+        i += 2;
+    }
+
+    // serial reference results
+    string fname( job.dir + "/tessmt_ref.wrl" );
+
+    for( i = 0; i < NVARIANTS; ++i )
+    {
+        if( !tesselate( fname, i, job.ref[i] ) )
+        {
+            ERRBLURB;
+            cerr << "could not write reference outline #" << i << " to '" << fname << "'\n";
+            remove( fname.c_str() );
+            return -1;
+        }
+    }
+
+    remove( fname.c_str() );
+    pthread_mutex_init( &job.lock, NULL );
+
+    int total = nThreads * job.count;
+    int ret = 0;
+
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        TESSELATOR::EnableCache( pass == 1 );
+
+        int nbad = runThreads( job, nThreads );
+
+        cout << nThreads << " threads, cache " << ( pass ? "on" : "off" ) << ": ";
+
+        if( nbad < 0 )
+        {
+            cout << "failed\n";
+            ret = -1;
+            continue;
+        }
+
+        cout << nbad << " of " << total << " outlines differ from the serial run";
+
+        if( job.nfail )
+            cout << " (" << job.nfail << " not written)";
+
+        cout << "\n";
+
+        if( nbad )
+            ret = -1;
+    }
+
+    TESSELATOR::EnableCache( false );
+    pthread_mutex_destroy( &job.lock );
+
+    return ret;
+}    // int main()
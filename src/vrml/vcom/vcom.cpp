@@ -21,6 +21,8 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <map>
+#include <pthread.h>
 
 #include <vdefs.h>
 #include <vcom.h>
@@ -33,10 +35,25 @@ using namespace std;
 namespace KC3D
 {
 
+// a file stream must be open; any other stream (for example a
+// std::ostringstream holding a geometry template) is always open
+static bool isOpen( std::ostream& aStream )
+{
+    std::ofstream* fp = dynamic_cast< std::ofstream* >( &aStream );
+
+    return !fp || fp->is_open();
+}
+
 // Create the VRML header and ancillary comments
 int SetupVRML( std::string aFilename, std::ofstream& aOutputStream )
 {
-    if( aFilename.empty() )
+    return SetupVRML( aFilename, aFilename, aOutputStream );
+}
+
+
+int SetupVRML( std::string aFilename, std::string aPath, std::ofstream& aOutputStream )
+{
+    if( aFilename.empty() || aPath.empty() )
     {
         ERRBLURB;
         cerr << "empty filename\n";
@@ -46,12 +63,12 @@ int SetupVRML( std::string aFilename, std::ofstream& aOutputStream )
     if( aOutputStream.is_open() )
         aOutputStream.close();
 
-    aOutputStream.open( aFilename.c_str() );
+    aOutputStream.open( aPath.c_str() );
 
     if( !aOutputStream.good() )
     {
         ERRBLURB;
-        cerr << "could not open file '" << aFilename << "'\n";
+        cerr << "could not open file '" << aPath << "'\n";
         return -1;
     }
 
@@ -64,7 +81,7 @@ int SetupVRML( std::string aFilename, std::ofstream& aOutputStream )
     if( !aOutputStream.good() )
     {
         ERRBLURB;
-        cerr << "error writing to file '" << aFilename << "'\n";
+        cerr << "error writing to file '" << aPath << "'\n";
         aOutputStream.close();
         return -1;
     }
@@ -162,7 +179,7 @@ int CloseXForm( std::ofstream& aVRMLFile, int aTabDepth)
 
 // Set up a VRML Shape block (includes appearance and geometry)
 int SetupShape( VRMLMAT& aMaterial, bool reuseMaterial,
-        std::ofstream& aVRMLFile, int aTabDepth )
+        std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !aVRMLFile.good() )
     {
@@ -171,7 +188,7 @@ int SetupShape( VRMLMAT& aMaterial, bool reuseMaterial,
         return -1;
     }
 
-    if( !aVRMLFile.is_open() )
+    if( !isOpen( aVRMLFile ) )
     {
         ERRBLURB;
         cerr << "no open file\n";
@@ -228,7 +245,7 @@ int SetupShape( VRMLMAT& aMaterial, bool reuseMaterial,
 
 
 // Close a VRML Shape and Geometry block
-int CloseShape( std::ofstream& aVRMLFile, int aTabDepth )
+int CloseShape( std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !aVRMLFile.good() )
     {
@@ -237,7 +254,7 @@ int CloseShape( std::ofstream& aVRMLFile, int aTabDepth )
         return -1;
     }
 
-    if( !aVRMLFile.is_open() )
+    if( !isOpen( aVRMLFile ) )
     {
         ERRBLURB;
         cerr << "no open file\n";
@@ -268,7 +285,7 @@ int CloseShape( std::ofstream& aVRMLFile, int aTabDepth )
 
 // Write a VRML coordinate block
 int WriteCoord( double* x, double* y, double* z, int nPoints,
-                std::ofstream& aVRMLFile, int aTabDepth )
+                std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !aVRMLFile.good() )
     {
@@ -277,7 +294,7 @@ int WriteCoord( double* x, double* y, double* z, int nPoints,
         return -1;
     }
 
-    if( !aVRMLFile.is_open() )
+    if( !isOpen( aVRMLFile ) )
     {
         ERRBLURB;
         cerr << "no open file\n";
@@ -353,7 +370,7 @@ int WriteCoord( double* x, double* y, double* z, int nPoints,
 
 
 // Set up a VRML coordIndex block
-int SetupCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
+int SetupCoordIndex( std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !aVRMLFile.good() )
     {
@@ -362,7 +379,7 @@ int SetupCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
         return -1;
     }
 
-    if( !aVRMLFile.is_open() )
+    if( !isOpen( aVRMLFile ) )
     {
         ERRBLURB;
         cerr << "no open file\n";
@@ -391,7 +408,7 @@ int SetupCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
 
 
 // Close a VRML coordIndex block
-int CloseCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
+int CloseCoordIndex( std::ostream& aVRMLFile, int aTabDepth )
 {
     if( !aVRMLFile.good() )
     {
@@ -400,7 +417,7 @@ int CloseCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
         return -1;
     }
 
-    if( !aVRMLFile.is_open() )
+    if( !isOpen( aVRMLFile ) )
     {
         ERRBLURB;
         cerr << "no open file\n";
@@ -427,4 +444,28 @@ int CloseCoordIndex( std::ofstream& aVRMLFile, int aTabDepth )
     return 0;
 }
 
+
+// materials loaded via LoadMaterial(), keyed by file name
+static std::map< std::string, VRMLMAT > matCache;
+static pthread_mutex_t matCacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Load a material appearance file once per process
+int LoadMaterial( VRMLMAT& aMaterial, const std::string& aFilename )
+{
+    pthread_mutex_lock( &matCacheLock );
+
+    std::map< std::string, VRMLMAT >::iterator mp = matCache.find( aFilename );
+    int ret = 0;
+
+    if( mp != matCache.end() )
+        aMaterial = mp->second;
+    else if( aMaterial.Load( aFilename ) )
+        ret = -1;
+    else
+        matCache[aFilename] = aMaterial;
+
+    pthread_mutex_unlock( &matCacheLock );
+    return ret;
+}
+
 }    // namespace KC3D
@@ -0,0 +1,1476 @@
+/*
+ *      file: vrmlmesh.cpp
+ *
+ *      Copyright 2012-2014 Dr. Cirilo Bernardo (cjh.bernardo@gmail.com)
+ *
+ *      This program is free software: you can redistribute it and/or modify
+ *      it under the terms of the GNU General Public License as published by
+ *      the Free Software Foundation, either version 3 of the License, or
+ *      (at your option) any later version.
+ *
+ *      This program is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *      GNU General Public License for more details.
+ *
+ *      You should have received a copy of the GNU General Public License
+ *      along with this program.  If not, see <http://www.gnu.org/licenses/>
+ *
+ *
+ *      This class holds a set of VRML Shapes and reads them from VRML2.0
+ *      files. The file is read as a stream of tokens by a recursive descent
+ *      parser; the geometry of each Shape is kept in the coordinate system
+ *      of the enclosing node together with the list of enclosing Transform
+ *      nodes so that DEF/USE of grouping nodes can be resolved without
+ *      building a scene graph. The transforms are applied once the whole
+ *      file has been read.
+ *
+ */
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+
+#include <vdefs.h>
+#include <vcom.h>
+#include <transform.h>
+#include <vrmlmesh.h>
+
+
+using namespace std;
+using namespace KC3D;
+
+
+namespace
+{
+
+// splits a VRML file into tokens; commas are treated as whitespace
+class VRMLLEXER
+{
+private:
+    std::istream& in;
+    std::string next;
+    bool peeked;
+    int line;
+
+    bool read( std::string& aToken );
+
+public:
+    VRMLLEXER( std::istream& aStream, int aLine ) : in( aStream )
+    {
+        peeked = false;
+        line = aLine;
+    }
+
+    // retrieve the next token; false at the end of the file
+    bool Next( std::string& aToken );
+
+    // inspect the next token without consuming it
+    bool Peek( std::string& aToken );
+
+    int Line( void ) const
+    {
+        return line;
+    }
+};
+
+
+bool VRMLLEXER::read( std::string& aToken )
+{
+    aToken.clear();
+    int c;
+
+    while( ( c = in.get() ) != EOF )
+    {
+        if( c == '\n' )
+        {
+            ++line;
+            continue;
+        }
+
+        if( c == '#' )
+        {
+            while( ( c = in.get() ) != EOF && c != '\n' );
+
+            if( c == EOF )
+                return false;
+
+            ++line;
+            continue;
+        }
+
+        if( isspace( c ) || c == ',' )
+            continue;
+
+        break;
+    }
+
+    if( c == EOF )
+        return false;
+
+    aToken.push_back( (char) c );
+
+    if( c == '{' || c == '}' || c == '[' || c == ']' )
+        return true;
+
+    if( c == '"' )
+    {
+        while( ( c = in.get() ) != EOF )
+        {
+            aToken.push_back( (char) c );
+
+            if( c == '\\' )
+            {
+                if( ( c = in.get() ) == EOF )
+                    break;
+
+                aToken.push_back( (char) c );
+                continue;
+            }
+
+            if( c == '\n' )
+                ++line;
+
+            if( c == '"' )
+                break;
+        }
+
+        return true;
+    }
+
+    while( ( c = in.peek() ) != EOF )
+    {
+        if( isspace( c ) || c == ',' || c == '#' || c == '"'
+            || c == '{' || c == '}' || c == '[' || c == ']' )
+            break;
+
+        aToken.push_back( (char) in.get() );
+    }
+
+    return true;
+}
+
+
+bool VRMLLEXER::Next( std::string& aToken )
+{
+    if( peeked )
+    {
+        peeked = false;
+        aToken.swap( next );
+        return true;
+    }
+
+    return read( aToken );
+}
+
+
+bool VRMLLEXER::Peek( std::string& aToken )
+{
+    if( !peeked )
+    {
+        if( !read( next ) )
+            return false;
+
+        peeked = true;
+    }
+
+    aToken = next;
+    return true;
+}
+
+
+// a Transform node; points are mapped as P' = T * C * R * SR * S * -SR * -C * P
+struct NODEXFORM
+{
+    double translation[3];
+    double center[3];
+    double scale[3];
+    ROTATION rotation;
+    ROTATION scaleOrientation;
+    ROTATION scaleOrientationInv;
+
+    NODEXFORM()
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            translation[i] = 0.0;
+            center[i] = 0.0;
+            scale[i] = 1.0;
+        }
+    }
+};
+
+
+// the geometry of an IndexedFaceSet; facets are terminated by -1
+struct GEOMETRY
+{
+    std::vector<double> xyz;
+    std::vector<int> index;
+};
+
+
+// a Shape in the coordinate system of its innermost Transform; 'chain'
+// lists the enclosing Transforms from the outermost to the innermost
+struct LOCALSHAPE
+{
+    int material;       // index to PARSER::materials or -1 for the default
+    int geometry;       // index to PARSER::geometry
+    std::vector<int> chain;
+};
+
+
+// a DEF'd Shape or grouping node: the shapes [first, last) which it
+// produced and the length of the Transform chain which encloses it
+struct NODEDEF
+{
+    size_t first;
+    size_t last;
+    size_t depth;
+};
+
+
+struct PARSER
+{
+    VRMLLEXER* lex;
+    std::string file;
+    std::vector<NODEXFORM> xforms;
+    std::vector<VRMLMAT> materials;
+    std::vector< std::vector<double> > coords;
+    std::vector<GEOMETRY> geometry;
+    std::vector<LOCALSHAPE> shapes;
+    std::map< std::string, int > matDefs;       // DEF'd Material and Appearance nodes
+    std::map< std::string, int > coordDefs;     // DEF'd Coordinate nodes
+    std::map< std::string, int > geomDefs;      // DEF'd IndexedFaceSet nodes
+    std::map< std::string, NODEDEF > nodeDefs;  // DEF'd Shape and grouping nodes
+    std::vector<int> chain;                     // the current Transform chain
+};
+
+
+int parseNode( PARSER& p, const std::string& aToken );
+
+
+void parseError( PARSER& p, const std::string& aMessage )
+{
+    ERRBLURB;
+    cerr << p.file << ":" << p.lex->Line() << ": " << aMessage << "\n";
+}
+
+
+// retrieve the next token; an end of file is an error
+int nextToken( PARSER& p, std::string& aToken )
+{
+    if( p.lex->Next( aToken ) )
+        return 0;
+
+    parseError( p, "unexpected end of file" );
+    return -1;
+}
+
+
+int expect( PARSER& p, const char* aToken )
+{
+    std::string tok;
+
+    if( nextToken( p, tok ) )
+        return -1;
+
+    if( tok.compare( aToken ) )
+    {
+        parseError( p, std::string( "expected '" ) + aToken + "' but found '" + tok + "'" );
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int readNumber( PARSER& p, double& aValue )
+{
+    std::string tok;
+
+    if( nextToken( p, tok ) )
+        return -1;
+
+    char* ep;
+    aValue = strtod( tok.c_str(), &ep );
+
+    if( ep == tok.c_str() || *ep )
+    {
+        parseError( p, "invalid number '" + tok + "'" );
+        return -1;
+    }
+
+    return 0;
+}
+
+
+int readNumbers( PARSER& p, double* aValues, int aCount )
+{
+    for( int i = 0; i < aCount; ++i )
+    {
+        if( readNumber( p, aValues[i] ) )
+            return -1;
+    }
+
+    return 0;
+}
+
+
+int readBool( PARSER& p, bool& aValue )
+{
+    std::string tok;
+
+    if( nextToken( p, tok ) )
+        return -1;
+
+    if( !tok.compare( "TRUE" ) )
+        aValue = true;
+    else if( !tok.compare( "FALSE" ) )
+        aValue = false;
+    else
+    {
+        parseError( p, "invalid boolean '" + tok + "'" );
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// read a rotation (axis X, Y, Z and angle) into 'aRotation' and
+// the reverse rotation into 'aReverse' (if not NULL)
+int readRotation( PARSER& p, ROTATION& aRotation, ROTATION* aReverse )
+{
+    double v[4];
+
+    if( readNumbers( p, v, 4 ) )
+        return -1;
+
+    // ROTATION expects an angle in the range -pi .. pi
+    double angle = fmod( v[3], 2.0 * M_PI );
+
+    if( angle > M_PI )
+        angle -= 2.0 * M_PI;
+    else if( angle < -M_PI )
+        angle += 2.0 * M_PI;
+
+    aRotation.Set( angle, v[0], v[1], v[2] );
+
+    if( aReverse )
+        aReverse->Set( -angle, v[0], v[1], v[2] );
+
+    return 0;
+}
+
+
+// skip a block; the opening bracket has already been read
+int skipBlock( PARSER& p )
+{
+    std::string tok;
+    int depth = 1;
+
+    while( depth > 0 )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "{" ) || !tok.compare( "[" ) )
+            ++depth;
+        else if( !tok.compare( "}" ) || !tok.compare( "]" ) )
+            --depth;
+    }
+
+    return 0;
+}
+
+
+// skip the value of an unsupported field
+int skipValue( PARSER& p )
+{
+    std::string tok;
+
+    if( !p.lex->Peek( tok ) )
+        return nextToken( p, tok );
+
+    if( !tok.compare( "[" ) )
+    {
+        p.lex->Next( tok );
+        return skipBlock( p );
+    }
+
+    if( !tok.compare( "TRUE" ) || !tok.compare( "FALSE" ) || !tok.compare( "NULL" ) )
+    {
+        p.lex->Next( tok );
+        return 0;
+    }
+
+    if( !tok.compare( "DEF" ) || !tok.compare( "USE" ) || isupper( tok[0] ) )
+    {
+        p.lex->Next( tok );
+        return parseNode( p, tok );
+    }
+
+    // scalar values: numbers, strings or an enumeration
+    if( !isdigit( tok[0] ) && tok[0] != '-' && tok[0] != '+' && tok[0] != '.' )
+    {
+        p.lex->Next( tok );
+        return 0;
+    }
+
+    while( p.lex->Peek( tok ) && ( isdigit( tok[0] ) || tok[0] == '-'
+           || tok[0] == '+' || tok[0] == '.' ) )
+        p.lex->Next( tok );
+
+    return 0;
+}
+
+
+// read the node type following an optional DEF name; on return 'aType'
+// is empty for a USE, in which case 'aName' is the name being used
+int nodeHeader( PARSER& p, const std::string& aToken, std::string& aType, std::string& aName )
+{
+    aName.clear();
+    aType.clear();
+
+    if( !aToken.compare( "USE" ) )
+        return nextToken( p, aName );
+
+    if( aToken.compare( "DEF" ) )
+    {
+        aType = aToken;
+        return 0;
+    }
+
+    if( nextToken( p, aName ) || nextToken( p, aType ) )
+        return -1;
+
+    return 0;
+}
+
+
+// set the VRML97 default material parameters
+void defaultMaterial( VRMLMAT& aMaterial )
+{
+    float rgb[3] = { 0.8f, 0.8f, 0.8f };
+
+    aMaterial.SetDiffuse( rgb );
+    rgb[0] = rgb[1] = rgb[2] = 0.0f;
+    aMaterial.SetEmissivity( rgb );
+    aMaterial.SetSpecular( rgb );
+    aMaterial.SetAmbientIntensity( 0.2f );
+    aMaterial.SetShininess( 0.2f );
+    aMaterial.SetTransparency( 0.0f );
+}
+
+
+int parseMaterial( PARSER& p, VRMLMAT& aMaterial )
+{
+    std::string tok;
+    float rgb[3];
+    double v[3];
+    int acc = 0;
+
+    defaultMaterial( aMaterial );
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( !tok.compare( "diffuseColor" ) || !tok.compare( "emissiveColor" )
+            || !tok.compare( "specularColor" ) )
+        {
+            if( readNumbers( p, v, 3 ) )
+                return -1;
+
+            rgb[0] = (float) v[0];
+            rgb[1] = (float) v[1];
+            rgb[2] = (float) v[2];
+
+            if( tok[0] == 'd' )
+                acc = aMaterial.SetDiffuse( rgb );
+            else if( tok[0] == 'e' )
+                acc = aMaterial.SetEmissivity( rgb );
+            else
+                acc = aMaterial.SetSpecular( rgb );
+        }
+        else if( !tok.compare( "ambientIntensity" ) || !tok.compare( "shininess" )
+                 || !tok.compare( "transparency" ) )
+        {
+            if( readNumber( p, v[0] ) )
+                return -1;
+
+            if( tok[0] == 'a' )
+                acc = aMaterial.SetAmbientIntensity( (float) v[0] );
+            else if( tok[0] == 's' )
+                acc = aMaterial.SetShininess( (float) v[0] );
+            else
+                acc = aMaterial.SetTransparency( (float) v[0] );
+        }
+        else if( skipValue( p ) )
+        {
+            return -1;
+        }
+
+        if( acc )
+        {
+            parseError( p, "invalid value for '" + tok + "'" );
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+// read the value of a 'material' or 'appearance' field; 'aMaterial'
+// is set to the index of the material or -1 if there is none
+int parseAppearance( PARSER& p, int& aMaterial )
+{
+    std::string tok, type, name;
+
+    aMaterial = -1;
+
+    if( nextToken( p, tok ) || nodeHeader( p, tok, type, name ) )
+        return -1;
+
+    if( type.empty() )
+    {
+        std::map< std::string, int >::iterator mi = p.matDefs.find( name );
+
+        if( mi == p.matDefs.end() )
+        {
+            parseError( p, "undefined material '" + name + "'" );
+            return -1;
+        }
+
+        aMaterial = mi->second;
+        return 0;
+    }
+
+    if( !type.compare( "NULL" ) )
+        return 0;
+
+    if( !type.compare( "Material" ) )
+    {
+        p.materials.push_back( VRMLMAT() );
+        aMaterial = p.materials.size() - 1;
+
+        if( parseMaterial( p, p.materials.back() ) )
+            return -1;
+
+        if( !name.empty() )
+        {
+            p.materials.back().SetName( name );
+            p.matDefs[name] = aMaterial;
+        }
+
+        return 0;
+    }
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    if( type.compare( "Appearance" ) )
+        return skipBlock( p );
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( !tok.compare( "material" ) )
+        {
+            if( parseAppearance( p, aMaterial ) )
+                return -1;
+        }
+        else if( skipValue( p ) )
+        {
+            return -1;
+        }
+    }
+
+    if( !name.empty() && aMaterial >= 0 )
+        p.matDefs[name] = aMaterial;
+
+    return 0;
+}
+
+
+// read the value of a 'coord' field
+int parseCoordinate( PARSER& p, int& aCoord )
+{
+    std::string tok, type, name;
+
+    aCoord = -1;
+
+    if( nextToken( p, tok ) || nodeHeader( p, tok, type, name ) )
+        return -1;
+
+    if( type.empty() )
+    {
+        std::map< std::string, int >::iterator mi = p.coordDefs.find( name );
+
+        if( mi == p.coordDefs.end() )
+        {
+            parseError( p, "undefined Coordinate '" + name + "'" );
+            return -1;
+        }
+
+        aCoord = mi->second;
+        return 0;
+    }
+
+    if( !type.compare( "NULL" ) )
+        return 0;
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    if( type.compare( "Coordinate" ) )
+    {
+        parseError( p, "unsupported coordinate node '" + type + "'" );
+        return -1;
+    }
+
+    p.coords.push_back( std::vector<double>() );
+    aCoord = p.coords.size() - 1;
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( tok.compare( "point" ) )
+        {
+            if( skipValue( p ) )
+                return -1;
+
+            continue;
+        }
+
+        std::vector<double>& pts = p.coords.back();
+        double v[3];
+
+        pts.clear();
+
+        if( !p.lex->Peek( tok ) )
+            return nextToken( p, tok );
+
+        if( tok.compare( "[" ) )
+        {
+            if( readNumbers( p, v, 3 ) )
+                return -1;
+
+            pts.insert( pts.end(), v, v + 3 );
+            continue;
+        }
+
+        p.lex->Next( tok );
+
+        while( p.lex->Peek( tok ) && tok.compare( "]" ) )
+        {
+            if( readNumbers( p, v, 3 ) )
+                return -1;
+
+            pts.insert( pts.end(), v, v + 3 );
+        }
+
+        if( expect( p, "]" ) )
+            return -1;
+    }
+
+    if( !name.empty() )
+        p.coordDefs[name] = aCoord;
+
+    return 0;
+}
+
+
+int parseIndices( PARSER& p, std::vector<int>& aIndex )
+{
+    std::string tok;
+    double v;
+
+    aIndex.clear();
+
+    if( !p.lex->Peek( tok ) )
+        return nextToken( p, tok );
+
+    if( tok.compare( "[" ) )
+    {
+        if( readNumber( p, v ) )
+            return -1;
+
+        aIndex.push_back( (int) v );
+        return 0;
+    }
+
+    p.lex->Next( tok );
+
+    while( p.lex->Peek( tok ) && tok.compare( "]" ) )
+    {
+        if( readNumber( p, v ) )
+            return -1;
+
+        aIndex.push_back( (int) v );
+    }
+
+    return expect( p, "]" );
+}
+
+
+int parseFaceSet( PARSER& p, GEOMETRY& aGeometry )
+{
+    std::string tok;
+    std::vector<int> index;
+    bool ccw = true;
+    int coord = -1;
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( !tok.compare( "coord" ) )
+        {
+            if( parseCoordinate( p, coord ) )
+                return -1;
+        }
+        else if( !tok.compare( "coordIndex" ) )
+        {
+            if( parseIndices( p, index ) )
+                return -1;
+        }
+        else if( !tok.compare( "ccw" ) )
+        {
+            if( readBool( p, ccw ) )
+                return -1;
+        }
+        else if( skipValue( p ) )
+        {
+            return -1;
+        }
+    }
+
+    if( coord < 0 )
+        return 0;
+
+    aGeometry.xyz = p.coords[coord];
+
+    // drop degenerate facets and ensure a counterclockwise order
+    int np = aGeometry.xyz.size() / 3;
+    size_t i = 0;
+    size_t ni = index.size();
+
+    while( i < ni )
+    {
+        size_t j = i;
+
+        while( j < ni && index[j] >= 0 )
+        {
+            if( index[j] >= np )
+            {
+                parseError( p, "coordIndex out of range" );
+                return -1;
+            }
+
+            ++j;
+        }
+
+        if( j - i >= 3 )
+        {
+            if( ccw )
+                aGeometry.index.insert( aGeometry.index.end(), index.begin() + i,
+                                        index.begin() + j );
+            else
+                aGeometry.index.insert( aGeometry.index.end(), index.rbegin() + ( ni - j ),
+                                        index.rbegin() + ( ni - i ) );
+
+            aGeometry.index.push_back( -1 );
+        }
+
+        i = j + 1;
+    }
+
+    return 0;
+}
+
+
+// read the value of a 'geometry' field; 'aGeometry' is set to the
+// index of the geometry or -1 if it is not an IndexedFaceSet
+int parseGeometry( PARSER& p, int& aGeometry )
+{
+    std::string tok, type, name;
+
+    aGeometry = -1;
+
+    if( nextToken( p, tok ) || nodeHeader( p, tok, type, name ) )
+        return -1;
+
+    if( type.empty() )
+    {
+        std::map< std::string, int >::iterator mi = p.geomDefs.find( name );
+
+        if( mi != p.geomDefs.end() )
+            aGeometry = mi->second;
+
+        return 0;
+    }
+
+    if( !type.compare( "NULL" ) )
+        return 0;
+
+    if( type.compare( "IndexedFaceSet" ) )
+    {
+        if( expect( p, "{" ) )
+            return -1;
+
+        return skipBlock( p );
+    }
+
+    p.geometry.push_back( GEOMETRY() );
+    aGeometry = p.geometry.size() - 1;
+
+    if( parseFaceSet( p, p.geometry.back() ) )
+        return -1;
+
+    if( !name.empty() )
+        p.geomDefs[name] = aGeometry;
+
+    return 0;
+}
+
+
+int parseShape( PARSER& p )
+{
+    std::string tok;
+    int material = -1;
+    int geometry = -1;
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( !tok.compare( "appearance" ) )
+        {
+            if( parseAppearance( p, material ) )
+                return -1;
+        }
+        else if( !tok.compare( "geometry" ) )
+        {
+            if( parseGeometry( p, geometry ) )
+                return -1;
+        }
+        else if( skipValue( p ) )
+        {
+            return -1;
+        }
+    }
+
+    if( geometry < 0 || p.geometry[geometry].index.empty() )
+        return 0;
+
+    p.shapes.push_back( LOCALSHAPE() );
+    p.shapes.back().material = material;
+    p.shapes.back().geometry = geometry;
+    p.shapes.back().chain = p.chain;
+
+    return 0;
+}
+
+
+// read the value of a 'children' field
+int parseChildren( PARSER& p )
+{
+    std::string tok;
+
+    if( nextToken( p, tok ) )
+        return -1;
+
+    if( tok.compare( "[" ) )
+        return parseNode( p, tok );
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "]" ) )
+            break;
+
+        if( parseNode( p, tok ) )
+            return -1;
+    }
+
+    return 0;
+}
+
+
+// parse a Transform or other grouping node
+int parseGroup( PARSER& p, bool isTransform )
+{
+    std::string tok;
+    int xform = -1;
+
+    if( expect( p, "{" ) )
+        return -1;
+
+    // the Transform is entered in the chain before its fields are read
+    // since 'children' may precede the transform parameters
+    if( isTransform )
+    {
+        p.xforms.push_back( NODEXFORM() );
+        xform = p.xforms.size() - 1;
+        p.chain.push_back( xform );
+    }
+
+    while( true )
+    {
+        if( nextToken( p, tok ) )
+            return -1;
+
+        if( !tok.compare( "}" ) )
+            break;
+
+        if( !tok.compare( "children" ) )
+        {
+            if( parseChildren( p ) )
+                return -1;
+
+            continue;
+        }
+
+        if( isTransform )
+        {
+            NODEXFORM& nx = p.xforms[xform];
+            int acc = 0;
+
+            if( !tok.compare( "translation" ) )
+                acc = readNumbers( p, nx.translation, 3 );
+            else if( !tok.compare( "center" ) )
+                acc = readNumbers( p, nx.center, 3 );
+            else if( !tok.compare( "scale" ) )
+                acc = readNumbers( p, nx.scale, 3 );
+            else if( !tok.compare( "rotation" ) )
+                acc = readRotation( p, nx.rotation, NULL );
+            else if( !tok.compare( "scaleOrientation" ) )
+                acc = readRotation( p, nx.scaleOrientation, &nx.scaleOrientationInv );
+            else
+                acc = skipValue( p );
+
+            if( acc )
+                return -1;
+
+            continue;
+        }
+
+        if( skipValue( p ) )
+            return -1;
+    }
+
+    if( isTransform )
+        p.chain.pop_back();
+
+    return 0;
+}
+
+
+// instantiate a previously DEF'd Shape or grouping node
+int useNode( PARSER& p, const std::string& aName )
+{
+    std::map< std::string, NODEDEF >::iterator ni = p.nodeDefs.find( aName );
+
+    if( ni == p.nodeDefs.end() )
+    {
+        // USE of a node which is not a Shape or group, or which was skipped
+        if( p.matDefs.count( aName ) || p.coordDefs.count( aName )
+            || p.geomDefs.count( aName ) )
+            return 0;
+
+        parseError( p, "undefined node '" + aName + "'" );
+        return -1;
+    }
+
+    NODEDEF nd = ni->second;
+
+    for( size_t i = nd.first; i < nd.last; ++i )
+    {
+        LOCALSHAPE sp = p.shapes[i];
+        std::vector<int> chain = p.chain;
+
+        chain.insert( chain.end(), sp.chain.begin() + nd.depth, sp.chain.end() );
+        sp.chain.swap( chain );
+        p.shapes.push_back( sp );
+    }
+
+    return 0;
+}
+
+
+// parse a child node; 'aToken' is the first token of the node
+int parseNode( PARSER& p, const std::string& aToken )
+{
+    std::string type, name;
+
+    if( nodeHeader( p, aToken, type, name ) )
+        return -1;
+
+    if( type.empty() )
+        return useNode( p, name );
+
+    if( !type.compare( "NULL" ) )
+        return 0;
+
+    NODEDEF nd;
+    nd.first = p.shapes.size();
+    nd.depth = p.chain.size();
+
+    int acc;
+
+    if( !type.compare( "Transform" ) )
+        acc = parseGroup( p, true );
+    else if( !type.compare( "Group" ) || !type.compare( "Anchor" )
+             || !type.compare( "Billboard" ) || !type.compare( "Collision" ) )
+        acc = parseGroup( p, false );
+    else if( !type.compare( "Shape" ) )
+        acc = parseShape( p );
+    else if( !type.compare( "Material" ) || !type.compare( "Appearance" )
+             || !type.compare( "Coordinate" ) || !type.compare( "IndexedFaceSet" ) )
+    {
+        parseError( p, "unexpected node '" + type + "'" );
+        acc = -1;
+    }
+    else
+    {
+        acc = expect( p, "{" );
+
+        if( !acc )
+            acc = skipBlock( p );
+    }
+
+    if( acc )
+        return -1;
+
+    if( !name.empty() )
+    {
+        nd.last = p.shapes.size();
+        p.nodeDefs[name] = nd;
+    }
+
+    return 0;
+}
+
+
+int parseScene( PARSER& p )
+{
+    std::string tok;
+
+    while( p.lex->Next( tok ) )
+    {
+        if( !tok.compare( "ROUTE" ) )
+        {
+            // ROUTE node.field TO node.field
+            if( nextToken( p, tok ) || nextToken( p, tok ) || nextToken( p, tok ) )
+                return -1;
+
+            continue;
+        }
+
+        if( !tok.compare( "PROTO" ) || !tok.compare( "EXTERNPROTO" ) )
+        {
+            bool isExtern = tok[0] == 'E';
+
+            if( nextToken( p, tok ) || expect( p, "[" ) || skipBlock( p ) )
+                return -1;
+
+            if( !isExtern )
+            {
+                if( expect( p, "{" ) || skipBlock( p ) )
+                    return -1;
+            }
+            else if( skipValue( p ) )
+            {
+                return -1;
+            }
+
+            continue;
+        }
+
+        if( parseNode( p, tok ) )
+            return -1;
+    }
+
+    return 0;
+}
+
+
+// apply a Transform node to a point
+void applyXForm( NODEXFORM& aXForm, double& x, double& y, double& z )
+{
+    x -= aXForm.center[0];
+    y -= aXForm.center[1];
+    z -= aXForm.center[2];
+    aXForm.scaleOrientationInv.Rotate( x, y, z );
+    x *= aXForm.scale[0];
+    y *= aXForm.scale[1];
+    z *= aXForm.scale[2];
+    aXForm.scaleOrientation.Rotate( x, y, z );
+    aXForm.rotation.Rotate( x, y, z );
+    x += aXForm.center[0] + aXForm.translation[0];
+    y += aXForm.center[1] + aXForm.translation[1];
+    z += aXForm.center[2] + aXForm.translation[2];
+}
+
+
+// compare the appearance parameters of two materials
+bool sameAppearance( VRMLMAT& aMat1, VRMLMAT& aMat2 )
+{
+    float c1[3], c2[3];
+
+    aMat1.GetDiffuse( c1 );
+    aMat2.GetDiffuse( c2 );
+
+    if( c1[0] != c2[0] || c1[1] != c2[1] || c1[2] != c2[2] )
+        return false;
+
+    aMat1.GetEmissivity( c1 );
+    aMat2.GetEmissivity( c2 );
+
+    if( c1[0] != c2[0] || c1[1] != c2[1] || c1[2] != c2[2] )
+        return false;
+
+    aMat1.GetSpecular( c1 );
+    aMat2.GetSpecular( c2 );
+
+    if( c1[0] != c2[0] || c1[1] != c2[1] || c1[2] != c2[2] )
+        return false;
+
+    return aMat1.GetAmbientIntensity() == aMat2.GetAmbientIntensity()
+           && aMat1.GetShininess() == aMat2.GetShininess()
+           && aMat1.GetTransparency() == aMat2.GetTransparency();
+}
+
+}    // anonymous namespace
+
+
+VRMLMESH::VRMLMESH()
+{
+    return;
+}
+
+
+VRMLMESH::~VRMLMESH()
+{
+    Clear();
+}
+
+
+int VRMLMESH::Read( const std::string& aFileName )
+{
+    ifstream file( aFileName.c_str() );
+
+    if( !file.is_open() )
+    {
+        ERRBLURB;
+        cerr << "could not open file '" << aFileName << "'\n";
+        return -1;
+    }
+
+    std::string line;
+    std::getline( file, line );
+
+    if( line.compare( 0, 10, "#VRML V2.0" ) )
+    {
+        ERRBLURB;
+        cerr << "not a VRML2.0 file: '" << aFileName << "'\n";
+        return -1;
+    }
+
+    VRMLLEXER lex( file, 2 );
+    PARSER p;
+    p.lex = &lex;
+    p.file = aFileName;
+
+    if( parseScene( p ) )
+        return -1;
+
+    // apply the transforms and copy out the shapes
+    VRMLMAT defmat;
+    defaultMaterial( defmat );
+
+    for( size_t i = 0; i < p.shapes.size(); ++i )
+    {
+        LOCALSHAPE& lp = p.shapes[i];
+        GEOMETRY& gp = p.geometry[lp.geometry];
+        VRMLSHAPE* sp = new (nothrow) VRMLSHAPE;
+
+        if( !sp )
+        {
+            ERRBLURB;
+            cerr << "could not allocate memory for a shape\n";
+
+            while( i-- > 0 )
+            {
+                delete shapes.back();
+                shapes.pop_back();
+            }
+
+            return -1;
+        }
+
+        sp->material = lp.material < 0 ? defmat : p.materials[lp.material];
+
+        size_t np = gp.xyz.size() / 3;
+        sp->x.resize( np );
+        sp->y.resize( np );
+        sp->z.resize( np );
+
+        for( size_t j = 0; j < np; ++j )
+        {
+            double x = gp.xyz[3 * j];
+            double y = gp.xyz[3 * j + 1];
+            double z = gp.xyz[3 * j + 2];
+
+            for( size_t k = lp.chain.size(); k > 0; --k )
+                applyXForm( p.xforms[lp.chain[k - 1]], x, y, z );
+
+            sp->x[j] = x;
+            sp->y[j] = y;
+            sp->z[j] = z;
+        }
+
+        sp->index = gp.index;
+        shapes.push_back( sp );
+    }
+
+    return 0;
+}
+
+
+void VRMLMESH::Append( const VRMLMESH& aMesh )
+{
+    std::vector<VRMLSHAPE*>::const_iterator sp = aMesh.shapes.begin();
+    std::vector<VRMLSHAPE*>::const_iterator ep = aMesh.shapes.end();
+
+    while( sp != ep )
+    {
+        VRMLSHAPE* np = new (nothrow) VRMLSHAPE( **sp );
+
+        if( !np )
+        {
+            ERRBLURB;
+            cerr << "could not allocate memory for a shape\n";
+            return;
+        }
+
+        shapes.push_back( np );
+        ++sp;
+    }
+}
+
+
+void VRMLMESH::Transform( TRANSFORM& aTransform, int aFirstShape )
+{
+    if( aFirstShape < 0 )
+        aFirstShape = 0;
+
+    for( size_t i = aFirstShape; i < shapes.size(); ++i )
+    {
+        VRMLSHAPE* sp = shapes[i];
+        size_t np = sp->x.size();
+
+        for( size_t j = 0; j < np; ++j )
+            aTransform.Transform( sp->x[j], sp->y[j], sp->z[j] );
+    }
+}
+
+
+void VRMLMESH::Coalesce( void )
+{
+    std::vector<VRMLSHAPE*> merged;
+
+    for( size_t i = 0; i < shapes.size(); ++i )
+    {
+        VRMLSHAPE* sp = shapes[i];
+        VRMLSHAPE* dp = NULL;
+
+        for( size_t j = 0; j < merged.size(); ++j )
+        {
+            if( !merged[j]->material.GetName().compare( sp->material.GetName() )
+                && sameAppearance( merged[j]->material, sp->material ) )
+            {
+                dp = merged[j];
+                break;
+            }
+        }
+
+        if( !dp )
+        {
+            merged.push_back( sp );
+            continue;
+        }
+
+        int offset = dp->x.size();
+        dp->x.insert( dp->x.end(), sp->x.begin(), sp->x.end() );
+        dp->y.insert( dp->y.end(), sp->y.begin(), sp->y.end() );
+        dp->z.insert( dp->z.end(), sp->z.begin(), sp->z.end() );
+        dp->index.reserve( dp->index.size() + sp->index.size() );
+
+        for( size_t j = 0; j < sp->index.size(); ++j )
+            dp->index.push_back( sp->index[j] < 0 ? -1 : sp->index[j] + offset );
+
+        delete sp;
+    }
+
+    shapes.swap( merged );
+}
+
+
+int VRMLMESH::Write( std::ofstream& aVRMLFile, int aTabDepth )
+{
+    // materials written so far, with their names as written, and
+    // the names which the materials had in the mesh
+    std::vector<VRMLMAT> defs;
+    std::vector<std::string> names;
+    int nmat = 0;
+
+    if( aTabDepth < 0 )
+        aTabDepth = 0;
+
+    string fmt( ( aTabDepth + 1 ) * 4, ' ' );
+
+    for( size_t i = 0; i < shapes.size(); ++i )
+    {
+        VRMLSHAPE* sp = shapes[i];
+
+        if( sp->x.size() < 3 || sp->index.empty() )
+            continue;
+
+        const std::string& name = sp->material.GetName();
+        size_t j = 0;
+
+        while( j < defs.size() && ( names[j].compare( name )
+               || !sameAppearance( defs[j], sp->material ) ) )
+            ++j;
+
+        if( j == defs.size() )
+        {
+            std::string defname = name;
+
+            // ensure a unique name
+            while( true )
+            {
+                size_t k = 0;
+
+                while( k < defs.size() && defs[k].GetName().compare( defname ) )
+                    ++k;
+
+                if( !defname.empty() && k == defs.size() )
+                    break;
+
+                ostringstream ostr;
+                ostr << ( name.empty() ? "MAT" : name ) << "_" << nmat++;
+                defname = ostr.str();
+            }
+
+            defs.push_back( sp->material );
+            defs.back().SetName( defname );
+            names.push_back( name );
+
+            if( SetupShape( defs.back(), false, aVRMLFile, aTabDepth ) )
+                return -1;
+        }
+        else if( SetupShape( defs[j], true, aVRMLFile, aTabDepth ) )
+        {
+            return -1;
+        }
+
+        if( WriteCoord( &sp->x[0], &sp->y[0], &sp->z[0], sp->x.size(),
+                        aVRMLFile, aTabDepth + 1 ) )
+            return -1;
+
+        if( SetupCoordIndex( aVRMLFile, aTabDepth + 1 ) )
+            return -1;
+
+        // 8 facets per line
+        int nf = 0;
+        size_t ni = sp->index.size();
+
+        aVRMLFile << fmt << "   ";
+
+        for( j = 0; j < ni; ++j )
+        {
+            aVRMLFile << sp->index[j];
+
+            if( j + 1 == ni )
+                break;
+
+            if( sp->index[j] < 0 && !( ++nf & 7 ) )
+                aVRMLFile << ",\n" << fmt << "   ";
+            else
+                aVRMLFile << ",";
+        }
+
+        aVRMLFile << "\n";
+
+        if( CloseCoordIndex( aVRMLFile, aTabDepth + 1 ) || CloseShape( aVRMLFile, aTabDepth ) )
+            return -1;
+    }
+
+    return 0;
+}
+
+
+void VRMLMESH::Clear( void )
+{
+    for( size_t i = 0; i < shapes.size(); ++i )
+        delete shapes[i];
+
+    shapes.clear();
+}
+
+
+int VRMLMESH::GetNShapes( void ) const
+{
+    return shapes.size();
+}
+
+
+VRMLSHAPE* VRMLMESH::GetShape( int aIndex )
+{
+    if( aIndex < 0 || aIndex >= (int) shapes.size() )
+        return NULL;
+
+    return shapes[aIndex];
+}